@@ -14,11 +14,13 @@ struct _AlbumItem {
     gchar *artist;
     gchar *album;
     GdkPaintable *cover;
+    gboolean cover_loaded;             /* cover is the real art (or its final fallback) */
+    GCancellable *cover_cancellable;   /* Pending load while the item is bound */
     GtkWidget *picture;  /* Weak reference to bound picture widget */
 };
 
 AlbumItem* album_item_new(const gchar *artist, const gchar *album);
-void album_item_set_cover(AlbumItem *item, GdkPixbuf *pixbuf);
+void album_item_set_cover(AlbumItem *item, GdkTexture *texture);
 
 typedef struct {
     GtkWidget *scrolled_window;
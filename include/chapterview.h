@@ -14,7 +14,9 @@ typedef struct {
     GListStore *store;
     GtkSingleSelection *selection;
     
-    GList *chapters;
+    GPtrArray *chapters;   /* PodcastChapter, sorted by start_time, same order as store */
+    GArray *start_times;   /* gdouble per chapter, for timeline_index_at_time */
+    gint current_index;    /* Highlighted chapter, -1 if none */
     
     /* Callback for seeking */
     ChapterSeekCallback seek_callback;
@@ -3,6 +3,7 @@
 
 #include <gtk/gtk.h>
 #include <glib.h>
+#include "coverpack.h"
 
 /* Forward declaration */
 typedef struct Database Database;
@@ -12,55 +13,131 @@ typedef struct Database Database;
 #define COVER_ART_SIZE_MEDIUM 200
 #define COVER_ART_SIZE_LARGE 300
 
+/* Default memory budget for decoded covers */
+#define COVER_ART_CACHE_BUDGET (64 * 1024 * 1024)
+
+/* Shown while art loads or when there is none */
+#define COVER_ART_PLACEHOLDER_RGBA 0x333333FF
+
+/* Edge of the downsampled image an album's dominant colour is taken from */
+#define COVER_ART_COLOR_SAMPLE 16
+
+/* How long an album or URL without art is left alone before retrying */
+#define COVER_ART_MISSING_TTL (10 * 60 * G_USEC_PER_SEC)
+
 typedef struct {
     gchar *cache_dir;
-    GHashTable *cache;
+    GHashTable *cache;        /* Key -> GList link in cache_lru */
+    GQueue cache_lru;         /* Cache entries, most recently used first */
+    gsize cache_bytes;        /* Pixel memory held by cached entries */
+    gsize cache_budget;
+    GHashTable *cache_loading; /* Keys being decoded by some thread */
+    GCond cache_loaded;
+    guint64 cache_hits;
+    guint64 cache_misses;
+    guint64 cache_evictions;
+    GHashTable *placeholders; /* Size -> shared placeholder GdkTexture */
+    GHashTable *missing;      /* Album key or URL -> gint64 monotonic expiry */
     GMutex cache_mutex;
-    GThreadPool *fetch_pool;  /* Thread pool for async fetches */
+    CoverPack *pack;          /* Packed thumbnail store, NULL for one file per thumbnail */
+    GHashTable *thumbnail_sizes; /* Source file name -> GArray of gint sizes thumbnailed */
+    gboolean thumbnail_sizes_loaded;
+    GMutex thumbnail_mutex;
+    GThreadPool *fetch_pool;  /* Thread pool for async fetches, sorted by priority */
+    guint fetch_sequence;     /* Request counter; newer requests run first within a priority */
+    GThreadPool *url_pool;    /* Bounded pool for cover downloads */
+    GHashTable *url_pending;  /* "url@size" -> callbacks waiting on that download */
+    GMutex url_mutex;
 } CoverArtManager;
 
 /* Cover art manager */
 CoverArtManager* coverart_manager_new(void);
 void coverart_manager_free(CoverArtManager *manager);
 
-/* Cover art retrieval */
-GdkPixbuf* coverart_get(CoverArtManager *manager, const gchar *artist, const gchar *album, gint size);
+typedef struct {
+    guint64 hits;
+    guint64 misses;
+    guint64 evictions;
+    guint entries;
+    gsize bytes;
+    gsize budget;
+} CoverArtCacheStats;
+
+/* Shared, immutable placeholder for size; returns a new reference */
+GdkTexture* coverart_manager_get_placeholder(CoverArtManager *manager, gint size);
+
+/* Memory cache tuning. Shrinking the budget evicts immediately. */
+void coverart_manager_set_cache_budget(CoverArtManager *manager, gsize bytes);
+void coverart_manager_get_cache_stats(CoverArtManager *manager, CoverArtCacheStats *stats);
+
+/* Keep thumbnails in one memory-mapped pack file instead of a file each.
+ * Enable before the first lookup; existing thumbnail files move in as they
+ * are read. Compaction reclaims replaced thumbnails, and runs on enable
+ * once they make up half the file. */
+gboolean coverart_manager_enable_pack(CoverArtManager *manager);
+gboolean coverart_manager_compact_pack(CoverArtManager *manager, gboolean force);
+
+/* Cover art retrieval. Covers are kept on disk as premultiplied RGBA
+ * thumbnails per size and handed out as ready-to-upload textures. */
+GdkTexture* coverart_get(CoverArtManager *manager, const gchar *artist, const gchar *album, gint size);
 GdkPixbuf* coverart_get_from_file(const gchar *file_path, gint size);
 gchar* coverart_get_cache_path(CoverArtManager *manager, const gchar *artist, const gchar *album);
+GdkTexture* coverart_texture_new_solid(gint size, guint32 rgba);
 
 /* Cover art extraction */
 GdkPixbuf* coverart_extract_from_audio(const gchar *audio_file_path, gint size);
+GBytes* coverart_extract_data_from_audio(const gchar *audio_file_path);
 GdkPixbuf* coverart_search_directory(const gchar *audio_file_path, gint size);
 gboolean coverart_extract_and_cache(CoverArtManager *manager, const gchar *audio_file_path,
                                     const gchar *artist, const gchar *album);
 
+/* Dominant colour of an album's cached art as opaque RGBA, 0 if none */
+guint32 coverart_get_dominant_color(CoverArtManager *manager, const gchar *artist, const gchar *album);
+
+/* Cover resolution for an import run. Art is looked up once per album in
+ * each directory, albums without art are remembered, and each directory is
+ * listed once however many albums it holds. Albums with art get their
+ * dominant colour recorded in database, when one is given. */
+typedef struct CoverArtScan CoverArtScan;
+CoverArtScan* coverart_scan_new(CoverArtManager *manager, Database *database);
+void coverart_scan_free(CoverArtScan *scan);
+gboolean coverart_scan_resolve(CoverArtScan *scan, const gchar *audio_file_path,
+                               const gchar *artist, const gchar *album);
+
 /* Cover art storage */
-gboolean coverart_save(CoverArtManager *manager, const gchar *artist, const gchar *album, GdkPixbuf *pixbuf);
+/* Store encoded image data as-is, e.g. the bytes of an embedded picture */
+gboolean coverart_save_data(CoverArtManager *manager, const gchar *artist, const gchar *album, GBytes *data);
 gboolean coverart_exists(CoverArtManager *manager, const gchar *artist, const gchar *album);
 
 /* Cover art fetching (async) */
-typedef void (*CoverArtFetchCallback)(GdkPixbuf *pixbuf, gpointer user_data);
+typedef void (*CoverArtFetchCallback)(GdkTexture *texture, gpointer user_data);
 void coverart_fetch_async(CoverArtManager *manager, const gchar *artist, const gchar *album, 
                           gint size, CoverArtFetchCallback callback, gpointer user_data);
 void coverart_fetch_async_with_db(CoverArtManager *manager, Database *database,
                                   const gchar *artist, const gchar *album,
                                   gint size, CoverArtFetchCallback callback, gpointer user_data);
 
+/* Queued by priority (G_PRIORITY_*, lower runs first). A request cancelled
+ * before it runs is dropped; callback always runs, with NULL if cancelled. */
+void coverart_fetch_album_async(CoverArtManager *manager, Database *database,
+                                const gchar *artist, const gchar *album, gint size,
+                                gint priority, GCancellable *cancellable,
+                                CoverArtFetchCallback callback, gpointer user_data);
+
 /* Podcast/URL-based cover art */
-GdkPixbuf* coverart_get_from_url(CoverArtManager *manager, const gchar *url, gint size);
+GdkTexture* coverart_get_from_url(CoverArtManager *manager, const gchar *url, gint size);
 void coverart_fetch_from_url_async(CoverArtManager *manager, const gchar *url, 
                                    gint size, CoverArtFetchCallback callback, gpointer user_data);
 gchar* coverart_get_url_cache_path(CoverArtManager *manager, const gchar *url);
-gboolean coverart_cache_url_image(CoverArtManager *manager, const gchar *url, GdkPixbuf *pixbuf);
 
 /* Cover art display widget */
 GtkWidget* coverart_widget_new(gint size);
-void coverart_widget_set_image(GtkWidget *widget, GdkPixbuf *pixbuf);
+void coverart_widget_set_image(GtkWidget *widget, GdkTexture *texture);
 void coverart_widget_set_from_manager(GtkWidget *widget, CoverArtManager *manager, 
                                       const gchar *artist, const gchar *album, gint size);
-void coverart_widget_set_from_url(GtkWidget *widget, const gchar *url);
+void coverart_widget_set_from_url(GtkWidget *widget, CoverArtManager *manager, const gchar *url);
 gboolean coverart_widget_set_from_album(GtkWidget *widget, CoverArtManager *manager, 
                                         const gchar *artist, const gchar *album);
-void coverart_widget_set_default(GtkWidget *widget);
+void coverart_widget_set_default(GtkWidget *widget, CoverArtManager *manager);
 
 #endif /* COVERART_H */
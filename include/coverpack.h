@@ -0,0 +1,27 @@
+#ifndef COVERPACK_H
+#define COVERPACK_H
+
+#include <glib.h>
+
+/* Packed cover cache: one append-only file of keyed blobs, memory-mapped so
+ * lookups hand out slices of the mapping without copying. Storing a key
+ * again leaves the old blob behind as dead space until compaction. */
+typedef struct CoverPack CoverPack;
+
+CoverPack* coverpack_open(const gchar *path, GError **error);
+void coverpack_free(CoverPack *pack);
+
+/* Zero-copy slice of the mapping, or NULL if key isn't stored. The slice
+ * stays valid across later stores and compaction. */
+GBytes* coverpack_lookup(CoverPack *pack, const gchar *key);
+gboolean coverpack_store(CoverPack *pack, const gchar *key, GBytes *data);
+gboolean coverpack_remove(CoverPack *pack, const gchar *key);
+/* Stored keys starting with prefix */
+GPtrArray* coverpack_list_keys(CoverPack *pack, const gchar *prefix);
+
+/* Rewrite the file keeping only live blobs */
+gboolean coverpack_compact(CoverPack *pack, GError **error);
+gsize coverpack_get_size(CoverPack *pack);
+gsize coverpack_get_dead_bytes(CoverPack *pack);
+
+#endif /* COVERPACK_H */
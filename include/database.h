@@ -3,6 +3,7 @@
 
 #include <sqlite3.h>
 #include <glib.h>
+#include "transcript.h"
 
 /* Forward declarations - these will be fully defined in podcast.h */
 typedef struct PodcastEpisode PodcastEpisode;
@@ -32,17 +33,41 @@ typedef struct {
     gint track_count;
 } Playlist;
 
+typedef struct {
+    gchar *artist;
+    gchar *album;
+    guint32 color;  /* Dominant cover colour as RGBA, 0 until known */
+} AlbumInfo;
+
+/* An episode list row: its id and a digest of the columns the list shows,
+ * which changes when the row needs redrawing */
+typedef struct {
+    gint id;
+    guint state;
+} EpisodeRowKey;
+
 struct Database {
     sqlite3 *db;
     gchar *db_path;
+    GRecMutex lock;  /* Held for every use of db, and from BEGIN to COMMIT/ROLLBACK */
+    gboolean has_fts5;  /* SQLite has FTS5; searches fall back to LIKE scans otherwise */
 };
 
+/* Hold db's lock until the end of the enclosing scope. Feeds, downloads and
+ * cover art use the connection from worker threads, so anything touching
+ * db->db directly must take it. */
+#define DATABASE_LOCK_SCOPE(database) \
+    g_autoptr(GRecMutexLocker) G_PASTE(database_locker_, __LINE__) G_GNUC_UNUSED = \
+        g_rec_mutex_locker_new(&(database)->lock)
+
 /* Database initialization */
 Database* database_new(const gchar *db_path);
 void database_free(Database *db);
 gboolean database_init_tables(Database *db);
 
-/* Transaction helpers */
+/* Transaction helpers. Begin takes db's lock, even if BEGIN fails, and the
+ * matching commit or rollback releases it, so the transaction's statements
+ * can't interleave with another thread's. */
 gboolean database_begin_transaction(Database *db);
 gboolean database_commit_transaction(Database *db);
 gboolean database_rollback_transaction(Database *db);
@@ -56,6 +81,8 @@ gint database_get_audio_track_count(Database *db);
 GList* database_get_tracks_by_artist(Database *db, const gchar *artist);
 GList* database_get_tracks_by_album(Database *db, const gchar *artist, const gchar *album);
 GList* database_get_albums_by_artist(Database *db, const gchar *artist);
+gboolean database_set_album_color(Database *db, const gchar *artist, const gchar *album, guint32 color);
+guint32 database_get_album_color(Database *db, const gchar *artist, const gchar *album);
 gboolean database_update_track(Database *db, Track *track);
 gboolean database_delete_track(Database *db, gint track_id);
 GList* database_search_tracks(Database *db, const gchar *search_term);
@@ -95,10 +122,26 @@ GList* database_get_podcasts(Database *db);
 Podcast* database_get_podcast_by_id(Database *db, gint podcast_id);
 GList* database_get_podcast_episodes(Database *db, gint podcast_id);
 PodcastEpisode* database_get_episode_by_id(Database *db, gint episode_id);
+/* Every episode row of a podcast in list order, as EpisodeRowKey */
+GArray* database_get_podcast_episode_keys(Database *db, gint podcast_id);
+/* List columns only (id, title, published_date, duration, downloaded), newest first */
+GList* database_get_podcast_episode_page(Database *db, gint podcast_id, gint offset, gint limit);
 gboolean database_update_episode_progress(Database *db, gint episode_id, gint position, gboolean played);
 gboolean database_update_episode_downloaded(Database *db, gint episode_id, const gchar *local_path);
 gboolean database_delete_podcast(Database *db, gint podcast_id);
 gboolean database_clear_episode_download(Database *db, gint episode_id);
+gboolean database_clear_episode_downloads(Database *db, GList *episode_ids);  /* GINT_TO_POINTER ids */
+
+/* Auto-download and retention */
+gboolean database_set_podcast_download_settings(Database *db, gint podcast_id, gboolean auto_download,
+                                                gint keep_episodes, gint delete_played_after_days);
+GList* database_get_auto_download_episodes(Database *db);
+gboolean database_mark_episodes_auto_queued(Database *db, GList *episode_ids);
+GList* database_get_expired_episode_downloads(Database *db);
+
+/* Refresh scheduling */
+gboolean database_set_podcast_refresh(Database *db, gint podcast_id, gint64 last_fetched, gint64 next_refresh);
+GArray* database_get_episode_publish_dates(Database *db, gint podcast_id, gint limit);  /* gint64, newest first */
 
 /* Funding operations */
 gboolean database_save_episode_funding(Database *db, gint episode_id, GList *funding_list);
@@ -106,6 +149,35 @@ GList* database_get_episode_funding(Database *db, gint episode_id);
 gboolean database_save_podcast_funding(Database *db, gint podcast_id, GList *funding_list);
 GList* database_load_podcast_funding(Database *db, gint podcast_id);
 
+/* Search operations */
+typedef struct {
+    GList *podcast_ids;  /* GINT_TO_POINTER ids of podcasts matching directly or via an episode, best first */
+    GList *episodes;     /* PodcastEpisode, best first; only id, podcast_id, title, dates and download state are set */
+} PodcastSearchResults;
+
+PodcastSearchResults* database_search_podcasts(Database *db, const gchar *text, gint max_episodes);
+void database_search_results_free(PodcastSearchResults *results);
+
+/* Transcript search: a match in an episode's spoken text */
+typedef struct {
+    gint episode_id;
+    gint podcast_id;
+    gchar *episode_title;
+    gdouble start_time;  /* Seconds into the episode where the passage starts */
+    gchar *snippet;      /* Matching words with some context */
+    gboolean downloaded;
+} TranscriptHit;
+
+gboolean database_save_episode_transcript(Database *db, gint episode_id, Transcript *transcript);
+GList* database_get_unindexed_transcript_episodes(Database *db);  /* Downloaded; id, transcript url and type only */
+GList* database_search_transcripts(Database *db, const gchar *text, gint limit);  /* TranscriptHit, best first */
+void transcript_hit_free(TranscriptHit *hit);
+
+/* Embedded chapter operations (list of PodcastChapter) */
+gint64 database_get_episode_chapters_scanned(Database *db, gint episode_id);
+GList* database_get_episode_chapters(Database *db, gint episode_id);
+gboolean database_save_episode_chapters(Database *db, gint episode_id, GList *chapters, gint64 scanned_mtime);
+
 /* Value 4 Value operations */
 gboolean database_save_podcast_value(Database *db, gint podcast_id, GList *value_list);
 gboolean database_save_episode_value(Database *db, gint episode_id, GList *value_list);
@@ -117,6 +189,20 @@ gboolean database_save_podcast_live_items(Database *db, gint podcast_id, GList *
 GList* database_load_podcast_live_items(Database *db, gint podcast_id);
 gboolean database_has_active_live_item(Database *db, gint podcast_id);
 
+/* Download queue operations */
+typedef struct {
+    gint episode_id;
+    gint priority;
+    gint attempts;
+    gint64 next_attempt;  /* Unix time of the next retry, 0 for immediately */
+} DownloadQueueEntry;
+
+gboolean database_enqueue_download(Database *db, gint episode_id, gint priority);
+gboolean database_update_download_retry(Database *db, gint episode_id, gint attempts,
+                                        gint64 next_attempt, const gchar *last_error);
+gboolean database_remove_download(Database *db, gint episode_id);
+GList* database_get_download_queue(Database *db);  /* List of DownloadQueueEntry, free with g_free */
+
 /* Preference operations */
 gboolean database_set_preference(Database *db, const gchar *key, const gchar *value);
 gchar* database_get_preference(Database *db, const gchar *key, const gchar *default_value);
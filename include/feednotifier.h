@@ -0,0 +1,50 @@
+#ifndef FEEDNOTIFIER_H
+#define FEEDNOTIFIER_H
+
+#include <glib.h>
+#include <gio/gio.h>
+
+/* Feed change notifiers push the URLs of feeds that just changed (podping,
+ * WebSub relays, a local test file) so only those feeds get refreshed. */
+typedef struct _FeedNotifier FeedNotifier;
+
+/* Called on the main context of the thread that started the notifier */
+typedef void (*FeedChangedCallback)(const gchar *feed_url, gpointer user_data);
+
+/* Backend operations */
+typedef struct {
+    const gchar *name;
+    gboolean (*start)(FeedNotifier *notifier, GError **error);
+    void (*stop)(FeedNotifier *notifier);
+    void (*finalize)(FeedNotifier *notifier);
+} FeedNotifierClass;
+
+struct _FeedNotifier {
+    const FeedNotifierClass *klass;
+    gatomicrefcount ref_count;
+    FeedChangedCallback callback;
+    gpointer user_data;
+    GMainContext *context;   /* Where callback runs, set by feed_notifier_start */
+    volatile gint running;
+};
+
+/* Generic notifier API */
+gboolean feed_notifier_start(FeedNotifier *notifier, FeedChangedCallback callback,
+                             gpointer user_data, GError **error);
+void feed_notifier_stop(FeedNotifier *notifier);
+FeedNotifier* feed_notifier_ref(FeedNotifier *notifier);
+void feed_notifier_unref(FeedNotifier *notifier);
+const gchar* feed_notifier_get_name(FeedNotifier *notifier);
+
+/* For backends: allocate a notifier of size bytes, report a changed feed
+ * (any thread), or report one line of a stream (plain URL, podping JSON or
+ * a Server-Sent Events "data:" line) */
+FeedNotifier* feed_notifier_new(const FeedNotifierClass *klass, gsize size);
+void feed_notifier_emit(FeedNotifier *notifier, const gchar *feed_url);
+void feed_notifier_handle_line(FeedNotifier *notifier, const gchar *line);
+
+/* Backends */
+FeedNotifier* feed_notifier_stream_new(const gchar *url);  /* Long-lived HTTP stream, reconnects */
+FeedNotifier* feed_notifier_file_new(const gchar *path);   /* Lines appended to a local file */
+
+#endif /* FEEDNOTIFIER_H */
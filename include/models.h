@@ -3,6 +3,7 @@
 
 #include <glib-object.h>
 #include <gtk/gtk.h>
+#include "database.h"
 
 G_BEGIN_DECLS
 
@@ -83,14 +84,29 @@ const gchar* shriek_podcast_object_get_author(ShriekPodcastObject *self);
 G_DECLARE_FINAL_TYPE(ShriekEpisodeObject, shriek_episode_object, SHRIEK, EPISODE_OBJECT, GObject)
 
 ShriekEpisodeObject* shriek_episode_object_new(gint id, const gchar *title, 
-                                                  const gchar *date, const gchar *duration,
+                                                  gint64 published_date, gint duration,
                                                   gboolean downloaded);
 
 gint shriek_episode_object_get_id(ShriekEpisodeObject *self);
 const gchar* shriek_episode_object_get_title(ShriekEpisodeObject *self);
-const gchar* shriek_episode_object_get_date(ShriekEpisodeObject *self);
-const gchar* shriek_episode_object_get_duration(ShriekEpisodeObject *self);
+gint64 shriek_episode_object_get_published_date(ShriekEpisodeObject *self);
+gint shriek_episode_object_get_duration(ShriekEpisodeObject *self);  /* Seconds */
 gboolean shriek_episode_object_get_downloaded(ShriekEpisodeObject *self);
+gdouble shriek_episode_object_get_start_time(ShriekEpisodeObject *self);  /* Seconds, 0 = beginning */
+void shriek_episode_object_set_start_time(ShriekEpisodeObject *self, gdouble start_time);
+
+/* ============================================================================
+ * ShriekEpisodeListModel - lazily paged GListModel of ShriekEpisodeObject
+ * for one podcast, newest first
+ * ============================================================================ */
+
+#define SHRIEK_TYPE_EPISODE_LIST_MODEL (shriek_episode_list_model_get_type())
+G_DECLARE_FINAL_TYPE(ShriekEpisodeListModel, shriek_episode_list_model, SHRIEK, EPISODE_LIST_MODEL, GObject)
+
+ShriekEpisodeListModel* shriek_episode_list_model_new(Database *database);
+/* Also reloads; calling it again for the same podcast reports only the rows that changed */
+void shriek_episode_list_model_set_podcast(ShriekEpisodeListModel *self, gint podcast_id);
+gint shriek_episode_list_model_get_podcast(ShriekEpisodeListModel *self);
 
 /* ============================================================================
  * ShriekVideoObject - GObject wrapper for video list items
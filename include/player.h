@@ -27,6 +27,7 @@ typedef struct {
     gdouble volume;
     gint64 duration;
     gint64 position;
+    gint64 pending_seek;  /* Applied once the pipeline reaches PAUSED, -1 if none */
     PositionCallbackData *position_cb_data;
     EosCallbackData *eos_cb_data;
     guint ui_position_timer_id;  /* Timer for UI position updates */
@@ -4,6 +4,7 @@
 #include <glib.h>
 #include <gtk/gtk.h>
 #include "database.h"  /* For Database and podcast type forward declarations */
+#include "feednotifier.h"
 
 /* Podcast 2.0 namespace support */
 #define PODCAST_NAMESPACE "https://podcastindex.org/namespace/1.0"
@@ -21,6 +22,12 @@ struct Podcast {
     gint64 last_updated;
     gint64 last_fetched;
     gboolean auto_download;
+    gint keep_episodes;             /* Retention: downloads to keep, 0 = all */
+    gint delete_played_after_days;  /* Retention: 0 = never delete played */
+    gint64 next_refresh;            /* Unix time the feed is next due, 0 = now */
+    gint ttl;                       /* <ttl> in minutes, parsed from the feed only */
+    gint64 update_frequency;        /* podcast:updateFrequency in seconds, parsed from the feed only */
+    gboolean update_complete;       /* podcast:updateFrequency complete="true" */
     GList *funding;  /* List of PodcastFunding */
     GList *images;   /* List of PodcastImage */
     GList *value;    /* List of PodcastValue (Value4Value) */
@@ -153,6 +160,16 @@ typedef struct _PodcastManager PodcastManager;
 typedef void (*DownloadProgressCallback)(gpointer user_data, gint episode_id, gdouble progress, const gchar *status);
 typedef void (*DownloadCompleteCallback)(gpointer user_data, gint episode_id, gboolean success, const gchar *error_msg);
 
+/* Feed update progress, called on the main thread after each feed */
+typedef void (*FeedUpdateProgressCallback)(gpointer user_data, gint podcast_id, const gchar *title,
+                                           gint done, gint total, gboolean success);
+
+/* Download priority - user-initiated downloads are scheduled before auto-downloads */
+typedef enum {
+    DOWNLOAD_PRIORITY_AUTO = 0,
+    DOWNLOAD_PRIORITY_USER = 10
+} DownloadPriority;
+
 /* Download task structure */
 typedef struct {
     PodcastEpisode *episode;
@@ -161,6 +178,12 @@ typedef struct {
     DownloadCompleteCallback complete_callback;
     gpointer user_data;
     gboolean cancelled;
+    DownloadPriority priority;
+    gchar *host;           /* Enclosure host, for per-host limits */
+    gint attempts;         /* Failed attempts so far */
+    gint64 next_attempt;   /* Monotonic time before which the task is not started */
+    guint64 sequence;      /* Enqueue order, keeps equal priorities FIFO */
+    gboolean running;      /* Handed to the download pool */
 } DownloadTask;
 
 /* Podcast Manager */
@@ -169,13 +192,29 @@ struct _PodcastManager {
     GList *podcasts;
     GThreadPool *download_pool;
     gchar *download_dir;
-    GHashTable *active_downloads; /* episode_id -> DownloadTask */
-    GMutex downloads_mutex;
+    GHashTable *active_downloads; /* episode_id -> DownloadTask (queued or running) */
+    GMutex downloads_mutex;       /* Guards everything download-related below too */
+    GList *download_queue;        /* Waiting DownloadTasks, in scheduling order */
+    GHashTable *downloads_per_host; /* host -> number of running downloads */
+    gint running_downloads;
+    guint64 download_sequence;
+    guint download_retry_id;      /* Timer that wakes the scheduler for retries */
+    gint64 download_retry_at;
+    gint max_downloads;           /* Global concurrency limit */
+    gint max_downloads_per_host;  /* 0 = no per-host limit */
+    gint max_download_retries;
+    gint64 download_rate_limit;   /* Total bytes/s across downloads, 0 = unlimited */
+    volatile gboolean shutting_down;
     guint update_timer_id;  /* Timer for automatic feed updates */
     gint update_interval_minutes;  /* Update interval in minutes */
-    volatile gboolean update_cancelled;  /* Flag to cancel feed updates */
-    gboolean update_in_progress;  /* Flag indicating update is running */
-    void *curl_handle;  /* Reusable curl handle for feed updates (CURL*) */
+    GThreadPool *feed_pool;  /* Single worker for subscriptions and feed updates */
+    GCancellable *update_cancellable;  /* Cancels the running feed update */
+    GCancellable *cancellable;  /* Cancelled when the manager is freed */
+    gint update_in_progress;  /* Flag indicating update is running (atomic) */
+    void *curl_handle;  /* Reusable curl handle, used only by the feed worker (CURL*) */
+    GList *notifiers;       /* Running FeedNotifiers */
+    GList *notified_feeds;  /* Podcast ids reported changed, waiting to be refreshed */
+    guint notify_timer_id;  /* Batches notifications into one update */
 };
 
 /* Podcast Manager */
@@ -186,11 +225,23 @@ void podcast_manager_free(PodcastManager *manager);
 void podcast_manager_start_auto_update(PodcastManager *manager, gint interval_minutes);
 void podcast_manager_stop_auto_update(PodcastManager *manager);
 
+/* Push-style updates: refresh feeds as soon as a notifier reports them changed.
+ * The manager takes ownership of the notifier. */
+gboolean podcast_manager_add_notifier(PodcastManager *manager, FeedNotifier *notifier);
+
 /* Podcast operations */
-gboolean podcast_manager_subscribe(PodcastManager *manager, const gchar *feed_url);
+void podcast_manager_subscribe_async(PodcastManager *manager, const gchar *feed_url,
+                                     GCancellable *cancellable,
+                                     GAsyncReadyCallback callback, gpointer user_data);
+gint podcast_manager_subscribe_finish(GAsyncResult *result, GError **error);  /* Podcast id or -1 */
 gboolean podcast_manager_unsubscribe(PodcastManager *manager, gint podcast_id);
-void podcast_manager_update_feed(PodcastManager *manager, gint podcast_id);
-void podcast_manager_update_all_feeds(PodcastManager *manager);
+/* Refresh the given podcast ids (NULL = all) on the feed worker */
+void podcast_manager_update_feeds_async(PodcastManager *manager, GList *podcast_ids,
+                                        GCancellable *cancellable,
+                                        FeedUpdateProgressCallback progress_callback,
+                                        gpointer progress_data,
+                                        GAsyncReadyCallback callback, gpointer user_data);
+gboolean podcast_manager_update_feeds_finish(GAsyncResult *result, GError **error);
 void podcast_manager_cancel_updates(PodcastManager *manager);
 gboolean podcast_manager_is_updating(PodcastManager *manager);
 GList* podcast_manager_get_podcasts(PodcastManager *manager);
@@ -201,6 +252,17 @@ void podcast_episode_download(PodcastManager *manager, PodcastEpisode *episode,
                              DownloadProgressCallback progress_cb, 
                              DownloadCompleteCallback complete_cb,
                              gpointer user_data);
+void podcast_episode_queue_download(PodcastManager *manager, PodcastEpisode *episode,
+                                    DownloadPriority priority,
+                                    DownloadProgressCallback progress_cb,
+                                    DownloadCompleteCallback complete_cb,
+                                    gpointer user_data);
+/* Auto-download and retention */
+gint podcast_manager_auto_download(PodcastManager *manager);
+gint podcast_manager_apply_retention(PodcastManager *manager);
+gboolean podcast_manager_set_download_settings(PodcastManager *manager, gint podcast_id,
+                                               gboolean auto_download, gint keep_episodes,
+                                               gint delete_played_after_days);
 void podcast_episode_cancel_download(PodcastManager *manager, gint episode_id);
 void podcast_episode_delete(PodcastManager *manager, PodcastEpisode *episode);
 void podcast_episode_mark_played(PodcastManager *manager, gint episode_id, gboolean played);
@@ -208,7 +270,10 @@ void podcast_episode_update_position(PodcastManager *manager, gint episode_id, g
 
 /* Chapter operations */
 GList* podcast_episode_get_chapters(PodcastManager *manager, gint episode_id);
-PodcastChapter* podcast_chapter_at_time(GList *chapters, gdouble time);
+void podcast_episode_get_chapters_async(PodcastManager *manager, gint episode_id,
+                                        GCancellable *cancellable,
+                                        GAsyncReadyCallback callback, gpointer user_data);
+GList* podcast_episode_get_chapters_finish(GAsyncResult *result, GError **error);
 
 /* Memory management */
 void podcast_free(Podcast *podcast);
@@ -245,6 +310,13 @@ GList* podcast_parse_episodes(const gchar *xml_data, gint podcast_id);
 gchar* fetch_url(const gchar *url);
 gchar* fetch_binary_url(const gchar *url, gsize *out_size);
 
+/* Cached fetching of episode sidecar files (chapters, transcripts) */
+gchar* podcast_sidecar_fetch(const gchar *url, gboolean revalidate);
+void podcast_sidecar_fetch_async(const gchar *url, GCancellable *cancellable,
+                                 GAsyncReadyCallback callback, gpointer user_data);
+gchar* podcast_sidecar_fetch_finish(GAsyncResult *result, GError **error);
+gchar* podcast_sidecar_read_cached(const gchar *url);  /* Never touches the network */
+
 /* Podcast image utilities */
 PodcastImage* podcast_get_best_image(GList *images, const gchar *purpose);
 const gchar* podcast_get_display_image_url(Podcast *podcast);
@@ -26,7 +26,8 @@ typedef struct {
     
     /* Episode list (right side) - GTK4 GListStore/GtkColumnView */
     GtkWidget *episode_listview;
-    GListStore *episode_store;
+    ShriekEpisodeListModel *episode_model;  /* Paged episodes of the selected podcast */
+    GListStore *episode_store;              /* Search results */
     GtkSingleSelection *episode_selection;
     gulong episode_selection_handler_id;
     
@@ -37,6 +38,13 @@ typedef struct {
     GtkWidget *download_button;
     GtkWidget *cancel_button;
     
+    /* Per-podcast download settings (auto-download and retention) */
+    GtkWidget *settings_button;
+    GtkWidget *auto_download_check;
+    GtkWidget *keep_episodes_spin;
+    GtkWidget *delete_played_spin;
+    gboolean loading_settings;  /* Suppresses saving while the controls are filled in */
+    
     /* Download progress tracking */
     GtkWidget *progress_bar;
     GtkWidget *progress_label;
@@ -59,6 +67,10 @@ typedef struct {
     ChapterView *chapter_view;
     GtkWidget *chapter_popover;
     GList *current_chapters;
+    gchar *playing_uri;  /* URI handed to play_callback, matched against playback position updates */
+    GCancellable *chapters_cancellable;  /* Pending chapter load for the playing episode */
+    GCancellable *search_cancellable;    /* Pending search started by podcast_view_filter */
+    GCancellable *feeds_cancellable;     /* Subscriptions and refreshes; cancelled on free */
     
     gchar *current_transcript_url;
     gchar *current_transcript_type;
@@ -99,6 +111,7 @@ GtkWidget* podcast_view_get_widget(PodcastView *view);
 void podcast_view_add_subscription(PodcastView *view);
 void podcast_view_refresh_podcasts(PodcastView *view);
 void podcast_view_play_episode(PodcastView *view, gint episode_id);
+void podcast_view_update_position(PodcastView *view, const gchar *uri, gdouble time);
 void podcast_view_refresh_episodes(PodcastView *view, gint podcast_id);
 void podcast_view_download_episode(PodcastView *view, gint episode_id);
 void podcast_view_filter(PodcastView *view, const gchar *search_text);
@@ -0,0 +1,11 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <glib.h>
+
+/* Index of the entry playing at time, given the entries' start times in
+ * ascending order; -1 before the first. hint is the previous result, which
+ * makes forward playback O(1); seeks fall back to bisection. */
+gint timeline_index_at_time(const gdouble *start_times, guint count, gdouble time, gint hint);
+
+#endif /* TIMELINE_H */
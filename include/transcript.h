@@ -0,0 +1,55 @@
+#ifndef TRANSCRIPT_H
+#define TRANSCRIPT_H
+
+#include <glib.h>
+#include <gio/gio.h>
+
+/* One cue of a time-synced transcript */
+typedef struct {
+    gdouble start_time;
+    gdouble end_time;
+    gchar *speaker;     /* NULL when the format doesn't name one */
+    gchar *text;
+    gint start_offset;  /* Character offsets of text within Transcript.text */
+    gint end_offset;
+} TranscriptSegment;
+
+/* A parsed transcript. Shared between the view and the parse cache, so it
+ * is immutable once built and reference counted. */
+typedef struct {
+    gatomicrefcount ref_count;
+    gchar *text;          /* Display text: segments joined, speaker changes labelled */
+    GPtrArray *segments;  /* TranscriptSegment, sorted by start_time */
+    GArray *start_times;  /* gdouble per segment, for timeline_index_at_time */
+    gboolean timed;       /* Segments carry timings, so playback can be followed */
+} Transcript;
+
+typedef enum {
+    TRANSCRIPT_FORMAT_PLAIN,
+    TRANSCRIPT_FORMAT_SRT,
+    TRANSCRIPT_FORMAT_VTT,
+    TRANSCRIPT_FORMAT_JSON
+} TranscriptFormat;
+
+/* Format from the podcast:transcript type, the URL and the data itself */
+TranscriptFormat transcript_detect_format(const gchar *data, const gchar *url, const gchar *type);
+
+/* Parse SRT, WebVTT, Podcasting 2.0 JSON or plain text. Never returns NULL;
+ * unparseable timed formats fall back to the raw text. */
+Transcript* transcript_parse(const gchar *data, TranscriptFormat format);
+Transcript* transcript_ref(Transcript *transcript);
+void transcript_unref(Transcript *transcript);
+
+/* Last segment starting at or before time, -1 before the first. hint is the
+ * previous result, which makes forward playback O(1). */
+gint transcript_segment_index_at_time(Transcript *transcript, gdouble time, gint hint);
+
+/* Fetch (through the sidecar cache) and parse on a worker thread. Recently
+ * parsed transcripts are kept in memory and returned without reparsing. */
+void transcript_load_async(const gchar *url, const gchar *type, GCancellable *cancellable,
+                           GAsyncReadyCallback callback, gpointer user_data);
+Transcript* transcript_load_finish(GAsyncResult *result, GError **error);
+
+void transcript_segment_free(TranscriptSegment *segment);
+
+#endif /* TRANSCRIPT_H */
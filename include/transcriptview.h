@@ -3,13 +3,7 @@
 
 #include <gtk/gtk.h>
 #include "podcast.h"
-
-/* Transcript segment for time-synced transcripts */
-typedef struct {
-    gdouble start_time;
-    gdouble end_time;
-    gchar *text;
-} TranscriptSegment;
+#include "transcript.h"
 
 /* Callback for transcript seeking */
 typedef void (*TranscriptSeekCallback)(gpointer user_data, gdouble time);
@@ -21,9 +15,13 @@ typedef struct {
     GtkWidget *search_entry;
     GtkWidget *search_button;
     
-    /* Transcript data */
-    GList *segments;  /* List of TranscriptSegment */
-    gchar *full_text; /* Full transcript text */
+    /* Transcript shown, NULL while loading or for plain text */
+    Transcript *transcript;
+    
+    /* Playback highlighting */
+    GtkTextTag *current_tag;
+    GtkTextMark *current_mark;
+    gint current_segment;  /* Highlighted segment, -1 if none */
     
     /* Search functionality */
     GtkTextMark *search_mark;
@@ -31,6 +29,9 @@ typedef struct {
     /* Seeking callback */
     TranscriptSeekCallback seek_callback;
     gpointer seek_callback_data;
+    
+    /* Pending transcript load, cancelled when superseded */
+    GCancellable *load_cancellable;
 } TranscriptView;
 
 /* Transcript view lifecycle */
@@ -45,7 +46,4 @@ void transcript_view_highlight_time(TranscriptView *view, gdouble current_time);
 void transcript_view_clear(TranscriptView *view);
 void transcript_view_set_seek_callback(TranscriptView *view, TranscriptSeekCallback callback, gpointer user_data);
 
-/* Memory management */
-void transcript_segment_free(TranscriptSegment *segment);
-
 #endif /* TRANSCRIPTVIEW_H */
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include "albumview.h"
 #include <string.h>
 
+/* Edge of the solid-colour textures shown before covers load; the picture
+ * scales them up, so there is no point in a full-size one */
+#define ALBUM_SWATCH_SIZE 4
+
 /* ========== AlbumItem GObject Implementation ========== */
 
 G_DEFINE_TYPE(AlbumItem, album_item, G_TYPE_OBJECT)
@@ -19,6 +23,10 @@ static void album_item_finalize(GObject *object) {
         g_object_weak_unref(G_OBJECT(item->picture), on_picture_widget_destroyed, item);
         item->picture = NULL;
     }
+    if (item->cover_cancellable) {
+        g_cancellable_cancel(item->cover_cancellable);
+        g_clear_object(&item->cover_cancellable);
+    }
     g_free(item->artist);
     g_free(item->album);
     g_clear_object(&item->cover);
@@ -34,6 +42,8 @@ static void album_item_init(AlbumItem *item) {
     item->artist = NULL;
     item->album = NULL;
     item->cover = NULL;
+    item->cover_loaded = FALSE;
+    item->cover_cancellable = NULL;
     item->picture = NULL;
 }
 
@@ -44,23 +54,12 @@ AlbumItem* album_item_new(const gchar *artist, const gchar *album) {
     return item;
 }
 
-void album_item_set_cover(AlbumItem *item, GdkPixbuf *pixbuf) {
+void album_item_set_cover(AlbumItem *item, GdkTexture *texture) {
     if (!item) return;
     g_clear_object(&item->cover);
-    if (pixbuf) {
-        /* GTK4: Use GBytes-based texture creation instead of deprecated gdk_texture_new_for_pixbuf */
-        GBytes *bytes = gdk_pixbuf_read_pixel_bytes(pixbuf);
-        int width = gdk_pixbuf_get_width(pixbuf);
-        int height = gdk_pixbuf_get_height(pixbuf);
-        int stride = gdk_pixbuf_get_rowstride(pixbuf);
-        gboolean has_alpha = gdk_pixbuf_get_has_alpha(pixbuf);
-        
-        GdkTexture *texture = gdk_memory_texture_new(width, height,
-            has_alpha ? GDK_MEMORY_R8G8B8A8 : GDK_MEMORY_R8G8B8,
-            bytes, stride);
-        g_bytes_unref(bytes);
-        item->cover = GDK_PAINTABLE(texture);
-        g_debug("album_item_set_cover: Created texture for %s", item->album ? item->album : "Unknown");
+    if (texture) {
+        /* Textures are immutable, so the manager's copy can be shared */
+        item->cover = GDK_PAINTABLE(g_object_ref(texture));
     }
     
     /* Directly update the picture widget if we have a reference to it */
@@ -78,27 +77,34 @@ void album_item_set_cover(AlbumItem *item, GdkPixbuf *pixbuf) {
 
 typedef struct {
     AlbumItem *item;
+    GCancellable *cancellable;  /* The request this load belongs to */
 } AlbumLoadData;
 
-static void on_coverart_loaded(GdkPixbuf *pixbuf, gpointer user_data) {
+static void on_coverart_loaded(GdkTexture *texture, gpointer user_data) {
     AlbumLoadData *data = (AlbumLoadData *)user_data;
     
-    if (data && data->item && pixbuf) {
+    if (data && data->item && texture) {
         g_debug("on_coverart_loaded: Cover art loaded for %s - %s", 
                 data->item->artist ? data->item->artist : "Unknown",
                 data->item->album ? data->item->album : "Unknown");
         
         /* Update the cover on the item - this will also update the picture widget
          * directly if one is bound */
-        album_item_set_cover(data->item, pixbuf);
+        album_item_set_cover(data->item, texture);
+        data->item->cover_loaded = TRUE;
     } else {
-        g_debug("on_coverart_loaded: No pixbuf or item for callback");
+        g_debug("on_coverart_loaded: No texture or item for callback");
     }
     
     if (data) {
         if (data->item) {
+            /* A rebind may already have started a newer request */
+            if (data->item->cover_cancellable == data->cancellable) {
+                g_clear_object(&data->item->cover_cancellable);
+            }
             g_object_unref(data->item);
         }
+        g_clear_object(&data->cancellable);
         g_free(data);
     }
 }
@@ -137,7 +143,7 @@ static void setup_album_item(GtkListItemFactory *factory, GtkListItem *list_item
 
 static void bind_album_item(GtkListItemFactory *factory, GtkListItem *list_item, gpointer user_data) {
     (void)factory;
-    (void)user_data;
+    AlbumView *view = (AlbumView *)user_data;
     
     GtkWidget *box = gtk_list_item_get_child(list_item);
     AlbumItem *item = gtk_list_item_get_item(list_item);
@@ -167,6 +173,20 @@ static void bind_album_item(GtkListItemFactory *factory, GtkListItem *list_item,
     
     /* Set the album name */
     gtk_label_set_text(GTK_LABEL(label), item->album ? item->album : "Unknown Album");
+    
+    /* Covers are only loaded for items on screen; unbind cancels the request */
+    if (!item->cover_loaded && !item->cover_cancellable && view->coverart_manager) {
+        item->cover_cancellable = g_cancellable_new();
+        
+        AlbumLoadData *data = g_new0(AlbumLoadData, 1);
+        data->item = g_object_ref(item);
+        data->cancellable = g_object_ref(item->cover_cancellable);
+        
+        coverart_fetch_album_async(view->coverart_manager, view->database,
+                                   item->artist, item->album, COVER_ART_SIZE_MEDIUM,
+                                   G_PRIORITY_DEFAULT, item->cover_cancellable,
+                                   on_coverart_loaded, data);
+    }
 }
 
 static void unbind_album_item(GtkListItemFactory *factory, GtkListItem *list_item, gpointer user_data) {
@@ -175,6 +195,13 @@ static void unbind_album_item(GtkListItemFactory *factory, GtkListItem *list_ite
     
     /* Clear the picture reference when item is unbound */
     AlbumItem *item = gtk_list_item_get_item(list_item);
+    
+    /* Scrolled away (or the artist changed) before its cover arrived */
+    if (item && item->cover_cancellable) {
+        g_cancellable_cancel(item->cover_cancellable);
+        g_clear_object(&item->cover_cancellable);
+    }
+    
     if (item && item->picture) {
         g_object_weak_unref(G_OBJECT(item->picture), on_picture_widget_destroyed, item);
         item->picture = NULL;
@@ -258,30 +285,31 @@ void album_view_set_artist(AlbumView *view, const gchar *artist) {
     /* Get albums for this artist */
     GList *albums = database_get_albums_by_artist(view->database, artist);
     
-    /* Create default cover pixbuf */
-    GdkPixbuf *default_cover = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, 
-                                              COVER_ART_SIZE_MEDIUM, COVER_ART_SIZE_MEDIUM);
-    gdk_pixbuf_fill(default_cover, 0x666666FF);
+    /* Shared placeholder until each item's art loads */
+    GdkTexture *default_cover = view->coverart_manager ?
+        coverart_manager_get_placeholder(view->coverart_manager, COVER_ART_SIZE_MEDIUM) : NULL;
+    
+    /* Albums with a known colour show it instead, one small swatch per
+     * colour that the picture stretches to fill */
+    GHashTable *swatches = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_object_unref);
     
     for (GList *l = albums; l != NULL; l = l->next) {
-        typedef struct { gchar *artist; gchar *album; } AlbumInfo;
         AlbumInfo *info = (AlbumInfo *)l->data;
         
-        /* Create album item and add to store */
+        GdkTexture *cover = default_cover;
+        if (info->color != 0) {
+            cover = g_hash_table_lookup(swatches, GUINT_TO_POINTER(info->color));
+            if (!cover) {
+                cover = coverart_texture_new_solid(ALBUM_SWATCH_SIZE, info->color);
+                g_hash_table_insert(swatches, GUINT_TO_POINTER(info->color), cover);
+            }
+        }
+        
+        /* Create album item and add to store; its cover loads when bound */
         AlbumItem *item = album_item_new(info->artist, info->album);
-        album_item_set_cover(item, default_cover);
+        album_item_set_cover(item, cover);
         g_list_store_append(view->store, item);
         
-        /* Load cover art asynchronously - pass database to extract from audio if needed */
-        if (view->coverart_manager) {
-            AlbumLoadData *data = g_new0(AlbumLoadData, 1);
-            data->item = g_object_ref(item);
-            
-            coverart_fetch_async_with_db(view->coverart_manager, view->database,
-                               info->artist, info->album,
-                               COVER_ART_SIZE_MEDIUM, on_coverart_loaded, data);
-        }
-        
         g_object_unref(item);  /* Store holds reference */
         g_free(info->artist);
         g_free(info->album);
@@ -289,7 +317,8 @@ void album_view_set_artist(AlbumView *view, const gchar *artist) {
     }
     
     g_list_free(albums);
-    g_object_unref(default_cover);
+    g_hash_table_destroy(swatches);
+    g_clear_object(&default_cover);
 }
 
 typedef struct {
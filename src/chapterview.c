@@ -1,4 +1,5 @@
 #include "chapterview.h"
+#include "timeline.h"
 #include <string.h>
 
 /* Helper function to format time */
@@ -43,6 +44,12 @@ static gpointer copy_chapter(gconstpointer src, gpointer data) {
     return copy;
 }
 
+static gint compare_chapter_start(gconstpointer a, gconstpointer b) {
+    const PodcastChapter *x = *(PodcastChapter * const *)a;
+    const PodcastChapter *y = *(PodcastChapter * const *)b;
+    return (x->start_time > y->start_time) - (x->start_time < y->start_time);
+}
+
 /* GTK4 Factory functions for chapter columns */
 static void setup_time_label(GtkListItemFactory *factory, GtkListItem *list_item, gpointer user_data) {
     (void)factory;
@@ -86,6 +93,7 @@ static void bind_title_label(GtkListItemFactory *factory, GtkListItem *list_item
 
 ChapterView* chapter_view_new(void) {
     ChapterView *view = g_new0(ChapterView, 1);
+    view->current_index = -1;
     
     view->container = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
     
@@ -138,7 +146,7 @@ ChapterView* chapter_view_new(void) {
     gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scrolled), view->columnview);
     gtk_widget_set_vexpand(scrolled, TRUE);
     gtk_box_append(GTK_BOX(view->container), scrolled);
-
+    
     /* GTK4: widgets are visible by default */
     return view;
 }
@@ -147,7 +155,10 @@ void chapter_view_free(ChapterView *view) {
     if (!view) return;
     
     if (view->chapters) {
-        g_list_free_full(view->chapters, (GDestroyNotify)podcast_chapter_free);
+        g_ptr_array_unref(view->chapters);
+    }
+    if (view->start_times) {
+        g_array_unref(view->start_times);
     }
     
     if (view->store) {
@@ -171,12 +182,18 @@ void chapter_view_set_chapters(ChapterView *view, GList *chapters) {
     /* Clear existing chapters */
     chapter_view_clear(view);
     
-    /* Store new chapters */
-    view->chapters = g_list_copy_deep(chapters, copy_chapter, NULL);
+    /* Store new chapters, sorted so the current one can be found by bisection */
+    view->chapters = g_ptr_array_new_with_free_func((GDestroyNotify)podcast_chapter_free);
+    for (GList *l = chapters; l != NULL; l = l->next) {
+        g_ptr_array_add(view->chapters, copy_chapter(l->data, NULL));
+    }
+    g_ptr_array_sort(view->chapters, compare_chapter_start);
+    view->start_times = g_array_sized_new(FALSE, FALSE, sizeof(gdouble), view->chapters->len);
     
     /* Populate list store */
-    for (GList *l = chapters; l != NULL; l = l->next) {
-        PodcastChapter *chapter = (PodcastChapter *)l->data;
+    for (guint i = 0; i < view->chapters->len; i++) {
+        PodcastChapter *chapter = (PodcastChapter *)g_ptr_array_index(view->chapters, i);
+        g_array_append_val(view->start_times, chapter->start_time);
         
         ShriekChapterObject *obj = shriek_chapter_object_new(
             chapter->start_time,
@@ -195,36 +212,27 @@ void chapter_view_clear(ChapterView *view) {
     g_list_store_remove_all(view->store);
     
     if (view->chapters) {
-        g_list_free_full(view->chapters, (GDestroyNotify)podcast_chapter_free);
+        g_ptr_array_unref(view->chapters);
         view->chapters = NULL;
     }
+    if (view->start_times) {
+        g_array_unref(view->start_times);
+        view->start_times = NULL;
+    }
+    view->current_index = -1;
 }
 
 void chapter_view_highlight_current(ChapterView *view, gdouble current_time) {
-    if (!view || !view->chapters) return;
-    
-    /* Find the current chapter based on time */
-    PodcastChapter *current_chapter = podcast_chapter_at_time(view->chapters, current_time);
-    if (!current_chapter) return;
-    
-    /* Find and select the corresponding row */
-    guint n_items = g_list_model_get_n_items(G_LIST_MODEL(view->store));
-    
-    for (guint i = 0; i < n_items; i++) {
-        ShriekChapterObject *obj = g_list_model_get_item(G_LIST_MODEL(view->store), i);
-        if (obj) {
-            gdouble start_time = shriek_chapter_object_get_start_time(obj);
-            
-            if (start_time == current_chapter->start_time) {
-                gtk_single_selection_set_selected(view->selection, i);
-                
-                /* Scroll to the selected row - GTK4 does this automatically with selection changes */
-                g_object_unref(obj);
-                break;
-            }
-            g_object_unref(obj);
-        }
-    }
+    if (!view || !view->start_times) return;
+    
+    /* Rows are in array order, so the index is the row; called on every
+     * position tick, and nothing changes until the chapter does */
+    gint index = timeline_index_at_time((const gdouble *)view->start_times->data, view->start_times->len,
+                                        current_time, view->current_index);
+    if (index == view->current_index) return;
+    
+    view->current_index = index;
+    gtk_single_selection_set_selected(view->selection, index >= 0 ? (guint)index : GTK_INVALID_LIST_POSITION);
 }
 
 void chapter_view_set_seek_callback(ChapterView *view, ChapterSeekCallback callback, gpointer user_data) {
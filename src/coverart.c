@@ -1,5 +1,6 @@
 #include "coverart.h"
 #include "database.h"
+#include <glib/gstdio.h>
 #include <string.h>
 #include <gst/gst.h>
 #include <gst/pbutils/pbutils.h>
@@ -7,6 +8,32 @@
 
 /* Thread pool function wrapper */
 static void coverart_fetch_pool_func(gpointer data, gpointer user_data);
+static gint coverart_fetch_compare(gconstpointer a, gconstpointer b, gpointer user_data);
+static void coverart_fetch_url_pool_func(gpointer data, gpointer user_data);
+
+/* Decoded cover held by the memory cache */
+typedef struct {
+    gchar *key;
+    GdkTexture *texture;
+    gsize bytes;
+} CoverCacheEntry;
+
+static void coverart_cache_entry_free(CoverCacheEntry *entry) {
+    g_free(entry->key);
+    g_object_unref(entry->texture);
+    g_free(entry);
+}
+
+/* Thumbnail file: this header, then premultiplied RGBA rows, so loading one
+ * is a read and a texture upload with no decode or conversion */
+#define COVER_THUMBNAIL_MAGIC 0x31485453  /* "STH1" */
+
+typedef struct {
+    guint32 magic;
+    guint32 width;
+    guint32 height;
+    guint32 stride;
+} CoverThumbnailHeader;
 
 CoverArtManager* coverart_manager_new(void) {
     CoverArtManager *manager = g_new0(CoverArtManager, 1);
@@ -14,8 +41,18 @@ CoverArtManager* coverart_manager_new(void) {
     manager->cache_dir = g_build_filename(g_get_user_cache_dir(), "shriek", "covers", NULL);
     g_mkdir_with_parents(manager->cache_dir, 0755);
     
-    manager->cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_object_unref);
+    /* Keys are owned by the entries in cache_lru */
+    manager->cache = g_hash_table_new(g_str_hash, g_str_equal);
+    g_queue_init(&manager->cache_lru);
+    manager->cache_budget = COVER_ART_CACHE_BUDGET;
+    manager->cache_loading = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    g_cond_init(&manager->cache_loaded);
     g_mutex_init(&manager->cache_mutex);
+    manager->placeholders = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_object_unref);
+    manager->missing = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    manager->thumbnail_sizes = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                                     (GDestroyNotify)g_array_unref);
+    g_mutex_init(&manager->thumbnail_mutex);
     
     /* Create thread pool with max 4 concurrent threads */
     GError *error = NULL;
@@ -23,7 +60,18 @@ CoverArtManager* coverart_manager_new(void) {
     if (error) {
         g_warning("Failed to create cover art thread pool: %s", error->message);
         g_error_free(error);
+    } else {
+        g_thread_pool_set_sort_function(manager->fetch_pool, coverart_fetch_compare, NULL);
+    }
+    
+    /* Downloads get their own pool so slow servers can't starve local lookups */
+    manager->url_pool = g_thread_pool_new(coverart_fetch_url_pool_func, manager, 4, FALSE, &error);
+    if (error) {
+        g_warning("Failed to create cover art download pool: %s", error->message);
+        g_error_free(error);
     }
+    manager->url_pending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    g_mutex_init(&manager->url_mutex);
     
     return manager;
 }
@@ -35,13 +83,246 @@ void coverart_manager_free(CoverArtManager *manager) {
     if (manager->fetch_pool) {
         g_thread_pool_free(manager->fetch_pool, FALSE, TRUE);
     }
+    if (manager->url_pool) {
+        g_thread_pool_free(manager->url_pool, FALSE, TRUE);
+    }
+    g_hash_table_destroy(manager->url_pending);
+    g_mutex_clear(&manager->url_mutex);
     
+    coverpack_free(manager->pack);
+    g_hash_table_destroy(manager->thumbnail_sizes);
+    g_mutex_clear(&manager->thumbnail_mutex);
     g_free(manager->cache_dir);
     g_hash_table_destroy(manager->cache);
+    g_queue_clear_full(&manager->cache_lru, (GDestroyNotify)coverart_cache_entry_free);
+    g_hash_table_destroy(manager->cache_loading);
+    g_cond_clear(&manager->cache_loaded);
+    g_hash_table_destroy(manager->placeholders);
+    g_hash_table_destroy(manager->missing);
     g_mutex_clear(&manager->cache_mutex);
     g_free(manager);
 }
 
+/* Evict least recently used entries until within budget. Caller holds cache_mutex. */
+static void coverart_cache_trim_locked(CoverArtManager *manager) {
+    while (manager->cache_bytes > manager->cache_budget && manager->cache_lru.tail) {
+        CoverCacheEntry *entry = g_queue_pop_tail(&manager->cache_lru);
+        g_hash_table_remove(manager->cache, entry->key);
+        manager->cache_bytes -= entry->bytes;
+        manager->cache_evictions++;
+        coverart_cache_entry_free(entry);
+    }
+}
+
+static void coverart_cache_insert_locked(CoverArtManager *manager, const gchar *key, GdkTexture *texture) {
+    GList *link = g_hash_table_lookup(manager->cache, key);
+    if (link) {
+        CoverCacheEntry *old = link->data;
+        g_hash_table_remove(manager->cache, key);
+        g_queue_delete_link(&manager->cache_lru, link);
+        manager->cache_bytes -= old->bytes;
+        coverart_cache_entry_free(old);
+    }
+    
+    CoverCacheEntry *entry = g_new0(CoverCacheEntry, 1);
+    entry->key = g_strdup(key);
+    entry->texture = g_object_ref(texture);
+    entry->bytes = (gsize)gdk_texture_get_width(texture) * gdk_texture_get_height(texture) * 4;
+    
+    g_queue_push_head(&manager->cache_lru, entry);
+    g_hash_table_insert(manager->cache, entry->key, manager->cache_lru.head);
+    manager->cache_bytes += entry->bytes;
+    coverart_cache_trim_locked(manager);
+}
+
+/* Cached texture for key, marked most recently used. Caller holds cache_mutex. */
+static GdkTexture* coverart_cache_peek_locked(CoverArtManager *manager, const gchar *key) {
+    GList *link = g_hash_table_lookup(manager->cache, key);
+    if (!link) return NULL;
+    
+    CoverCacheEntry *entry = link->data;
+    g_queue_unlink(&manager->cache_lru, link);
+    g_queue_push_head_link(&manager->cache_lru, link);
+    manager->cache_hits++;
+    return g_object_ref(entry->texture);
+}
+
+/* Return a new reference to the cached texture for key, or NULL. On NULL,
+ * claimed says whether the caller now holds the key: it then loads it and
+ * must call coverart_cache_finish_load. If another thread already holds the
+ * claim, workers wait for it rather than decoding the same image twice, but
+ * the main thread gets a plain miss so the UI never blocks on a decode. */
+static GdkTexture* coverart_cache_lookup_or_claim(CoverArtManager *manager, const gchar *key,
+                                                  gboolean *claimed) {
+    GdkTexture *texture = NULL;
+    gboolean wait = !g_main_context_is_owner(g_main_context_default());
+    
+    *claimed = FALSE;
+    g_mutex_lock(&manager->cache_mutex);
+    while (TRUE) {
+        texture = coverart_cache_peek_locked(manager, key);
+        if (texture) break;
+        
+        if (!g_hash_table_contains(manager->cache_loading, key)) {
+            g_hash_table_add(manager->cache_loading, g_strdup(key));
+            manager->cache_misses++;
+            *claimed = TRUE;
+            break;
+        }
+        if (!wait) break;
+        
+        g_cond_wait(&manager->cache_loaded, &manager->cache_mutex);
+    }
+    g_mutex_unlock(&manager->cache_mutex);
+    
+    return texture;
+}
+
+/* Release a claim, caching texture if the load succeeded. On failure a
+ * waiting thread takes over the claim and tries itself. */
+static void coverart_cache_finish_load(CoverArtManager *manager, const gchar *key, GdkTexture *texture) {
+    g_mutex_lock(&manager->cache_mutex);
+    if (texture) {
+        coverart_cache_insert_locked(manager, key, texture);
+    }
+    g_hash_table_remove(manager->cache_loading, key);
+    g_cond_broadcast(&manager->cache_loaded);
+    g_mutex_unlock(&manager->cache_mutex);
+}
+
+/* Forget every key starting with prefix, i.e. all sizes of one cover */
+static void coverart_cache_remove_prefix(CoverArtManager *manager, const gchar *prefix) {
+    g_mutex_lock(&manager->cache_mutex);
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, manager->cache);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        if (!g_str_has_prefix(key, prefix)) continue;
+        
+        GList *link = value;
+        CoverCacheEntry *entry = link->data;
+        manager->cache_bytes -= entry->bytes;
+        g_hash_table_iter_remove(&iter);
+        g_queue_delete_link(&manager->cache_lru, link);
+        coverart_cache_entry_free(entry);
+    }
+    g_mutex_unlock(&manager->cache_mutex);
+}
+
+gboolean coverart_manager_enable_pack(CoverArtManager *manager) {
+    if (!manager) return FALSE;
+    if (manager->pack) return TRUE;
+    
+    gchar *path = g_build_filename(manager->cache_dir, "thumbnails.pack", NULL);
+    GError *error = NULL;
+    manager->pack = coverpack_open(path, &error);
+    g_free(path);
+    
+    if (!manager->pack) {
+        g_warning("Failed to open cover pack: %s", error->message);
+        g_error_free(error);
+        return FALSE;
+    }
+    
+    /* Rebuild the size table with the pack's keys on next use */
+    g_mutex_lock(&manager->thumbnail_mutex);
+    g_hash_table_remove_all(manager->thumbnail_sizes);
+    manager->thumbnail_sizes_loaded = FALSE;
+    g_mutex_unlock(&manager->thumbnail_mutex);
+    
+    coverart_manager_compact_pack(manager, FALSE);
+    return TRUE;
+}
+
+gboolean coverart_manager_compact_pack(CoverArtManager *manager, gboolean force) {
+    if (!manager || !manager->pack) return FALSE;
+    
+    /* Not worth rewriting the file until replaced thumbnails outweigh live ones */
+    gsize dead = coverpack_get_dead_bytes(manager->pack);
+    if (!force && dead * 2 < coverpack_get_size(manager->pack)) {
+        return TRUE;
+    }
+    
+    GError *error = NULL;
+    if (!coverpack_compact(manager->pack, &error)) {
+        g_warning("Failed to compact cover pack: %s", error->message);
+        g_error_free(error);
+        return FALSE;
+    }
+    
+    g_debug("Compacted cover pack, reclaimed %" G_GSIZE_FORMAT " bytes", dead);
+    return TRUE;
+}
+
+GdkTexture* coverart_manager_get_placeholder(CoverArtManager *manager, gint size) {
+    if (!manager) return coverart_texture_new_solid(size, COVER_ART_PLACEHOLDER_RGBA);
+    
+    g_mutex_lock(&manager->cache_mutex);
+    GdkTexture *texture = g_hash_table_lookup(manager->placeholders, GINT_TO_POINTER(size));
+    if (!texture) {
+        texture = coverart_texture_new_solid(size, COVER_ART_PLACEHOLDER_RGBA);
+        g_hash_table_insert(manager->placeholders, GINT_TO_POINTER(size), texture);
+    }
+    g_object_ref(texture);
+    g_mutex_unlock(&manager->cache_mutex);
+    
+    return texture;
+}
+
+/* Negative cache: albums and URLs recently found to have no art */
+static gboolean coverart_is_missing(CoverArtManager *manager, const gchar *key) {
+    gboolean missing = FALSE;
+    
+    g_mutex_lock(&manager->cache_mutex);
+    gint64 *expires = g_hash_table_lookup(manager->missing, key);
+    if (expires) {
+        missing = *expires > g_get_monotonic_time();
+        if (!missing) {
+            g_hash_table_remove(manager->missing, key);
+        }
+    }
+    g_mutex_unlock(&manager->cache_mutex);
+    
+    return missing;
+}
+
+static void coverart_mark_missing(CoverArtManager *manager, const gchar *key) {
+    gint64 *expires = g_new(gint64, 1);
+    *expires = g_get_monotonic_time() + COVER_ART_MISSING_TTL;
+    
+    g_mutex_lock(&manager->cache_mutex);
+    g_hash_table_insert(manager->missing, g_strdup(key), expires);
+    g_mutex_unlock(&manager->cache_mutex);
+}
+
+static void coverart_clear_missing(CoverArtManager *manager, const gchar *key) {
+    g_mutex_lock(&manager->cache_mutex);
+    g_hash_table_remove(manager->missing, key);
+    g_mutex_unlock(&manager->cache_mutex);
+}
+
+void coverart_manager_set_cache_budget(CoverArtManager *manager, gsize bytes) {
+    if (!manager) return;
+    
+    g_mutex_lock(&manager->cache_mutex);
+    manager->cache_budget = bytes;
+    coverart_cache_trim_locked(manager);
+    g_mutex_unlock(&manager->cache_mutex);
+}
+
+void coverart_manager_get_cache_stats(CoverArtManager *manager, CoverArtCacheStats *stats) {
+    if (!manager || !stats) return;
+    
+    g_mutex_lock(&manager->cache_mutex);
+    stats->hits = manager->cache_hits;
+    stats->misses = manager->cache_misses;
+    stats->evictions = manager->cache_evictions;
+    stats->entries = manager->cache_lru.length;
+    stats->bytes = manager->cache_bytes;
+    stats->budget = manager->cache_budget;
+    g_mutex_unlock(&manager->cache_mutex);
+}
+
 static gchar* coverart_generate_cache_key(const gchar *artist, const gchar *album) {
     return g_strdup_printf("%s-%s", artist ? artist : "Unknown", album ? album : "Unknown");
 }
@@ -69,43 +350,348 @@ gboolean coverart_exists(CoverArtManager *manager, const gchar *artist, const gc
     return exists;
 }
 
-GdkPixbuf* coverart_get(CoverArtManager *manager, const gchar *artist, const gchar *album, gint size) {
-    if (!manager) return NULL;
+GdkTexture* coverart_texture_new_solid(gint size, guint32 rgba) {
+    gsize stride = (gsize)size * 4;
+    guchar *pixels = g_malloc(stride * size);
+    
+    /* Opaque, so premultiplying changes nothing */
+    for (gsize i = 0; i < stride * size; i += 4) {
+        pixels[i] = (rgba >> 24) & 0xFF;
+        pixels[i + 1] = (rgba >> 16) & 0xFF;
+        pixels[i + 2] = (rgba >> 8) & 0xFF;
+        pixels[i + 3] = 0xFF;
+    }
     
-    /* Include size in cache key so different sizes are cached separately */
-    gchar *base_key = coverart_generate_cache_key(artist, album);
-    gchar *key = g_strdup_printf("%s@%d", base_key, size);
-    g_free(base_key);
+    GBytes *bytes = g_bytes_new_take(pixels, stride * size);
+    GdkTexture *texture = gdk_memory_texture_new(size, size, GDK_MEMORY_R8G8B8A8_PREMULTIPLIED,
+                                                 bytes, stride);
+    g_bytes_unref(bytes);
+    return texture;
+}
+
+static gchar* coverart_thumbnail_path(CoverArtManager *manager, const gchar *source_path, gint size) {
+    gchar *name = g_path_get_basename(source_path);
+    gchar *size_dir = g_strdup_printf("%d", size);
+    gchar *path = g_build_filename(manager->cache_dir, "thumbnails", size_dir, name, NULL);
+    g_free(size_dir);
+    g_free(name);
+    return path;
+}
+
+/* Key of a thumbnail in the pack */
+static gchar* coverart_thumbnail_key(const gchar *source_path, gint size) {
+    gchar *name = g_path_get_basename(source_path);
+    gchar *key = g_strdup_printf("%s@%d", name, size);
+    g_free(name);
+    return key;
+}
+
+/* Record that name has a size thumbnail. Caller holds thumbnail_mutex. */
+static void coverart_thumbnail_sizes_add_locked(CoverArtManager *manager, const gchar *name, gint size) {
+    GArray *sizes = g_hash_table_lookup(manager->thumbnail_sizes, name);
+    if (!sizes) {
+        sizes = g_array_new(FALSE, FALSE, sizeof(gint));
+        g_hash_table_insert(manager->thumbnail_sizes, g_strdup(name), sizes);
+    }
+    for (guint i = 0; i < sizes->len; i++) {
+        if (g_array_index(sizes, gint, i) == size) return;
+    }
+    g_array_append_val(sizes, size);
+}
+
+/* Fill the size table from what is already stored, once per run. Caller
+ * holds thumbnail_mutex. */
+static void coverart_thumbnail_sizes_load_locked(CoverArtManager *manager) {
+    if (manager->thumbnail_sizes_loaded) return;
+    manager->thumbnail_sizes_loaded = TRUE;
+    
+    if (manager->pack) {
+        GPtrArray *keys = coverpack_list_keys(manager->pack, NULL);
+        for (guint i = 0; i < keys->len; i++) {
+            gchar *key = g_ptr_array_index(keys, i);
+            gchar *at = strrchr(key, '@');
+            if (!at) continue;
+            *at = '\0';
+            coverart_thumbnail_sizes_add_locked(manager, key, (gint)g_ascii_strtoll(at + 1, NULL, 10));
+        }
+        g_ptr_array_unref(keys);
+    }
     
-    g_mutex_lock(&manager->cache_mutex);
-    GdkPixbuf *cached = g_hash_table_lookup(manager->cache, key);
-    if (cached) {
-        g_object_ref(cached);
-        g_mutex_unlock(&manager->cache_mutex);
+    /* Thumbnail files, including ones not yet moved into the pack */
+    gchar *thumbnails_dir = g_build_filename(manager->cache_dir, "thumbnails", NULL);
+    GDir *dir = g_dir_open(thumbnails_dir, 0, NULL);
+    if (dir) {
+        const gchar *size_dir;
+        while ((size_dir = g_dir_read_name(dir)) != NULL) {
+            gint size = (gint)g_ascii_strtoll(size_dir, NULL, 10);
+            if (size <= 0) continue;
+            
+            gchar *path = g_build_filename(thumbnails_dir, size_dir, NULL);
+            GDir *files = g_dir_open(path, 0, NULL);
+            if (files) {
+                const gchar *name;
+                while ((name = g_dir_read_name(files)) != NULL) {
+                    coverart_thumbnail_sizes_add_locked(manager, name, size);
+                }
+                g_dir_close(files);
+            }
+            g_free(path);
+        }
+        g_dir_close(dir);
+    }
+    g_free(thumbnails_dir);
+}
+
+static void coverart_thumbnail_sizes_add(CoverArtManager *manager, const gchar *source_path, gint size) {
+    gchar *name = g_path_get_basename(source_path);
+    g_mutex_lock(&manager->thumbnail_mutex);
+    coverart_thumbnail_sizes_load_locked(manager);
+    coverart_thumbnail_sizes_add_locked(manager, name, size);
+    g_mutex_unlock(&manager->thumbnail_mutex);
+    g_free(name);
+}
+
+/* Scale down (or up) to fit size x size, keeping the aspect ratio */
+static GdkPixbuf* coverart_scale_to_fit(GdkPixbuf *pixbuf, gint size) {
+    gint width = gdk_pixbuf_get_width(pixbuf);
+    gint height = gdk_pixbuf_get_height(pixbuf);
+    
+    if (MAX(width, height) == size) {
+        return g_object_ref(pixbuf);
+    }
+    
+    gint scaled_width = width >= height ? size : MAX(1, width * size / height);
+    gint scaled_height = height >= width ? size : MAX(1, height * size / width);
+    return gdk_pixbuf_scale_simple(pixbuf, scaled_width, scaled_height, GDK_INTERP_BILINEAR);
+}
+
+static GdkTexture* coverart_thumbnail_decode(GBytes *data) {
+    gsize length = 0;
+    const CoverThumbnailHeader *header = g_bytes_get_data(data, &length);
+    
+    if (length < sizeof(CoverThumbnailHeader) || header->magic != COVER_THUMBNAIL_MAGIC ||
+        header->width == 0 || header->height == 0 || header->stride < header->width * 4 ||
+        (length - sizeof(CoverThumbnailHeader)) / header->stride < header->height) {
+        return NULL;
+    }
+    
+    GBytes *pixels = g_bytes_new_from_bytes(data, sizeof(CoverThumbnailHeader),
+                                            (gsize)header->stride * header->height);
+    GdkTexture *texture = gdk_memory_texture_new(header->width, header->height,
+                                                 GDK_MEMORY_R8G8B8A8_PREMULTIPLIED,
+                                                 pixels, header->stride);
+    g_bytes_unref(pixels);
+    return texture;
+}
+
+/* Premultiply pixbuf (already at thumbnail size) into the thumbnail layout */
+static GBytes* coverart_thumbnail_encode(GdkPixbuf *pixbuf) {
+    gint width = gdk_pixbuf_get_width(pixbuf);
+    gint height = gdk_pixbuf_get_height(pixbuf);
+    gint channels = gdk_pixbuf_get_n_channels(pixbuf);
+    gint src_stride = gdk_pixbuf_get_rowstride(pixbuf);
+    gboolean has_alpha = gdk_pixbuf_get_has_alpha(pixbuf);
+    const guchar *src = gdk_pixbuf_read_pixels(pixbuf);
+    
+    gsize stride = (gsize)width * 4;
+    gsize length = sizeof(CoverThumbnailHeader) + stride * height;
+    guchar *data = g_malloc(length);
+    
+    CoverThumbnailHeader *header = (CoverThumbnailHeader *)data;
+    header->magic = COVER_THUMBNAIL_MAGIC;
+    header->width = width;
+    header->height = height;
+    header->stride = stride;
+    
+    guchar *dst = data + sizeof(CoverThumbnailHeader);
+    for (gint y = 0; y < height; y++) {
+        const guchar *in = src + (gsize)y * src_stride;
+        guchar *out = dst + (gsize)y * stride;
+        for (gint x = 0; x < width; x++, in += channels, out += 4) {
+            guint alpha = has_alpha ? in[3] : 0xFF;
+            out[0] = (in[0] * alpha + 127) / 255;
+            out[1] = (in[1] * alpha + 127) / 255;
+            out[2] = (in[2] * alpha + 127) / 255;
+            out[3] = alpha;
+        }
+    }
+    
+    return g_bytes_new_take(data, length);
+}
+
+/* Store pixbuf as the size thumbnail of source_path and return it as a texture */
+static GdkTexture* coverart_write_thumbnail(CoverArtManager *manager, const gchar *source_path,
+                                            GdkPixbuf *pixbuf, gint size) {
+    GdkPixbuf *scaled = coverart_scale_to_fit(pixbuf, size);
+    GBytes *data = coverart_thumbnail_encode(scaled);
+    g_object_unref(scaled);
+    coverart_thumbnail_sizes_add(manager, source_path, size);
+    
+    if (manager->pack) {
+        gchar *key = coverart_thumbnail_key(source_path, size);
+        coverpack_store(manager->pack, key, data);
         g_free(key);
-        return cached;
+        
+        GdkTexture *texture = coverart_thumbnail_decode(data);
+        g_bytes_unref(data);
+        return texture;
     }
-    g_mutex_unlock(&manager->cache_mutex);
     
-    gchar *path = coverart_get_cache_path(manager, artist, album);
-    GdkPixbuf *pixbuf = NULL;
+    gchar *path = coverart_thumbnail_path(manager, source_path, size);
+    gchar *dir = g_path_get_dirname(path);
+    g_mkdir_with_parents(dir, 0755);
     
-    if (g_file_test(path, G_FILE_TEST_EXISTS)) {
+    gsize length = 0;
+    const gchar *contents = g_bytes_get_data(data, &length);
+    GError *error = NULL;
+    if (!g_file_set_contents(path, contents, length, &error)) {
+        g_warning("Failed to write cover thumbnail: %s", error->message);
+        g_error_free(error);
+    }
+    
+    GdkTexture *texture = coverart_thumbnail_decode(data);
+    g_bytes_unref(data);
+    g_free(dir);
+    g_free(path);
+    return texture;
+}
+
+/* Stored thumbnail of the art at source_path, NULL if there is none yet */
+static GdkTexture* coverart_read_thumbnail(CoverArtManager *manager, const gchar *source_path, gint size) {
+    GdkTexture *texture = NULL;
+    gchar *key = NULL;
+    
+    if (manager->pack) {
+        /* Straight out of the mapping, no copy */
+        key = coverart_thumbnail_key(source_path, size);
+        GBytes *data = coverpack_lookup(manager->pack, key);
+        if (data) {
+            texture = coverart_thumbnail_decode(data);
+            g_bytes_unref(data);
+        }
+    }
+    
+    if (!texture) {
+        gchar *path = coverart_thumbnail_path(manager, source_path, size);
+        gchar *contents = NULL;
+        gsize length = 0;
+        
+        if (g_file_get_contents(path, &contents, &length, NULL)) {
+            GBytes *data = g_bytes_new_take(contents, length);
+            texture = coverart_thumbnail_decode(data);
+            /* Thumbnail from before the pack was enabled: move it in */
+            if (texture && manager->pack && coverpack_store(manager->pack, key, data)) {
+                g_unlink(path);
+            }
+            g_bytes_unref(data);
+        }
+        g_free(path);
+    }
+    g_free(key);
+    
+    return texture;
+}
+
+/* Texture for the art stored at source_path: the thumbnail if one exists,
+ * otherwise decoded from the source once and thumbnailed for next time */
+static GdkTexture* coverart_load_thumbnail(CoverArtManager *manager, const gchar *source_path, gint size) {
+    GdkTexture *texture = coverart_read_thumbnail(manager, source_path, size);
+    
+    if (!texture && g_file_test(source_path, G_FILE_TEST_EXISTS)) {
         GError *error = NULL;
-        pixbuf = gdk_pixbuf_new_from_file_at_scale(path, size, size, TRUE, &error);
+        GdkPixbuf *pixbuf = gdk_pixbuf_new_from_file_at_scale(source_path, size, size, TRUE, &error);
         if (error) {
             g_warning("Failed to load cover art: %s", error->message);
             g_error_free(error);
         } else {
-            g_mutex_lock(&manager->cache_mutex);
-            g_hash_table_insert(manager->cache, g_strdup(key), g_object_ref(pixbuf));
-            g_mutex_unlock(&manager->cache_mutex);
+            texture = coverart_write_thumbnail(manager, source_path, pixbuf, size);
+            g_object_unref(pixbuf);
+        }
+    }
+    
+    return texture;
+}
+
+/* Drop every thumbnail of replaced art. They are remade from the new
+ * original by whichever fetch worker needs them first. */
+static void coverart_invalidate_thumbnails(CoverArtManager *manager, const gchar *source_path,
+                                           const gchar *base_key) {
+    /* Every size made so far, not just the standard ones: widgets ask for their own */
+    gchar *name = g_path_get_basename(source_path);
+    g_mutex_lock(&manager->thumbnail_mutex);
+    coverart_thumbnail_sizes_load_locked(manager);
+    gchar *stored_name = NULL;
+    GArray *sizes = NULL;
+    g_hash_table_steal_extended(manager->thumbnail_sizes, name, (gpointer *)&stored_name, (gpointer *)&sizes);
+    g_mutex_unlock(&manager->thumbnail_mutex);
+    
+    for (guint i = 0; sizes && i < sizes->len; i++) {
+        gint size = g_array_index(sizes, gint, i);
+        if (manager->pack) {
+            gchar *key = coverart_thumbnail_key(source_path, size);
+            coverpack_remove(manager->pack, key);
+            g_free(key);
         }
+        gchar *path = coverart_thumbnail_path(manager, source_path, size);
+        g_unlink(path);
+        g_free(path);
+    }
+    
+    if (sizes) g_array_unref(sizes);
+    g_free(stored_name);
+    g_free(name);
+    
+    gchar *prefix = g_strconcat(base_key, "@", NULL);
+    coverart_cache_remove_prefix(manager, prefix);
+    g_free(prefix);
+}
+
+/* Write image bytes to path exactly as found in the tag, cover file or
+ * download. Anything gdk-pixbuf recognises is kept; only the header is
+ * checked, nothing is decoded or re-encoded. */
+static gboolean coverart_store_original(const gchar *path, const guchar *data, gsize length) {
+    gchar *tmp_path = g_strconcat(path, ".new", NULL);
+    GError *error = NULL;
+    
+    if (!g_file_set_contents(tmp_path, (const gchar *)data, length, &error)) {
+        g_warning("Failed to save cover art: %s", error->message);
+        g_error_free(error);
+        g_free(tmp_path);
+        return FALSE;
+    }
+    
+    gboolean success = gdk_pixbuf_get_file_info(tmp_path, NULL, NULL) != NULL &&
+                       g_rename(tmp_path, path) == 0;
+    if (!success) {
+        g_unlink(tmp_path);
     }
     
+    g_free(tmp_path);
+    return success;
+}
+
+GdkTexture* coverart_get(CoverArtManager *manager, const gchar *artist, const gchar *album, gint size) {
+    if (!manager) return NULL;
+    
+    /* Include size in cache key so different sizes are cached separately */
+    gchar *base_key = coverart_generate_cache_key(artist, album);
+    gchar *key = g_strdup_printf("%s@%d", base_key, size);
+    g_free(base_key);
+    
+    gboolean claimed;
+    GdkTexture *cached = coverart_cache_lookup_or_claim(manager, key, &claimed);
+    if (!claimed) {
+        g_free(key);
+        return cached;
+    }
+    
+    gchar *path = coverart_get_cache_path(manager, artist, album);
+    GdkTexture *texture = coverart_load_thumbnail(manager, path, size);
+    
+    coverart_cache_finish_load(manager, key, texture);
     g_free(key);
     g_free(path);
-    return pixbuf;
+    return texture;
 }
 
 GdkPixbuf* coverart_get_from_file(const gchar *file_path, gint size) {
@@ -123,21 +709,20 @@ GdkPixbuf* coverart_get_from_file(const gchar *file_path, gint size) {
     return pixbuf;
 }
 
-/* Extract album art from audio file tags */
-GdkPixbuf* coverart_extract_from_audio(const gchar *audio_file_path, gint size) {
-    if (!audio_file_path) return NULL;
-    
-    GstDiscoverer *discoverer = NULL;
-    GstDiscovererInfo *info = NULL;
-    GdkPixbuf *pixbuf = NULL;
-    GError *error = NULL;
+/* Discoverers are expensive to build, so each thread that extracts art
+ * (fetch pool workers, the import loop) keeps one and reuses it */
+static GPrivate coverart_discoverer = G_PRIVATE_INIT((GDestroyNotify)g_object_unref);
+
+static GstDiscoverer* coverart_get_thread_discoverer(void) {
+    GstDiscoverer *discoverer = g_private_get(&coverart_discoverer);
+    if (discoverer) return discoverer;
     
-    /* Initialize GStreamer if not already done */
+    /* Only reached once per thread, so this isn't checked per file */
     if (!gst_is_initialized()) {
         gst_init(NULL, NULL);
     }
     
-    /* Create discoverer */
+    GError *error = NULL;
     discoverer = gst_discoverer_new(5 * GST_SECOND, &error);
     if (error) {
         g_warning("Failed to create discoverer: %s", error->message);
@@ -145,12 +730,26 @@ GdkPixbuf* coverart_extract_from_audio(const gchar *audio_file_path, gint size)
         return NULL;
     }
     
+    g_private_set(&coverart_discoverer, discoverer);
+    return discoverer;
+}
+
+/* Raw bytes of the image embedded in the file's tags */
+GBytes* coverart_extract_data_from_audio(const gchar *audio_file_path) {
+    if (!audio_file_path) return NULL;
+    
+    GstDiscovererInfo *info = NULL;
+    GBytes *data = NULL;
+    GError *error = NULL;
+    
+    GstDiscoverer *discoverer = coverart_get_thread_discoverer();
+    if (!discoverer) return NULL;
+    
     /* Build URI from file path */
     gchar *uri = g_filename_to_uri(audio_file_path, NULL, &error);
     if (error) {
         g_warning("Failed to convert path to URI: %s", error->message);
         g_error_free(error);
-        g_object_unref(discoverer);
         return NULL;
     }
     
@@ -159,8 +758,8 @@ GdkPixbuf* coverart_extract_from_audio(const gchar *audio_file_path, gint size)
     if (error) {
         g_warning("Failed to discover file %s: %s", audio_file_path, error->message);
         g_error_free(error);
+        if (info) gst_discoverer_info_unref(info);
         g_free(uri);
-        g_object_unref(discoverer);
         return NULL;
     }
     
@@ -177,20 +776,10 @@ GdkPixbuf* coverart_extract_from_audio(const gchar *audio_file_path, gint size)
             if (buffer) {
                 GstMapInfo map;
                 if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
-                    /* Create pixbuf from image data */
-                    GInputStream *stream = g_memory_input_stream_new_from_data(
-                        g_memdup2(map.data, map.size), map.size, g_free);
-                    
-                    GError *pixbuf_error = NULL;
-                    pixbuf = gdk_pixbuf_new_from_stream_at_scale(stream, size, size, TRUE, NULL, &pixbuf_error);
-                    
-                    if (pixbuf_error) {
-                        g_warning("Failed to create pixbuf from image data: %s", pixbuf_error->message);
-                        g_error_free(pixbuf_error);
+                    if (map.size > 0) {
+                        data = g_bytes_new(map.data, map.size);
                     }
-                    
                     gst_buffer_unmap(buffer, &map);
-                    g_object_unref(stream);
                 }
             }
             
@@ -201,72 +790,128 @@ GdkPixbuf* coverart_extract_from_audio(const gchar *audio_file_path, gint size)
     /* Cleanup */
     gst_discoverer_info_unref(info);
     g_free(uri);
-    g_object_unref(discoverer);
     
-    return pixbuf;
+    return data;
 }
 
-/* Search for cover art in the same directory as the audio file */
-GdkPixbuf* coverart_search_directory(const gchar *audio_file_path, gint size) {
-    if (!audio_file_path) return NULL;
+/* Extract album art from audio file tags */
+GdkPixbuf* coverart_extract_from_audio(const gchar *audio_file_path, gint size) {
+    GBytes *data = coverart_extract_data_from_audio(audio_file_path);
+    if (!data) return NULL;
     
-    gchar *dir_path = g_path_get_dirname(audio_file_path);
-    GDir *dir = g_dir_open(dir_path, 0, NULL);
+    GInputStream *stream = g_memory_input_stream_new_from_bytes(data);
+    GError *error = NULL;
+    GdkPixbuf *pixbuf = gdk_pixbuf_new_from_stream_at_scale(stream, size, size, TRUE, NULL, &error);
     
-    if (!dir) {
-        g_free(dir_path);
-        return NULL;
+    if (error) {
+        g_warning("Failed to create pixbuf from image data: %s", error->message);
+        g_error_free(error);
     }
     
-    /* Common cover art filenames */
-    const gchar *cover_names[] = {
-        "cover.jpg", "cover.png", "Cover.jpg", "Cover.png",
-        "folder.jpg", "folder.png", "Folder.jpg", "Folder.png",
-        "album.jpg", "album.png", "Album.jpg", "Album.png",
-        "front.jpg", "front.png", "Front.jpg", "Front.png",
-        NULL
-    };
-    
-    GdkPixbuf *pixbuf = NULL;
-    
-    /* First try common names */
-    for (int i = 0; cover_names[i] != NULL; i++) {
-        gchar *cover_path = g_build_filename(dir_path, cover_names[i], NULL);
-        if (g_file_test(cover_path, G_FILE_TEST_EXISTS)) {
-            pixbuf = coverart_get_from_file(cover_path, size);
-            g_free(cover_path);
-            if (pixbuf) break;
-        }
-        g_free(cover_path);
-    }
-    
-    /* If not found, search for any jpg/png file */
-    if (!pixbuf) {
-        const gchar *filename;
-        while ((filename = g_dir_read_name(dir)) != NULL) {
-            gchar *lower = g_ascii_strdown(filename, -1);
-            if (g_str_has_suffix(lower, ".jpg") || 
-                g_str_has_suffix(lower, ".jpeg") || 
-                g_str_has_suffix(lower, ".png")) {
-                gchar *cover_path = g_build_filename(dir_path, filename, NULL);
-                pixbuf = coverart_get_from_file(cover_path, size);
-                g_free(cover_path);
-                if (pixbuf) {
-                    g_free(lower);
-                    break;
-                }
-            }
-            g_free(lower);
+    g_object_unref(stream);
+    g_bytes_unref(data);
+    return pixbuf;
+}
+
+/* Common cover art names, most preferred first; matched ignoring case and extension */
+static const gchar *cover_names[] = { "cover", "folder", "album", "front", NULL };
+
+static gint coverart_image_rank(const gchar *path) {
+    gchar *name = g_path_get_basename(path);
+    gchar *dot = strrchr(name, '.');
+    if (dot) *dot = '\0';
+    
+    gint rank = 0;
+    while (cover_names[rank] && g_ascii_strcasecmp(name, cover_names[rank]) != 0) {
+        rank++;
+    }
+    g_free(name);
+    return rank;
+}
+
+static gint coverart_image_compare(gconstpointer a, gconstpointer b) {
+    const gchar *x = *(const gchar * const *)a;
+    const gchar *y = *(const gchar * const *)b;
+    gint rank_x = coverart_image_rank(x);
+    gint rank_y = coverart_image_rank(y);
+    
+    if (rank_x != rank_y) return rank_x - rank_y;
+    return strcmp(x, y);
+}
+
+/* Image files in dir_path, common cover names first. One listing replaces
+ * testing each common name separately. */
+static GPtrArray* coverart_list_directory_images(const gchar *dir_path) {
+    GPtrArray *images = g_ptr_array_new_with_free_func(g_free);
+    GDir *dir = g_dir_open(dir_path, 0, NULL);
+    if (!dir) return images;
+    
+    const gchar *filename;
+    while ((filename = g_dir_read_name(dir)) != NULL) {
+        gchar *lower = g_ascii_strdown(filename, -1);
+        if (g_str_has_suffix(lower, ".jpg") ||
+            g_str_has_suffix(lower, ".jpeg") ||
+            g_str_has_suffix(lower, ".png")) {
+            g_ptr_array_add(images, g_build_filename(dir_path, filename, NULL));
         }
+        g_free(lower);
     }
-    
     g_dir_close(dir);
+    
+    g_ptr_array_sort(images, coverart_image_compare);
+    return images;
+}
+
+/* First image in the list that loads */
+static GdkPixbuf* coverart_load_first_image(GPtrArray *images, gint size) {
+    for (guint i = 0; i < images->len; i++) {
+        GdkPixbuf *pixbuf = coverart_get_from_file(g_ptr_array_index(images, i), size);
+        if (pixbuf) return pixbuf;
+    }
+    return NULL;
+}
+
+/* Search for cover art in the same directory as the audio file */
+GdkPixbuf* coverart_search_directory(const gchar *audio_file_path, gint size) {
+    if (!audio_file_path) return NULL;
+    
+    gchar *dir_path = g_path_get_dirname(audio_file_path);
+    GPtrArray *images = coverart_list_directory_images(dir_path);
+    GdkPixbuf *pixbuf = coverart_load_first_image(images, size);
+    
+    g_ptr_array_unref(images);
     g_free(dir_path);
     
     return pixbuf;
 }
 
 /* Extract or find album art for a track and cache it */
+/* Cache the art embedded in the audio file, or else the first usable image
+ * beside it, storing the original bytes */
+static gboolean coverart_cache_from_sources(CoverArtManager *manager, const gchar *audio_file_path,
+                                            const gchar *artist, const gchar *album,
+                                            GPtrArray *images) {
+    GBytes *data = coverart_extract_data_from_audio(audio_file_path);
+    if (data) {
+        gboolean success = coverart_save_data(manager, artist, album, data);
+        g_bytes_unref(data);
+        if (success) return TRUE;
+    }
+    
+    for (guint i = 0; i < images->len; i++) {
+        gchar *contents = NULL;
+        gsize length = 0;
+        if (!g_file_get_contents(g_ptr_array_index(images, i), &contents, &length, NULL)) continue;
+        
+        data = g_bytes_new_take(contents, length);
+        gboolean success = coverart_save_data(manager, artist, album, data);
+        g_bytes_unref(data);
+        if (success) return TRUE;
+    }
+    
+    return FALSE;
+}
+
 gboolean coverart_extract_and_cache(CoverArtManager *manager, const gchar *audio_file_path,
                                     const gchar *artist, const gchar *album) {
     if (!manager || !audio_file_path) return FALSE;
@@ -276,42 +921,152 @@ gboolean coverart_extract_and_cache(CoverArtManager *manager, const gchar *audio
         return TRUE;
     }
     
-    GdkPixbuf *pixbuf = NULL;
-    
-    /* First try to extract from the audio file itself */
-    pixbuf = coverart_extract_from_audio(audio_file_path, COVER_ART_SIZE_LARGE);
+    gchar *dir_path = g_path_get_dirname(audio_file_path);
+    GPtrArray *images = coverart_list_directory_images(dir_path);
+    gboolean success = coverart_cache_from_sources(manager, audio_file_path, artist, album, images);
     
-    /* If not found, search in the directory */
-    if (!pixbuf) {
-        pixbuf = coverart_search_directory(audio_file_path, COVER_ART_SIZE_LARGE);
+    g_ptr_array_unref(images);
+    g_free(dir_path);
+    return success;
+}
+
+/* Most common colour of an image, as opaque RGBA. Colours are bucketed at
+ * two bits per channel and the winning bucket averaged, so a cover that is
+ * mostly one hue gives that hue rather than a grey mean of everything. */
+static guint32 coverart_dominant_color(GdkPixbuf *pixbuf) {
+    gint width = gdk_pixbuf_get_width(pixbuf);
+    gint height = gdk_pixbuf_get_height(pixbuf);
+    gint channels = gdk_pixbuf_get_n_channels(pixbuf);
+    gint stride = gdk_pixbuf_get_rowstride(pixbuf);
+    const guchar *pixels = gdk_pixbuf_read_pixels(pixbuf);
+    
+    guint counts[64] = { 0 };
+    guint sums[64][3] = { { 0 } };
+    
+    for (gint y = 0; y < height; y++) {
+        const guchar *p = pixels + (gsize)y * stride;
+        for (gint x = 0; x < width; x++, p += channels) {
+            guint bucket = ((p[0] >> 6) << 4) | ((p[1] >> 6) << 2) | (p[2] >> 6);
+            counts[bucket]++;
+            sums[bucket][0] += p[0];
+            sums[bucket][1] += p[1];
+            sums[bucket][2] += p[2];
+        }
     }
     
-    /* Cache if found */
-    if (pixbuf) {
-        gboolean success = coverart_save(manager, artist, album, pixbuf);
-        g_object_unref(pixbuf);
-        return success;
+    guint best = 0;
+    for (guint i = 1; i < G_N_ELEMENTS(counts); i++) {
+        if (counts[i] > counts[best]) best = i;
     }
+    if (counts[best] == 0) return 0;
     
-    return FALSE;
+    return (sums[best][0] / counts[best]) << 24 |
+           (sums[best][1] / counts[best]) << 16 |
+           (sums[best][2] / counts[best]) << 8 | 0xFF;
 }
 
-gboolean coverart_save(CoverArtManager *manager, const gchar *artist, const gchar *album, GdkPixbuf *pixbuf) {
-    if (!manager || !pixbuf) return FALSE;
+guint32 coverart_get_dominant_color(CoverArtManager *manager, const gchar *artist, const gchar *album) {
+    if (!manager) return 0;
     
+    /* A tiny decode is plenty; JPEG scales down while decoding */
     gchar *path = coverart_get_cache_path(manager, artist, album);
-    GError *error = NULL;
+    GdkPixbuf *pixbuf = gdk_pixbuf_new_from_file_at_scale(path, COVER_ART_COLOR_SAMPLE,
+                                                          COVER_ART_COLOR_SAMPLE, FALSE, NULL);
+    g_free(path);
+    if (!pixbuf) return 0;
     
-    gboolean success = gdk_pixbuf_save(pixbuf, path, "jpeg", &error, "quality", "90", NULL);
+    guint32 color = coverart_dominant_color(pixbuf);
+    g_object_unref(pixbuf);
+    return color;
+}
+
+/* Store the album's colour. Art that was just stored always replaces the
+ * old colour; otherwise only a missing one is filled in. */
+static void coverart_record_color(CoverArtManager *manager, Database *database,
+                                  const gchar *artist, const gchar *album, gboolean replaced) {
+    if (!database) return;
+    if (!replaced && database_get_album_color(database, artist, album) != 0) return;
+    
+    /* 0 if the new art can't be sampled, so an old colour never outlives its art */
+    guint32 color = coverart_get_dominant_color(manager, artist, album);
+    if (color != 0 || replaced) {
+        database_set_album_color(database, artist, album, color);
+    }
+}
+
+struct CoverArtScan {
+    CoverArtManager *manager;
+    Database *database;       /* Receives album colours, may be NULL */
+    GHashTable *resolved;     /* Directory + album key -> GINT_TO_POINTER(found + 1) */
+    GHashTable *dir_images;   /* Directory -> GPtrArray of image paths */
+};
+
+CoverArtScan* coverart_scan_new(CoverArtManager *manager, Database *database) {
+    CoverArtScan *scan = g_new0(CoverArtScan, 1);
+    scan->manager = manager;
+    scan->database = database;
+    scan->resolved = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    scan->dir_images = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                             (GDestroyNotify)g_ptr_array_unref);
+    return scan;
+}
+
+void coverart_scan_free(CoverArtScan *scan) {
+    if (!scan) return;
+    g_hash_table_destroy(scan->resolved);
+    g_hash_table_destroy(scan->dir_images);
+    g_free(scan);
+}
+
+gboolean coverart_scan_resolve(CoverArtScan *scan, const gchar *audio_file_path,
+                               const gchar *artist, const gchar *album) {
+    if (!scan || !scan->manager || !audio_file_path) return FALSE;
     
-    if (error) {
-        g_warning("Failed to save cover art: %s", error->message);
-        g_error_free(error);
-    } else {
+    gchar *dir_path = g_path_get_dirname(audio_file_path);
+    gchar *key = g_strdup_printf("%s\x1f%s\x1f%s", dir_path,
+                                 artist ? artist : "", album ? album : "");
+    
+    /* Earlier track of the same album in this directory, found or not */
+    gpointer known = g_hash_table_lookup(scan->resolved, key);
+    if (known) {
+        g_free(key);
+        g_free(dir_path);
+        return GPOINTER_TO_INT(known) - 1;
+    }
+    
+    gboolean existed = coverart_exists(scan->manager, artist, album);
+    gboolean found = existed;
+    if (!found) {
+        GPtrArray *images = g_hash_table_lookup(scan->dir_images, dir_path);
+        if (!images) {
+            images = coverart_list_directory_images(dir_path);
+            g_hash_table_insert(scan->dir_images, g_strdup(dir_path), images);
+        }
+        found = coverart_cache_from_sources(scan->manager, audio_file_path, artist, album, images);
+    }
+    
+    if (found) {
+        coverart_record_color(scan->manager, scan->database, artist, album, !existed);
+    }
+    
+    g_hash_table_insert(scan->resolved, key, GINT_TO_POINTER(found + 1));
+    g_free(dir_path);
+    return found;
+}
+
+gboolean coverart_save_data(CoverArtManager *manager, const gchar *artist, const gchar *album, GBytes *data) {
+    if (!manager || !data) return FALSE;
+    
+    gchar *path = coverart_get_cache_path(manager, artist, album);
+    gsize length = 0;
+    const guchar *bytes = g_bytes_get_data(data, &length);
+    
+    gboolean success = length > 0 && coverart_store_original(path, bytes, length);
+    if (success) {
         gchar *key = coverart_generate_cache_key(artist, album);
-        g_mutex_lock(&manager->cache_mutex);
-        g_hash_table_insert(manager->cache, key, g_object_ref(pixbuf));
-        g_mutex_unlock(&manager->cache_mutex);
+        coverart_invalidate_thumbnails(manager, path, key);
+        coverart_clear_missing(manager, key);
+        g_free(key);
     }
     
     g_free(path);
@@ -324,48 +1079,94 @@ typedef struct {
     gchar *artist;
     gchar *album;
     gint size;
+    gint priority;
+    guint sequence;
+    GCancellable *cancellable;
     CoverArtFetchCallback callback;
     gpointer user_data;
 } FetchData;
 
 typedef struct {
     CoverArtFetchCallback callback;
-    GdkPixbuf *pixbuf;
+    GdkTexture *texture;
     gpointer user_data;
+    GCancellable *cancellable;
 } CallbackData;
 
 static gboolean invoke_callback_in_main(gpointer data) {
     CallbackData *cb_data = (CallbackData *)data;
+    
+    /* Cancelled while the result was on its way: the caller no longer wants it */
+    if (cb_data->texture && cb_data->cancellable && g_cancellable_is_cancelled(cb_data->cancellable)) {
+        g_clear_object(&cb_data->texture);
+    }
+    
     if (cb_data->callback) {
-        cb_data->callback(cb_data->pixbuf, cb_data->user_data);
+        cb_data->callback(cb_data->texture, cb_data->user_data);
     }
-    if (cb_data->pixbuf) {
-        g_object_unref(cb_data->pixbuf);
+    if (cb_data->texture) {
+        g_object_unref(cb_data->texture);
     }
+    g_clear_object(&cb_data->cancellable);
     g_free(cb_data);
     return G_SOURCE_REMOVE;
 }
 
+/* Lower priority values first; within a priority the newest request wins,
+ * since while scrolling the items bound last are the ones on screen */
+static gint coverart_fetch_compare(gconstpointer a, gconstpointer b, gpointer user_data) {
+    const FetchData *x = (const FetchData *)a;
+    const FetchData *y = (const FetchData *)b;
+    (void)user_data;
+    
+    if (x->priority != y->priority) {
+        return x->priority < y->priority ? -1 : 1;
+    }
+    return (y->sequence > x->sequence) - (y->sequence < x->sequence);
+}
+
 /* Thread pool function for fetching cover art */
 static void coverart_fetch_pool_func(gpointer data, gpointer user_data) {
     FetchData *fetch = (FetchData *)data;
     (void)user_data;  /* Manager passed via FetchData */
     
+    /* Dropped while queued, e.g. the item scrolled away or the artist changed */
+    if (fetch->cancellable && g_cancellable_is_cancelled(fetch->cancellable)) {
+        if (fetch->callback) {
+            CallbackData *cb_data = g_new0(CallbackData, 1);
+            cb_data->callback = fetch->callback;
+            cb_data->user_data = fetch->user_data;
+            g_main_context_invoke(NULL, invoke_callback_in_main, cb_data);
+        }
+        g_clear_object(&fetch->cancellable);
+        g_free(fetch->artist);
+        g_free(fetch->album);
+        g_free(fetch);
+        return;
+    }
+    
     g_debug("Fetching cover art for: %s - %s (size %d)", 
             fetch->artist ? fetch->artist : "Unknown",
             fetch->album ? fetch->album : "Unknown",
             fetch->size);
     
-    GdkPixbuf *pixbuf = coverart_get(fetch->manager, fetch->artist, fetch->album, fetch->size);
+    /* Albums that had no art a moment ago aren't searched again on every scroll */
+    gchar *album_key = coverart_generate_cache_key(fetch->artist, fetch->album);
+    gboolean known_missing = coverart_is_missing(fetch->manager, album_key);
+    GdkTexture *texture = NULL;
     
-    if (pixbuf) {
+    if (!known_missing) {
+        texture = coverart_get(fetch->manager, fetch->artist, fetch->album, fetch->size);
+    }
+    
+    if (texture) {
         g_debug("Found cover art in cache for: %s - %s", 
                 fetch->artist ? fetch->artist : "Unknown",
                 fetch->album ? fetch->album : "Unknown");
     }
     
     /* If not in cache, try to extract from audio file */
-    if (!pixbuf && fetch->database) {
+    if (!texture && !known_missing && fetch->database) {
         g_debug("Trying to extract from audio file for: %s - %s", 
                 fetch->artist ? fetch->artist : "Unknown",
                 fetch->album ? fetch->album : "Unknown");
@@ -378,9 +1179,12 @@ static void coverart_fetch_pool_func(gpointer data, gpointer user_data) {
                 /* Try to extract and cache */
                 if (coverart_extract_and_cache(fetch->manager, track->file_path, 
                                                fetch->artist, fetch->album)) {
+                    coverart_record_color(fetch->manager, fetch->database,
+                                          fetch->artist, fetch->album, TRUE);
+                    
                     /* Now try to get it from cache */
-                    pixbuf = coverart_get(fetch->manager, fetch->artist, fetch->album, fetch->size);
-                    if (pixbuf) {
+                    texture = coverart_get(fetch->manager, fetch->artist, fetch->album, fetch->size);
+                    if (texture) {
                         g_debug("Successfully extracted cover art from: %s", track->file_path);
                     }
                 } else {
@@ -393,28 +1197,35 @@ static void coverart_fetch_pool_func(gpointer data, gpointer user_data) {
                     fetch->artist ? fetch->artist : "Unknown",
                     fetch->album ? fetch->album : "Unknown");
         }
-    } else if (!pixbuf) {
+        
+        if (!texture) {
+            coverart_mark_missing(fetch->manager, album_key);
+        }
+    } else if (!texture && !known_missing) {
         g_debug("No database available to look up tracks");
     }
+    g_free(album_key);
     
-    if (!pixbuf) {
-        g_debug("Creating default gray cover for: %s - %s", 
+    if (!texture) {
+        g_debug("Using placeholder cover for: %s - %s", 
                 fetch->artist ? fetch->artist : "Unknown",
                 fetch->album ? fetch->album : "Unknown");
-        pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, fetch->size, fetch->size);
-        gdk_pixbuf_fill(pixbuf, 0x333333FF);
+        texture = coverart_manager_get_placeholder(fetch->manager, fetch->size);
     }
     
-    if (fetch->callback && pixbuf) {
+    if (fetch->callback && texture) {
         CallbackData *cb_data = g_new0(CallbackData, 1);
         cb_data->callback = fetch->callback;
-        cb_data->pixbuf = pixbuf;  /* Transfer ownership */
+        cb_data->texture = texture;  /* Transfer ownership */
         cb_data->user_data = fetch->user_data;
+        cb_data->cancellable = fetch->cancellable;  /* Transfer ownership */
+        fetch->cancellable = NULL;
         g_main_context_invoke(NULL, invoke_callback_in_main, cb_data);
-    } else if (pixbuf) {
-        g_object_unref(pixbuf);
+    } else if (texture) {
+        g_object_unref(texture);
     }
     
+    g_clear_object(&fetch->cancellable);
     g_free(fetch->artist);
     g_free(fetch->album);
     g_free(fetch);
@@ -428,6 +1239,14 @@ void coverart_fetch_async(CoverArtManager *manager, const gchar *artist, const g
 void coverart_fetch_async_with_db(CoverArtManager *manager, Database *database,
                                   const gchar *artist, const gchar *album,
                                   gint size, CoverArtFetchCallback callback, gpointer user_data) {
+    coverart_fetch_album_async(manager, database, artist, album, size,
+                               G_PRIORITY_DEFAULT, NULL, callback, user_data);
+}
+
+void coverart_fetch_album_async(CoverArtManager *manager, Database *database,
+                                const gchar *artist, const gchar *album, gint size,
+                                gint priority, GCancellable *cancellable,
+                                CoverArtFetchCallback callback, gpointer user_data) {
     if (!manager || !manager->fetch_pool) return;
     
     FetchData *fetch = g_new0(FetchData, 1);
@@ -436,6 +1255,9 @@ void coverart_fetch_async_with_db(CoverArtManager *manager, Database *database,
     fetch->artist = g_strdup(artist);
     fetch->album = g_strdup(album);
     fetch->size = size;
+    fetch->priority = priority;
+    fetch->sequence = (guint)g_atomic_int_add((gint *)&manager->fetch_sequence, 1);
+    fetch->cancellable = cancellable ? g_object_ref(cancellable) : NULL;
     fetch->callback = callback;
     fetch->user_data = user_data;
     
@@ -444,6 +1266,13 @@ void coverart_fetch_async_with_db(CoverArtManager *manager, Database *database,
     if (error) {
         g_warning("Failed to push cover art fetch to pool: %s", error->message);
         g_error_free(error);
+        if (callback) {
+            CallbackData *cb_data = g_new0(CallbackData, 1);
+            cb_data->callback = callback;
+            cb_data->user_data = user_data;
+            g_main_context_invoke(NULL, invoke_callback_in_main, cb_data);
+        }
+        g_clear_object(&fetch->cancellable);
         g_free(fetch->artist);
         g_free(fetch->album);
         g_free(fetch);
@@ -461,134 +1290,163 @@ gchar* coverart_get_url_cache_path(CoverArtManager *manager, const gchar *url) {
     return path;
 }
 
-gboolean coverart_cache_url_image(CoverArtManager *manager, const gchar *url, GdkPixbuf *pixbuf) {
-    if (!manager || !url || !pixbuf) return FALSE;
-    
-    gchar *path = coverart_get_url_cache_path(manager, url);
-    GError *error = NULL;
-    
-    gboolean success = gdk_pixbuf_save(pixbuf, path, "jpeg", &error, "quality", "90", NULL);
-    
-    if (error) {
-        g_warning("Failed to cache URL image: %s", error->message);
-        g_error_free(error);
-    } else {
-        g_mutex_lock(&manager->cache_mutex);
-        g_hash_table_insert(manager->cache, g_strdup(url), g_object_ref(pixbuf));
-        g_mutex_unlock(&manager->cache_mutex);
-    }
-    
-    g_free(path);
-    return success;
-}
-
 /* Forward declaration for external fetch_binary_url function from podcast.c */
 extern gchar* fetch_binary_url(const gchar *url, gsize *out_size);
 
-GdkPixbuf* coverart_get_from_url(CoverArtManager *manager, const gchar *url, gint size) {
+GdkTexture* coverart_get_from_url(CoverArtManager *manager, const gchar *url, gint size) {
     if (!manager || !url) return NULL;
     
     /* Check memory cache first */
-    g_mutex_lock(&manager->cache_mutex);
-    GdkPixbuf *cached = g_hash_table_lookup(manager->cache, url);
-    if (cached) {
-        g_object_ref(cached);
-        g_mutex_unlock(&manager->cache_mutex);
+    gchar *key = g_strdup_printf("%s@%d", url, size);
+    gboolean claimed;
+    GdkTexture *cached = coverart_cache_lookup_or_claim(manager, key, &claimed);
+    if (!claimed) {
+        g_free(key);
         return cached;
     }
-    g_mutex_unlock(&manager->cache_mutex);
     
     /* Check disk cache */
     gchar *cache_path = coverart_get_url_cache_path(manager, url);
-    GdkPixbuf *pixbuf = NULL;
+    GdkTexture *texture = coverart_load_thumbnail(manager, cache_path, size);
     
-    if (g_file_test(cache_path, G_FILE_TEST_EXISTS)) {
-        GError *error = NULL;
-        pixbuf = gdk_pixbuf_new_from_file_at_scale(cache_path, size, size, TRUE, &error);
-        if (error) {
-            g_warning("Failed to load cached image: %s", error->message);
-            g_error_free(error);
-        } else {
-            g_mutex_lock(&manager->cache_mutex);
-            g_hash_table_insert(manager->cache, g_strdup(url), g_object_ref(pixbuf));
-            g_mutex_unlock(&manager->cache_mutex);
-        }
+    if (texture || g_file_test(cache_path, G_FILE_TEST_EXISTS)) {
+        coverart_cache_finish_load(manager, key, texture);
+        g_free(key);
         g_free(cache_path);
-        return pixbuf;
+        return texture;
     }
     
     /* Download image from URL */
     gsize data_size = 0;
     gchar *image_data = fetch_binary_url(url, &data_size);
     if (image_data && data_size > 0) {
-        GInputStream *stream = g_memory_input_stream_new_from_data(
-            image_data, data_size, g_free);
+        GBytes *data = g_bytes_new_take(image_data, data_size);
+        GInputStream *stream = g_memory_input_stream_new_from_bytes(data);
         
         GError *error = NULL;
-        pixbuf = gdk_pixbuf_new_from_stream_at_scale(stream, size, size, TRUE, NULL, &error);
+        GdkPixbuf *pixbuf = gdk_pixbuf_new_from_stream_at_scale(stream, size, size, TRUE, NULL, &error);
         
         if (error) {
             g_warning("Failed to create pixbuf from URL data: %s", error->message);
             g_error_free(error);
         } else {
-            /* Cache the image */
-            coverart_cache_url_image(manager, url, pixbuf);
+            /* Keep the download as served; only the thumbnail is re-encoded */
+            coverart_store_original(cache_path, g_bytes_get_data(data, NULL), data_size);
+            texture = coverart_write_thumbnail(manager, cache_path, pixbuf, size);
+            g_object_unref(pixbuf);
         }
         
         g_object_unref(stream);
-        /* image_data freed by g_memory_input_stream_new_from_data */
+        g_bytes_unref(data);
+    } else {
+        g_free(image_data);
     }
     
+    coverart_cache_finish_load(manager, key, texture);
+    g_free(key);
     g_free(cache_path);
-    return pixbuf;
+    return texture;
 }
 
 typedef struct {
-    CoverArtManager *manager;
+    gchar *key;               /* Also the url_pending key */
     gchar *url;
     gint size;
-    CoverArtFetchCallback callback;
-    gpointer user_data;
 } URLFetchData;
 
-static gpointer coverart_fetch_url_thread(gpointer data) {
+/* Cover for url that can be had without the network: memory, then disk */
+static GdkTexture* coverart_get_cached_url(CoverArtManager *manager, const gchar *url,
+                                           const gchar *key, gint size) {
+    GdkTexture *texture = NULL;
+    
+    g_mutex_lock(&manager->cache_mutex);
+    texture = coverart_cache_peek_locked(manager, key);
+    g_mutex_unlock(&manager->cache_mutex);
+    if (texture) return texture;
+    
+    /* Only a stored thumbnail; decoding the original is left to the pool */
+    gchar *cache_path = coverart_get_url_cache_path(manager, url);
+    texture = coverart_read_thumbnail(manager, cache_path, size);
+    g_free(cache_path);
+    
+    if (texture) {
+        g_mutex_lock(&manager->cache_mutex);
+        coverart_cache_insert_locked(manager, key, texture);
+        g_mutex_unlock(&manager->cache_mutex);
+    }
+    return texture;
+}
+
+static void coverart_fetch_url_pool_func(gpointer data, gpointer user_data) {
     URLFetchData *fetch = (URLFetchData *)data;
+    CoverArtManager *manager = (CoverArtManager *)user_data;
     
-    GdkPixbuf *pixbuf = coverart_get_from_url(fetch->manager, fetch->url, fetch->size);
+    GdkTexture *texture = coverart_get_from_url(manager, fetch->url, fetch->size);
     
-    if (!pixbuf) {
-        pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, fetch->size, fetch->size);
-        gdk_pixbuf_fill(pixbuf, 0x333333FF);
+    if (!texture) {
+        coverart_mark_missing(manager, fetch->url);
+        texture = coverart_manager_get_placeholder(manager, fetch->size);
     }
     
-    if (fetch->callback && pixbuf) {
-        CallbackData *cb_data = g_new0(CallbackData, 1);
-        cb_data->callback = fetch->callback;
-        cb_data->pixbuf = pixbuf;  /* Transfer ownership */
-        cb_data->user_data = fetch->user_data;
+    /* Everyone who asked for this URL while it was downloading */
+    g_mutex_lock(&manager->url_mutex);
+    GPtrArray *waiters = NULL;
+    g_hash_table_steal_extended(manager->url_pending, fetch->key, NULL, (gpointer *)&waiters);
+    g_mutex_unlock(&manager->url_mutex);
+    
+    for (guint i = 0; waiters && i < waiters->len; i++) {
+        CallbackData *cb_data = g_ptr_array_index(waiters, i);
+        cb_data->texture = g_object_ref(texture);
         g_main_context_invoke(NULL, invoke_callback_in_main, cb_data);
-    } else if (pixbuf) {
-        g_object_unref(pixbuf);
     }
     
+    if (waiters) g_ptr_array_unref(waiters);
+    g_object_unref(texture);
+    g_free(fetch->key);
     g_free(fetch->url);
     g_free(fetch);
-    
-    return NULL;
 }
 
 void coverart_fetch_from_url_async(CoverArtManager *manager, const gchar *url,
                                    gint size, CoverArtFetchCallback callback, gpointer user_data) {
-    if (!manager || !url) return;
+    if (!manager || !url || !manager->url_pool) return;
+    
+    CallbackData *cb_data = g_new0(CallbackData, 1);
+    cb_data->callback = callback;
+    cb_data->user_data = user_data;
+    
+    /* Already downloaded, or recently failed: nothing to queue */
+    gchar *key = g_strdup_printf("%s@%d", url, size);
+    cb_data->texture = coverart_get_cached_url(manager, url, key, size);
+    if (!cb_data->texture && coverart_is_missing(manager, url)) {
+        cb_data->texture = coverart_manager_get_placeholder(manager, size);
+    }
+    if (cb_data->texture) {
+        g_main_context_invoke(NULL, invoke_callback_in_main, cb_data);
+        g_free(key);
+        return;
+    }
+    
+    /* Join a download of the same URL that is already queued or running */
+    g_mutex_lock(&manager->url_mutex);
+    GPtrArray *waiters = g_hash_table_lookup(manager->url_pending, key);
+    if (waiters) {
+        g_ptr_array_add(waiters, cb_data);
+        g_mutex_unlock(&manager->url_mutex);
+        g_free(key);
+        return;
+    }
+    
+    waiters = g_ptr_array_new();
+    g_ptr_array_add(waiters, cb_data);
+    g_hash_table_insert(manager->url_pending, g_strdup(key), waiters);
+    g_mutex_unlock(&manager->url_mutex);
     
     URLFetchData *fetch = g_new0(URLFetchData, 1);
-    fetch->manager = manager;
+    fetch->key = key;
     fetch->url = g_strdup(url);
     fetch->size = size;
-    fetch->callback = callback;
-    fetch->user_data = user_data;
-    
-    g_thread_new("coverart-url-fetch", coverart_fetch_url_thread, fetch);
+    g_thread_pool_push(manager->url_pool, fetch, NULL);
 }
 
 GtkWidget* coverart_widget_new(gint size) {
@@ -598,23 +1456,12 @@ GtkWidget* coverart_widget_new(gint size) {
     return image;
 }
 
-void coverart_widget_set_image(GtkWidget *widget, GdkPixbuf *pixbuf) {
+void coverart_widget_set_image(GtkWidget *widget, GdkTexture *texture) {
     if (!GTK_IS_IMAGE(widget)) return;
     
-    if (pixbuf) {
-        /* GTK4: Use GdkTexture instead of deprecated gtk_image_set_from_pixbuf */
-        GBytes *bytes = gdk_pixbuf_read_pixel_bytes(pixbuf);
-        int width = gdk_pixbuf_get_width(pixbuf);
-        int height = gdk_pixbuf_get_height(pixbuf);
-        int stride = gdk_pixbuf_get_rowstride(pixbuf);
-        gboolean has_alpha = gdk_pixbuf_get_has_alpha(pixbuf);
-        
-        GdkTexture *texture = gdk_memory_texture_new(width, height,
-            has_alpha ? GDK_MEMORY_R8G8B8A8 : GDK_MEMORY_R8G8B8,
-            bytes, stride);
-        g_bytes_unref(bytes);
+    if (texture) {
+        /* The image scales the paintable to its pixel size */
         gtk_image_set_from_paintable(GTK_IMAGE(widget), GDK_PAINTABLE(texture));
-        g_object_unref(texture);
     } else {
         gtk_image_clear(GTK_IMAGE(widget));
     }
@@ -624,16 +1471,15 @@ void coverart_widget_set_from_manager(GtkWidget *widget, CoverArtManager *manage
                                       const gchar *artist, const gchar *album, gint size) {
     if (!GTK_IS_IMAGE(widget) || !manager) return;
     
-    GdkPixbuf *pixbuf = coverart_get(manager, artist, album, size);
+    GdkTexture *texture = coverart_get(manager, artist, album, size);
     
-    if (!pixbuf) {
-        pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, size, size);
-        gdk_pixbuf_fill(pixbuf, 0x333333FF);
+    if (!texture) {
+        texture = coverart_manager_get_placeholder(manager, size);
     }
     
-    coverart_widget_set_image(widget, pixbuf);
+    coverart_widget_set_image(widget, texture);
     
-    if (pixbuf) g_object_unref(pixbuf);
+    if (texture) g_object_unref(texture);
 }
 
 typedef struct {
@@ -642,15 +1488,12 @@ typedef struct {
     gint size;
 } URLWidgetData;
 
-static gboolean update_widget_with_pixbuf_main_thread(gpointer data) {
+static gboolean update_widget_with_texture_main_thread(gpointer data) {
     CallbackData *cb_data = (CallbackData *)data;
     URLWidgetData *widget_data = (URLWidgetData *)cb_data->user_data;
     
-    if (GTK_IS_IMAGE(widget_data->widget) && cb_data->pixbuf) {
-        /* Ensure the pixbuf is the right size */
-        GdkPixbuf *scaled = gdk_pixbuf_scale_simple(cb_data->pixbuf, widget_data->size, widget_data->size, GDK_INTERP_BILINEAR);
-        coverart_widget_set_image(widget_data->widget, scaled);
-        g_object_unref(scaled);
+    if (GTK_IS_IMAGE(widget_data->widget) && cb_data->texture) {
+        coverart_widget_set_image(widget_data->widget, cb_data->texture);
     }
     
     /* Cleanup */
@@ -658,25 +1501,25 @@ static gboolean update_widget_with_pixbuf_main_thread(gpointer data) {
     g_free(widget_data->url);
     g_free(widget_data);
     
-    if (cb_data->pixbuf) {
-        g_object_unref(cb_data->pixbuf);
+    if (cb_data->texture) {
+        g_object_unref(cb_data->texture);
     }
     g_free(cb_data);
     return G_SOURCE_REMOVE;
 }
 
-static void widget_url_fetch_callback(GdkPixbuf *pixbuf, gpointer user_data) {
+static void widget_url_fetch_callback(GdkTexture *texture, gpointer user_data) {
     URLWidgetData *widget_data = (URLWidgetData *)user_data;
     
     CallbackData *cb_data = g_new0(CallbackData, 1);
-    cb_data->pixbuf = pixbuf ? g_object_ref(pixbuf) : NULL;
+    cb_data->texture = texture ? g_object_ref(texture) : NULL;
     cb_data->user_data = widget_data;
     
-    g_main_context_invoke(NULL, update_widget_with_pixbuf_main_thread, cb_data);
+    g_main_context_invoke(NULL, update_widget_with_texture_main_thread, cb_data);
 }
 
-void coverart_widget_set_from_url(GtkWidget *widget, const gchar *url) {
-    if (!GTK_IS_IMAGE(widget) || !url) return;
+void coverart_widget_set_from_url(GtkWidget *widget, CoverArtManager *manager, const gchar *url) {
+    if (!GTK_IS_IMAGE(widget) || !manager || !url) return;
     
     /* Get the size from the widget's size request */
     gint width, height;
@@ -684,8 +1527,7 @@ void coverart_widget_set_from_url(GtkWidget *widget, const gchar *url) {
     gint size = (width > 0) ? width : COVER_ART_SIZE_SMALL;
     
     /* Set a temporary placeholder while loading */
-    GdkPixbuf *placeholder = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, size, size);
-    gdk_pixbuf_fill(placeholder, 0x4A90E2FF); /* Blue placeholder for podcast images */
+    GdkTexture *placeholder = coverart_manager_get_placeholder(manager, size);
     coverart_widget_set_image(widget, placeholder);
     g_object_unref(placeholder);
     
@@ -695,14 +1537,7 @@ void coverart_widget_set_from_url(GtkWidget *widget, const gchar *url) {
     widget_data->url = g_strdup(url);
     widget_data->size = size;
     
-    /* Start async fetch - use a dummy manager (this could be improved) */
-    static CoverArtManager *dummy_manager = NULL;
-    if (!dummy_manager) {
-        dummy_manager = coverart_manager_new();
-    }
-    
-    /* Use existing async URL fetch */
-    coverart_fetch_from_url_async(dummy_manager, url, size, widget_url_fetch_callback, widget_data);
+    coverart_fetch_from_url_async(manager, url, size, widget_url_fetch_callback, widget_data);
 }
 
 gboolean coverart_widget_set_from_album(GtkWidget *widget, CoverArtManager *manager,
@@ -714,21 +1549,18 @@ gboolean coverart_widget_set_from_album(GtkWidget *widget, CoverArtManager *mana
     gtk_widget_get_size_request(widget, &width, &height);
     gint size = (width > 0) ? width : COVER_ART_SIZE_SMALL;
     
-    GdkPixbuf *pixbuf = coverart_get(manager, artist, album, size);
+    GdkTexture *texture = coverart_get(manager, artist, album, size);
     
-    if (pixbuf) {
-        /* Ensure the pixbuf is exactly the right size */
-        GdkPixbuf *scaled = gdk_pixbuf_scale_simple(pixbuf, size, size, GDK_INTERP_BILINEAR);
-        coverart_widget_set_image(widget, scaled);
-        g_object_unref(pixbuf);
-        g_object_unref(scaled);
+    if (texture) {
+        coverart_widget_set_image(widget, texture);
+        g_object_unref(texture);
         return TRUE;
     }
     
     return FALSE;
 }
 
-void coverart_widget_set_default(GtkWidget *widget) {
+void coverart_widget_set_default(GtkWidget *widget, CoverArtManager *manager) {
     if (!GTK_IS_IMAGE(widget)) return;
     
     /* Get the size from the widget's size request */
@@ -736,9 +1568,8 @@ void coverart_widget_set_default(GtkWidget *widget) {
     gtk_widget_get_size_request(widget, &width, &height);
     gint size = (width > 0) ? width : COVER_ART_SIZE_SMALL;
     
-    GdkPixbuf *pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, size, size);
-    gdk_pixbuf_fill(pixbuf, 0x333333FF); /* Default gray color */
+    GdkTexture *texture = coverart_manager_get_placeholder(manager, size);
     
-    coverart_widget_set_image(widget, pixbuf);
-    g_object_unref(pixbuf);
+    coverart_widget_set_image(widget, texture);
+    g_object_unref(texture);
 }
@@ -0,0 +1,372 @@
+#include "coverpack.h"
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+/* File layout: a 16 byte header, then records at 16 byte aligned offsets.
+ * Each record is a CoverPackRecord, the NUL-terminated key, padding, the
+ * blob and padding again, so blobs in the mapping stay aligned and a record
+ * can be copied to any aligned offset unchanged. A record with an empty
+ * blob is a tombstone: the key was removed. */
+#define COVERPACK_MAGIC "SHRKPCK1"
+#define COVERPACK_RECORD_MAGIC 0x43455253  /* "SREC" */
+#define COVERPACK_ALIGN 16
+#define COVERPACK_HEADER_SIZE 16
+
+#define COVERPACK_ALIGN_UP(n) (((n) + COVERPACK_ALIGN - 1) & ~(gsize)(COVERPACK_ALIGN - 1))
+
+typedef struct {
+    guint32 magic;
+    guint32 key_length;
+    guint64 data_length;
+} CoverPackRecord;
+
+typedef struct {
+    gsize offset;         /* Record start */
+    gsize length;         /* Whole record including padding */
+    gsize data_offset;
+    gsize data_length;
+} CoverPackEntry;
+
+struct CoverPack {
+    gchar *path;
+    FILE *file;
+    GMappedFile *mapping;
+    GBytes *mapped;        /* All of the mapping; slices keep it alive */
+    gsize mapped_end;      /* Records before this are readable through mapped */
+    gsize end;             /* Where the next record goes */
+    gsize dead_bytes;
+    GHashTable *index;     /* Key -> CoverPackEntry */
+    GMutex mutex;
+};
+
+static gboolean coverpack_write_at(FILE *file, gsize offset, const void *data, gsize length) {
+    if (fseek(file, (long)offset, SEEK_SET) != 0) return FALSE;
+    if (length > 0 && fwrite(data, 1, length, file) != length) return FALSE;
+    return fflush(file) == 0;
+}
+
+/* Map the file as it is now. Slices of the old mapping stay valid. */
+static gboolean coverpack_remap_locked(CoverPack *pack, GError **error) {
+    GMappedFile *mapping = g_mapped_file_new(pack->path, FALSE, error);
+    if (!mapping) return FALSE;
+    
+    if (pack->mapped) g_bytes_unref(pack->mapped);
+    if (pack->mapping) g_mapped_file_unref(pack->mapping);
+    pack->mapping = mapping;
+    pack->mapped = g_mapped_file_get_bytes(mapping);
+    pack->mapped_end = MIN(pack->end, g_bytes_get_size(pack->mapped));
+    return TRUE;
+}
+
+static void coverpack_index_insert(CoverPack *pack, gchar *key, CoverPackEntry *entry) {
+    CoverPackEntry *old = g_hash_table_lookup(pack->index, key);
+    if (old) {
+        pack->dead_bytes += old->length;
+    }
+    g_hash_table_insert(pack->index, key, entry);
+}
+
+static void coverpack_index_remove(CoverPack *pack, const gchar *key) {
+    CoverPackEntry *old = g_hash_table_lookup(pack->index, key);
+    if (old) {
+        pack->dead_bytes += old->length;
+        g_hash_table_remove(pack->index, key);
+    }
+}
+
+/* Index every complete record. Returns the end of the last one; anything
+ * after it is a torn write and gets overwritten by the next store. */
+static gsize coverpack_scan(CoverPack *pack) {
+    gsize length = 0;
+    const guchar *data = g_bytes_get_data(pack->mapped, &length);
+    gsize offset = COVERPACK_HEADER_SIZE;
+    
+    while (offset + sizeof(CoverPackRecord) <= length) {
+        CoverPackRecord record;
+        memcpy(&record, data + offset, sizeof(record));
+        if (record.magic != COVERPACK_RECORD_MAGIC || record.key_length == 0) break;
+        
+        gsize key_offset = offset + sizeof(CoverPackRecord);
+        if (record.key_length >= length - key_offset) break;
+        gsize data_offset = COVERPACK_ALIGN_UP(key_offset + record.key_length + 1);
+        if (data_offset > length || record.data_length > length - data_offset) break;
+        gsize record_end = COVERPACK_ALIGN_UP(data_offset + record.data_length);
+        if (record_end > length) break;
+        
+        gchar *key = g_strndup((const gchar *)data + key_offset, record.key_length);
+        if (record.data_length == 0) {
+            coverpack_index_remove(pack, key);
+            pack->dead_bytes += record_end - offset;
+            g_free(key);
+        } else {
+            CoverPackEntry *entry = g_new0(CoverPackEntry, 1);
+            entry->offset = offset;
+            entry->length = record_end - offset;
+            entry->data_offset = data_offset;
+            entry->data_length = record.data_length;
+            coverpack_index_insert(pack, key, entry);
+        }
+        
+        offset = record_end;
+    }
+    
+    return offset;
+}
+
+CoverPack* coverpack_open(const gchar *path, GError **error) {
+    g_return_val_if_fail(path != NULL, NULL);
+    
+    FILE *file = g_fopen(path, "r+b");
+    if (!file) {
+        file = g_fopen(path, "w+b");
+        if (file) {
+            gchar header[COVERPACK_HEADER_SIZE] = { 0 };
+            memcpy(header, COVERPACK_MAGIC, strlen(COVERPACK_MAGIC));
+            if (!coverpack_write_at(file, 0, header, sizeof(header))) {
+                fclose(file);
+                file = NULL;
+            }
+        }
+    }
+    if (!file) {
+        int saved_errno = errno;
+        g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(saved_errno),
+                    "Failed to open cover pack %s: %s", path, g_strerror(saved_errno));
+        return NULL;
+    }
+    
+    CoverPack *pack = g_new0(CoverPack, 1);
+    pack->path = g_strdup(path);
+    pack->file = file;
+    pack->index = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    g_mutex_init(&pack->mutex);
+    
+    if (!coverpack_remap_locked(pack, error)) {
+        coverpack_free(pack);
+        return NULL;
+    }
+    
+    gsize length = 0;
+    const gchar *data = g_bytes_get_data(pack->mapped, &length);
+    if (length < COVERPACK_HEADER_SIZE || memcmp(data, COVERPACK_MAGIC, strlen(COVERPACK_MAGIC)) != 0) {
+        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_INVAL, "%s is not a cover pack", path);
+        coverpack_free(pack);
+        return NULL;
+    }
+    
+    pack->end = coverpack_scan(pack);
+    pack->mapped_end = pack->end;
+    return pack;
+}
+
+void coverpack_free(CoverPack *pack) {
+    if (!pack) return;
+    
+    if (pack->file) fclose(pack->file);
+    if (pack->mapped) g_bytes_unref(pack->mapped);
+    if (pack->mapping) g_mapped_file_unref(pack->mapping);
+    g_hash_table_destroy(pack->index);
+    g_mutex_clear(&pack->mutex);
+    g_free(pack->path);
+    g_free(pack);
+}
+
+GBytes* coverpack_lookup(CoverPack *pack, const gchar *key) {
+    if (!pack || !key) return NULL;
+    
+    GBytes *slice = NULL;
+    g_mutex_lock(&pack->mutex);
+    
+    CoverPackEntry *entry = g_hash_table_lookup(pack->index, key);
+    if (entry) {
+        /* Stored since the file was last mapped */
+        if (entry->offset + entry->length > pack->mapped_end) {
+            GError *error = NULL;
+            if (!coverpack_remap_locked(pack, &error)) {
+                g_warning("Failed to map cover pack: %s", error->message);
+                g_error_free(error);
+            }
+        }
+        if (entry->offset + entry->length <= pack->mapped_end) {
+            slice = g_bytes_new_from_bytes(pack->mapped, entry->data_offset, entry->data_length);
+        }
+    }
+    
+    g_mutex_unlock(&pack->mutex);
+    return slice;
+}
+
+/* Append a record; an empty blob writes a tombstone */
+static gboolean coverpack_append(CoverPack *pack, const gchar *key, const guchar *blob, gsize data_length) {
+    gsize key_length = strlen(key);
+    
+    /* Offsets relative to the record start, which is aligned */
+    gsize data_offset = COVERPACK_ALIGN_UP(sizeof(CoverPackRecord) + key_length + 1);
+    gsize record_length = COVERPACK_ALIGN_UP(data_offset + data_length);
+    
+    guchar *record = g_malloc0(record_length);
+    CoverPackRecord header = { COVERPACK_RECORD_MAGIC, (guint32)key_length, data_length };
+    memcpy(record, &header, sizeof(header));
+    memcpy(record + sizeof(header), key, key_length);
+    if (data_length > 0) {
+        memcpy(record + data_offset, blob, data_length);
+    }
+    
+    g_mutex_lock(&pack->mutex);
+    gboolean success = pack->file && coverpack_write_at(pack->file, pack->end, record, record_length);
+    if (success && data_length == 0) {
+        coverpack_index_remove(pack, key);
+        pack->dead_bytes += record_length;
+        pack->end += record_length;
+    } else if (success) {
+        CoverPackEntry *entry = g_new0(CoverPackEntry, 1);
+        entry->offset = pack->end;
+        entry->length = record_length;
+        entry->data_offset = pack->end + data_offset;
+        entry->data_length = data_length;
+        coverpack_index_insert(pack, g_strdup(key), entry);
+        pack->end += record_length;
+    } else {
+        g_warning("Failed to write cover pack %s: %s", pack->path, g_strerror(errno));
+    }
+    g_mutex_unlock(&pack->mutex);
+    
+    g_free(record);
+    return success;
+}
+
+gboolean coverpack_store(CoverPack *pack, const gchar *key, GBytes *data) {
+    if (!pack || !key || !*key || !data || g_bytes_get_size(data) == 0) return FALSE;
+    
+    gsize data_length = 0;
+    const guchar *blob = g_bytes_get_data(data, &data_length);
+    return coverpack_append(pack, key, blob, data_length);
+}
+
+gboolean coverpack_remove(CoverPack *pack, const gchar *key) {
+    if (!pack || !key || !*key) return FALSE;
+    
+    g_mutex_lock(&pack->mutex);
+    gboolean present = g_hash_table_contains(pack->index, key);
+    g_mutex_unlock(&pack->mutex);
+    
+    return !present || coverpack_append(pack, key, NULL, 0);
+}
+
+GPtrArray* coverpack_list_keys(CoverPack *pack, const gchar *prefix) {
+    GPtrArray *keys = g_ptr_array_new_with_free_func(g_free);
+    if (!pack) return keys;
+    
+    g_mutex_lock(&pack->mutex);
+    GHashTableIter iter;
+    gpointer key;
+    g_hash_table_iter_init(&iter, pack->index);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+        if (!prefix || g_str_has_prefix(key, prefix)) {
+            g_ptr_array_add(keys, g_strdup(key));
+        }
+    }
+    g_mutex_unlock(&pack->mutex);
+    
+    return keys;
+}
+
+gboolean coverpack_compact(CoverPack *pack, GError **error) {
+    g_return_val_if_fail(pack != NULL, FALSE);
+    
+    g_mutex_lock(&pack->mutex);
+    
+    if (pack->end > pack->mapped_end && !coverpack_remap_locked(pack, error)) {
+        g_mutex_unlock(&pack->mutex);
+        return FALSE;
+    }
+    
+    gchar *tmp_path = g_strconcat(pack->path, ".tmp", NULL);
+    FILE *file = g_fopen(tmp_path, "w+b");
+    if (!file) {
+        int saved_errno = errno;
+        g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(saved_errno),
+                    "Failed to create %s: %s", tmp_path, g_strerror(saved_errno));
+        g_free(tmp_path);
+        g_mutex_unlock(&pack->mutex);
+        return FALSE;
+    }
+    
+    /* Copy the header and every live record, which are position independent */
+    const guchar *data = g_bytes_get_data(pack->mapped, NULL);
+    gboolean success = coverpack_write_at(file, 0, data, COVERPACK_HEADER_SIZE);
+    gsize offset = COVERPACK_HEADER_SIZE;
+    GHashTableIter iter;
+    gpointer value;
+    
+    g_hash_table_iter_init(&iter, pack->index);
+    while (success && g_hash_table_iter_next(&iter, NULL, &value)) {
+        CoverPackEntry *entry = value;
+        success = coverpack_write_at(file, offset, data + entry->offset, entry->length);
+        offset += entry->length;
+    }
+    
+    if (!success) {
+        int saved_errno = errno;
+        g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(saved_errno),
+                    "Failed to write %s: %s", tmp_path, g_strerror(saved_errno));
+        fclose(file);
+        g_unlink(tmp_path);
+        g_free(tmp_path);
+        g_mutex_unlock(&pack->mutex);
+        return FALSE;
+    }
+    
+    /* Close the old file first so the rename also works on Windows */
+    fclose(pack->file);
+    pack->file = NULL;
+    if (g_rename(tmp_path, pack->path) != 0) {
+        int saved_errno = errno;
+        g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(saved_errno),
+                    "Failed to replace %s: %s", pack->path, g_strerror(saved_errno));
+        fclose(file);
+        g_unlink(tmp_path);
+        pack->file = g_fopen(pack->path, "r+b");
+        g_free(tmp_path);
+        g_mutex_unlock(&pack->mutex);
+        return FALSE;
+    }
+    g_free(tmp_path);
+    pack->file = file;
+    
+    /* Entries move down in iteration order, the same order they were copied */
+    offset = COVERPACK_HEADER_SIZE;
+    g_hash_table_iter_init(&iter, pack->index);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        CoverPackEntry *entry = value;
+        entry->data_offset = entry->data_offset - entry->offset + offset;
+        entry->offset = offset;
+        offset += entry->length;
+    }
+    pack->end = offset;
+    pack->dead_bytes = 0;
+    
+    success = coverpack_remap_locked(pack, error);
+    g_mutex_unlock(&pack->mutex);
+    return success;
+}
+
+gsize coverpack_get_size(CoverPack *pack) {
+    if (!pack) return 0;
+    
+    g_mutex_lock(&pack->mutex);
+    gsize size = pack->end;
+    g_mutex_unlock(&pack->mutex);
+    return size;
+}
+
+gsize coverpack_get_dead_bytes(CoverPack *pack) {
+    if (!pack) return 0;
+    
+    g_mutex_lock(&pack->mutex);
+    gsize dead = pack->dead_bytes;
+    g_mutex_unlock(&pack->mutex);
+    return dead;
+}
@@ -95,7 +95,8 @@ static const char *CREATE_PODCAST_EPISODES_TABLE =
     "episode_num TEXT,"
     "FOREIGN KEY(podcast_id) REFERENCES podcasts(id),"
     "UNIQUE(podcast_id, guid)"
-    ");";
+    ");"
+    "CREATE INDEX IF NOT EXISTS idx_podcast_episodes_published ON podcast_episodes(podcast_id, published_date DESC);";
 
 static const char *CREATE_FUNDING_TABLE =
     "CREATE TABLE IF NOT EXISTS episode_funding ("
@@ -186,6 +187,160 @@ static const char *CREATE_LIVE_ITEM_CONTENT_LINKS_TABLE =
     "FOREIGN KEY(live_item_id) REFERENCES podcast_live_items(id) ON DELETE CASCADE"
     ");";
 
+static const char *CREATE_DOWNLOAD_QUEUE_TABLE =
+    "CREATE TABLE IF NOT EXISTS download_queue ("
+    "episode_id INTEGER PRIMARY KEY,"
+    "priority INTEGER NOT NULL DEFAULT 0,"
+    "attempts INTEGER NOT NULL DEFAULT 0,"
+    "next_attempt INTEGER NOT NULL DEFAULT 0,"
+    "last_error TEXT,"
+    "date_added INTEGER,"
+    "FOREIGN KEY(episode_id) REFERENCES podcast_episodes(id) ON DELETE CASCADE"
+    ");";
+
+static const char *CREATE_EPISODE_CHAPTERS_TABLE =
+    "CREATE TABLE IF NOT EXISTS episode_chapters ("
+    "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "episode_id INTEGER NOT NULL,"
+    "start_time REAL NOT NULL,"
+    "title TEXT,"
+    "img TEXT,"
+    "url TEXT,"
+    "FOREIGN KEY(episode_id) REFERENCES podcast_episodes(id) ON DELETE CASCADE"
+    ");"
+    "CREATE INDEX IF NOT EXISTS idx_episode_chapters_episode ON episode_chapters(episode_id, start_time);";
+
+/* Dominant cover colour per album, painted before the art itself loads */
+static const char *CREATE_ALBUM_ART_TABLE =
+    "CREATE TABLE IF NOT EXISTS album_art ("
+    "artist TEXT NOT NULL,"
+    "album TEXT NOT NULL,"
+    "color INTEGER NOT NULL,"
+    "PRIMARY KEY(artist, album)"
+    ");";
+
+/* Full-text search indexes, kept in sync by triggers. Episode descriptions
+ * are indexed as plain text via the strip_html() SQL function registered in
+ * database_new(). */
+static const char *CREATE_SEARCH_TABLES =
+    "CREATE VIRTUAL TABLE IF NOT EXISTS podcast_search USING fts5(title, author, tokenize='unicode61');"
+    "CREATE TRIGGER IF NOT EXISTS podcast_search_insert AFTER INSERT ON podcasts BEGIN "
+    "INSERT INTO podcast_search(rowid, title, author) VALUES (new.id, new.title, new.author); "
+    "END;"
+    "CREATE TRIGGER IF NOT EXISTS podcast_search_update AFTER UPDATE OF title, author ON podcasts "
+    "WHEN old.title IS NOT new.title OR old.author IS NOT new.author BEGIN "
+    "DELETE FROM podcast_search WHERE rowid = old.id; "
+    "INSERT INTO podcast_search(rowid, title, author) VALUES (new.id, new.title, new.author); "
+    "END;"
+    "CREATE TRIGGER IF NOT EXISTS podcast_search_delete AFTER DELETE ON podcasts BEGIN "
+    "DELETE FROM podcast_search WHERE rowid = old.id; "
+    "END;"
+    "CREATE VIRTUAL TABLE IF NOT EXISTS episode_search USING fts5(title, description, tokenize='unicode61');"
+    "CREATE TRIGGER IF NOT EXISTS episode_search_insert AFTER INSERT ON podcast_episodes BEGIN "
+    "INSERT INTO episode_search(rowid, title, description) VALUES (new.id, new.title, strip_html(new.description)); "
+    "END;"
+    "CREATE TRIGGER IF NOT EXISTS episode_search_update AFTER UPDATE OF title, description ON podcast_episodes "
+    "WHEN old.title IS NOT new.title OR old.description IS NOT new.description BEGIN "
+    "DELETE FROM episode_search WHERE rowid = old.id; "
+    "INSERT INTO episode_search(rowid, title, description) VALUES (new.id, new.title, strip_html(new.description)); "
+    "END;"
+    "CREATE TRIGGER IF NOT EXISTS episode_search_delete AFTER DELETE ON podcast_episodes BEGIN "
+    "DELETE FROM episode_search WHERE rowid = old.id; "
+    "END;";
+
+/* Spoken text of downloaded episodes, in passages keyed by where they start
+ * in the episode */
+static const char *CREATE_TRANSCRIPT_PASSAGES_TABLE =
+    "CREATE TABLE IF NOT EXISTS transcript_passages ("
+    "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "episode_id INTEGER NOT NULL,"
+    "start_time REAL NOT NULL,"
+    "text TEXT NOT NULL,"
+    "FOREIGN KEY(episode_id) REFERENCES podcast_episodes(id) ON DELETE CASCADE"
+    ");"
+    "CREATE INDEX IF NOT EXISTS idx_transcript_passages_episode ON transcript_passages(episode_id, start_time);";
+
+/* Passages indexed through an external-content FTS5 table */
+static const char *CREATE_TRANSCRIPT_SEARCH_TABLES =
+    "CREATE VIRTUAL TABLE IF NOT EXISTS transcript_search USING fts5(text, content='transcript_passages', "
+    "content_rowid='id', tokenize='unicode61');"
+    "CREATE TRIGGER IF NOT EXISTS transcript_search_insert AFTER INSERT ON transcript_passages BEGIN "
+    "INSERT INTO transcript_search(rowid, text) VALUES (new.id, new.text); "
+    "END;"
+    "CREATE TRIGGER IF NOT EXISTS transcript_search_delete AFTER DELETE ON transcript_passages BEGIN "
+    "INSERT INTO transcript_search(transcript_search, rowid, text) VALUES ('delete', old.id, old.text); "
+    "END;";
+
+/* Fills the search indexes from existing rows when they are first created,
+ * or when their triggers were dropped by a run without FTS5 */
+static const char *POPULATE_SEARCH_TABLES =
+    "DELETE FROM podcast_search;"
+    "DELETE FROM episode_search;"
+    "INSERT INTO transcript_search(transcript_search) VALUES ('rebuild');"
+    "INSERT INTO podcast_search(rowid, title, author) SELECT id, title, author FROM podcasts;"
+    "INSERT INTO episode_search(rowid, title, description) "
+    "SELECT id, title, strip_html(description) FROM podcast_episodes;";
+
+/* Without FTS5 the index triggers would fail every write to the indexed
+ * tables of a database created by a build that had it */
+static const char *DROP_SEARCH_TRIGGERS =
+    "DROP TRIGGER IF EXISTS podcast_search_insert;"
+    "DROP TRIGGER IF EXISTS podcast_search_update;"
+    "DROP TRIGGER IF EXISTS podcast_search_delete;"
+    "DROP TRIGGER IF EXISTS episode_search_insert;"
+    "DROP TRIGGER IF EXISTS episode_search_update;"
+    "DROP TRIGGER IF EXISTS episode_search_delete;"
+    "DROP TRIGGER IF EXISTS transcript_search_insert;"
+    "DROP TRIGGER IF EXISTS transcript_search_delete;";
+
+/* Reduce HTML to the text a user would search for: tags become spaces so
+ * adjacent words don't run together, and common entities are decoded */
+static gchar* database_strip_html(const gchar *html) {
+    static const struct { const gchar *entity; const gchar *text; } entities[] = {
+        { "&amp;", "&" }, { "&lt;", "<" }, { "&gt;", ">" }, { "&quot;", "\"" },
+        { "&apos;", "'" }, { "&#39;", "'" }, { "&nbsp;", " " }
+    };
+    GString *text = g_string_sized_new(strlen(html));
+    gboolean in_tag = FALSE;
+    
+    for (const gchar *p = html; *p; p++) {
+        if (*p == '<') {
+            in_tag = TRUE;
+        } else if (*p == '>' && in_tag) {
+            in_tag = FALSE;
+            g_string_append_c(text, ' ');
+        } else if (!in_tag) {
+            gboolean decoded = FALSE;
+            if (*p == '&') {
+                for (gsize i = 0; i < G_N_ELEMENTS(entities); i++) {
+                    gsize len = strlen(entities[i].entity);
+                    if (strncmp(p, entities[i].entity, len) == 0) {
+                        g_string_append(text, entities[i].text);
+                        p += len - 1;
+                        decoded = TRUE;
+                        break;
+                    }
+                }
+            }
+            if (!decoded) {
+                g_string_append_c(text, *p);
+            }
+        }
+    }
+    
+    return g_string_free(text, FALSE);
+}
+
+static void sql_strip_html(sqlite3_context *context, int argc, sqlite3_value **argv) {
+    (void)argc;
+    const gchar *html = (const gchar *)sqlite3_value_text(argv[0]);
+    if (!html) {
+        sqlite3_result_null(context);
+        return;
+    }
+    sqlite3_result_text(context, database_strip_html(html), -1, g_free);
+}
+
 
 Database* database_new(const gchar *db_path) {
     Database *db = g_new0(Database, 1);
@@ -199,9 +354,15 @@ Database* database_new(const gchar *db_path) {
         return NULL;
     }
     
+    g_rec_mutex_init(&db->lock);
+    
     /* Enable foreign key enforcement */
     sqlite3_exec(db->db, "PRAGMA foreign_keys = ON;", NULL, NULL, NULL);
     
+    /* Used by the search index triggers */
+    sqlite3_create_function(db->db, "strip_html", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+                            NULL, sql_strip_html, NULL, NULL);
+    
     return db;
 }
 
@@ -212,12 +373,16 @@ void database_free(Database *db) {
         sqlite3_close(db->db);
     }
     
+    g_rec_mutex_clear(&db->lock);
     g_free(db->db_path);
     g_free(db);
 }
 
 gboolean database_begin_transaction(Database *db) {
     if (!db || !db->db) return FALSE;
+    
+    /* Released by the matching commit or rollback */
+    g_rec_mutex_lock(&db->lock);
     char *err_msg = NULL;
     int rc = sqlite3_exec(db->db, "BEGIN TRANSACTION;", NULL, NULL, &err_msg);
     if (rc != SQLITE_OK) {
@@ -235,8 +400,12 @@ gboolean database_commit_transaction(Database *db) {
     if (rc != SQLITE_OK) {
         g_warning("Failed to commit transaction: %s", err_msg);
         sqlite3_free(err_msg);
+        /* Don't leave it open for whoever takes the lock next */
+        sqlite3_exec(db->db, "ROLLBACK;", NULL, NULL, NULL);
+        g_rec_mutex_unlock(&db->lock);
         return FALSE;
     }
+    g_rec_mutex_unlock(&db->lock);
     return TRUE;
 }
 
@@ -244,6 +413,7 @@ gboolean database_rollback_transaction(Database *db) {
     if (!db || !db->db) return FALSE;
     char *err_msg = NULL;
     int rc = sqlite3_exec(db->db, "ROLLBACK;", NULL, NULL, &err_msg);
+    g_rec_mutex_unlock(&db->lock);
     if (rc != SQLITE_OK) {
         g_warning("Failed to rollback transaction: %s", err_msg);
         sqlite3_free(err_msg);
@@ -254,6 +424,7 @@ gboolean database_rollback_transaction(Database *db) {
 
 gboolean database_init_tables(Database *db) {
     if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     char *err_msg = NULL;
     int rc;
@@ -370,6 +541,74 @@ gboolean database_init_tables(Database *db) {
         return FALSE;
     }
     
+    /* Create download_queue table */
+    rc = sqlite3_exec(db->db, CREATE_DOWNLOAD_QUEUE_TABLE, NULL, NULL, &err_msg);
+    if (rc != SQLITE_OK) {
+        g_printerr("SQL error: %s\n", err_msg);
+        sqlite3_free(err_msg);
+        return FALSE;
+    }
+    
+    /* Create episode_chapters table */
+    rc = sqlite3_exec(db->db, CREATE_EPISODE_CHAPTERS_TABLE, NULL, NULL, &err_msg);
+    if (rc != SQLITE_OK) {
+        g_printerr("SQL error: %s\n", err_msg);
+        sqlite3_free(err_msg);
+        return FALSE;
+    }
+    
+    /* Create album_art table */
+    rc = sqlite3_exec(db->db, CREATE_ALBUM_ART_TABLE, NULL, NULL, &err_msg);
+    if (rc != SQLITE_OK) {
+        g_printerr("SQL error: %s\n", err_msg);
+        sqlite3_free(err_msg);
+        return FALSE;
+    }
+    
+    rc = sqlite3_exec(db->db, CREATE_TRANSCRIPT_PASSAGES_TABLE, NULL, NULL, &err_msg);
+    if (rc != SQLITE_OK) {
+        g_printerr("SQL error: %s\n", err_msg);
+        sqlite3_free(err_msg);
+        return FALSE;
+    }
+    
+    /* Create full-text search indexes, populating them whenever their
+     * triggers are new. Existing transcripts are indexed by the podcast
+     * manager at startup. */
+    sqlite3_stmt *exists_stmt;
+    gboolean search_exists = FALSE;
+    if (sqlite3_prepare_v2(db->db, "SELECT 1 FROM sqlite_master WHERE name = 'episode_search_insert';",
+                           -1, &exists_stmt, NULL) == SQLITE_OK) {
+        search_exists = (sqlite3_step(exists_stmt) == SQLITE_ROW);
+        sqlite3_finalize(exists_stmt);
+    }
+    
+    db->has_fts5 = TRUE;
+    rc = sqlite3_exec(db->db, CREATE_SEARCH_TABLES, NULL, NULL, &err_msg);
+    if (rc == SQLITE_OK) {
+        rc = sqlite3_exec(db->db, CREATE_TRANSCRIPT_SEARCH_TABLES, NULL, NULL, &err_msg);
+    }
+    if (rc != SQLITE_OK && err_msg && strstr(err_msg, "no such module")) {
+        /* Searching still works, just by scanning */
+        g_warning("SQLite was built without FTS5, search will be slower: %s", err_msg);
+        sqlite3_free(err_msg);
+        db->has_fts5 = FALSE;
+        rc = sqlite3_exec(db->db, DROP_SEARCH_TRIGGERS, NULL, NULL, &err_msg);
+    }
+    if (rc != SQLITE_OK) {
+        g_printerr("SQL error: %s\n", err_msg);
+        sqlite3_free(err_msg);
+        return FALSE;
+    }
+    
+    if (db->has_fts5 && !search_exists) {
+        rc = sqlite3_exec(db->db, POPULATE_SEARCH_TABLES, NULL, NULL, &err_msg);
+        if (rc != SQLITE_OK) {
+            g_printerr("SQL error: %s\n", err_msg);
+            sqlite3_free(err_msg);
+        }
+    }
+    
     /* Migration: Add track_number column to existing tracks table if it doesn't exist */
     rc = sqlite3_exec(db->db, "ALTER TABLE tracks ADD COLUMN track_number INTEGER DEFAULT 0;", NULL, NULL, &err_msg);
     if (rc != SQLITE_OK) {
@@ -384,11 +623,34 @@ gboolean database_init_tables(Database *db) {
         sqlite3_free(err_msg);
     }
     
+    /* Migration: Per-podcast retention and auto-download bookkeeping */
+    const char *podcast_download_migrations[] = {
+        "ALTER TABLE podcasts ADD COLUMN keep_episodes INTEGER DEFAULT 0;",
+        "ALTER TABLE podcasts ADD COLUMN delete_played_after_days INTEGER DEFAULT 0;",
+        "ALTER TABLE podcasts ADD COLUMN auto_download_since INTEGER DEFAULT 0;",
+        "ALTER TABLE podcast_episodes ADD COLUMN played_date INTEGER DEFAULT 0;",
+        "ALTER TABLE podcast_episodes ADD COLUMN auto_queued INTEGER DEFAULT 0;",
+        /* mtime of the local file whose embedded chapters are in episode_chapters */
+        "ALTER TABLE podcast_episodes ADD COLUMN chapters_scanned INTEGER DEFAULT 0;",
+        /* Unix time the feed is next due for a scheduled refresh, 0 = now */
+        "ALTER TABLE podcasts ADD COLUMN next_refresh INTEGER DEFAULT 0;",
+        /* Set once the cached transcript is in transcript_passages */
+        "ALTER TABLE podcast_episodes ADD COLUMN transcript_indexed INTEGER DEFAULT 0;"
+    };
+    for (gsize i = 0; i < G_N_ELEMENTS(podcast_download_migrations); i++) {
+        rc = sqlite3_exec(db->db, podcast_download_migrations[i], NULL, NULL, &err_msg);
+        if (rc != SQLITE_OK) {
+            /* Column may already exist, that's fine */
+            sqlite3_free(err_msg);
+        }
+    }
+    
     return TRUE;
 }
 
 gint database_add_track(Database *db, Track *track) {
     if (!db || !db->db || !track) return -1;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "INSERT INTO tracks (title, artist, album, genre, track_number, duration, file_path, date_added) "
                       "VALUES (?, ?, ?, ?, ?, ?, ?, ?);";
@@ -423,6 +685,7 @@ gint database_add_track(Database *db, Track *track) {
 
 Track* database_get_track(Database *db, gint track_id) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added "
                       "FROM tracks WHERE id = ?;";
@@ -457,6 +720,7 @@ Track* database_get_track(Database *db, gint track_id) {
 
 GList* database_get_all_tracks(Database *db) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     /* Get only audio files from tracks table (positive filter for audio extensions) */
     const char *sql = "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added "
@@ -494,6 +758,7 @@ GList* database_get_all_tracks(Database *db) {
 
 gint database_get_audio_track_count(Database *db) {
     if (!db || !db->db) return 0;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT COUNT(*) FROM tracks WHERE "
                       AUDIO_EXT_FILTER ";";
@@ -516,6 +781,7 @@ gint database_get_audio_track_count(Database *db) {
 
 GList* database_get_tracks_by_artist(Database *db, const gchar *artist) {
     if (!db || !db->db || !artist) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added "
                       "FROM tracks WHERE artist = ? AND "
@@ -552,6 +818,7 @@ GList* database_get_tracks_by_artist(Database *db, const gchar *artist) {
 
 GList* database_get_tracks_by_album(Database *db, const gchar *artist, const gchar *album) {
     if (!db || !db->db || !album) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = artist ? 
         "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added "
@@ -595,19 +862,19 @@ GList* database_get_tracks_by_album(Database *db, const gchar *artist, const gch
     return g_list_reverse(tracks);
 }
 
-typedef struct {
-    gchar *artist;
-    gchar *album;
-} AlbumInfo;
-
 GList* database_get_albums_by_artist(Database *db, const gchar *artist) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = artist ? 
-        "SELECT DISTINCT artist, album FROM tracks WHERE artist = ? AND album IS NOT NULL AND album != '' AND "
-        AUDIO_EXT_FILTER " ORDER BY album;" :
-        "SELECT DISTINCT artist, album FROM tracks WHERE album IS NOT NULL AND album != '' AND "
-        AUDIO_EXT_FILTER " ORDER BY artist, album;";
+        "SELECT a.artist, a.album, COALESCE(c.color, 0) FROM "
+        "(SELECT DISTINCT artist, album FROM tracks WHERE artist = ? AND album IS NOT NULL AND album != '' AND "
+        AUDIO_EXT_FILTER ") a LEFT JOIN album_art c ON c.artist = a.artist AND c.album = a.album "
+        "ORDER BY a.album;" :
+        "SELECT a.artist, a.album, COALESCE(c.color, 0) FROM "
+        "(SELECT DISTINCT artist, album FROM tracks WHERE album IS NOT NULL AND album != '' AND "
+        AUDIO_EXT_FILTER ") a LEFT JOIN album_art c ON c.artist = a.artist AND c.album = a.album "
+        "ORDER BY a.artist, a.album;";
     
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
@@ -625,6 +892,7 @@ GList* database_get_albums_by_artist(Database *db, const gchar *artist) {
         AlbumInfo *info = g_new0(AlbumInfo, 1);
         info->artist = g_strdup((const gchar *)sqlite3_column_text(stmt, 0));
         info->album = g_strdup((const gchar *)sqlite3_column_text(stmt, 1));
+        info->color = (guint32)sqlite3_column_int64(stmt, 2);
         albums = g_list_prepend(albums, info);
     }
     
@@ -632,8 +900,54 @@ GList* database_get_albums_by_artist(Database *db, const gchar *artist) {
     return g_list_reverse(albums);
 }
 
+gboolean database_set_album_color(Database *db, const gchar *artist, const gchar *album, guint32 color) {
+    if (!db || !db->db || !artist || !album) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "INSERT OR REPLACE INTO album_art (artist, album, color) VALUES (?, ?, ?);";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_warning("database_set_album_color: prepare failed: %s", sqlite3_errmsg(db->db));
+        return FALSE;
+    }
+    
+    sqlite3_bind_text(stmt, 1, artist, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, album, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 3, color);
+    
+    rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    return rc == SQLITE_DONE;
+}
+
+guint32 database_get_album_color(Database *db, const gchar *artist, const gchar *album) {
+    if (!db || !db->db || !artist || !album) return 0;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "SELECT color FROM album_art WHERE artist = ? AND album = ?;";
+    
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        return 0;
+    }
+    
+    sqlite3_bind_text(stmt, 1, artist, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, album, -1, SQLITE_STATIC);
+    
+    guint32 color = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        color = (guint32)sqlite3_column_int64(stmt, 0);
+    }
+    
+    sqlite3_finalize(stmt);
+    return color;
+}
+
 gboolean database_update_track(Database *db, Track *track) {
     if (!db || !db->db || !track) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "UPDATE tracks SET title=?, artist=?, album=?, genre=?, duration=?, "
                       "file_path=?, play_count=? WHERE id=?;";
@@ -663,6 +977,7 @@ gboolean database_update_track(Database *db, Track *track) {
 
 gboolean database_delete_track(Database *db, gint track_id) {
     if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "DELETE FROM tracks WHERE id=?;";
     
@@ -683,6 +998,7 @@ gboolean database_delete_track(Database *db, gint track_id) {
 
 GList* database_search_tracks(Database *db, const gchar *search_term) {
     if (!db || !db->db || !search_term) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added "
                       "FROM tracks WHERE (title LIKE ? OR artist LIKE ? OR album LIKE ?) AND "
@@ -724,6 +1040,7 @@ GList* database_search_tracks(Database *db, const gchar *search_term) {
 /* Video operations */
 GList* database_get_all_videos(Database *db) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     /* Get all files and filter by video extensions (case-insensitive) */
     const char *sql = "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added "
@@ -760,6 +1077,7 @@ GList* database_get_all_videos(Database *db) {
 
 GList* database_search_videos(Database *db, const gchar *search_term) {
     if (!db || !db->db || !search_term) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added "
                       "FROM tracks WHERE (title LIKE ? OR artist LIKE ? OR album LIKE ?) AND "
@@ -800,6 +1118,7 @@ GList* database_search_videos(Database *db, const gchar *search_term) {
 
 gint database_create_playlist(Database *db, const gchar *name) {
     if (!db || !db->db || !name) return -1;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "INSERT INTO playlists (name, date_created) VALUES (?, ?);";
     
@@ -825,6 +1144,7 @@ gint database_create_playlist(Database *db, const gchar *name) {
 
 GList* database_get_all_playlists(Database *db) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, name, date_created FROM playlists ORDER BY name;";
     
@@ -850,6 +1170,7 @@ GList* database_get_all_playlists(Database *db) {
 
 gboolean database_add_track_to_playlist(Database *db, gint playlist_id, gint track_id) {
     if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     /* Get current max position */
     const char *max_sql = "SELECT MAX(position) FROM playlist_tracks WHERE playlist_id=?;";
@@ -886,6 +1207,7 @@ gboolean database_add_track_to_playlist(Database *db, gint playlist_id, gint tra
 
 GList* database_get_playlist_tracks(Database *db, gint playlist_id) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT t.id, t.title, t.artist, t.album, t.genre, t.duration, "
                       "t.file_path, t.play_count, t.date_added "
@@ -928,6 +1250,7 @@ GList* database_get_playlist_tracks(Database *db, gint playlist_id) {
 
 gboolean database_delete_playlist(Database *db, gint playlist_id) {
     if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     /* Delete playlist tracks first */
     const char *sql1 = "DELETE FROM playlist_tracks WHERE playlist_id=?;";
@@ -956,6 +1279,7 @@ gboolean database_delete_playlist(Database *db, gint playlist_id) {
 
 gboolean database_increment_play_count(Database *db, gint track_id) {
     if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     gint64 now = g_get_real_time() / 1000000;  /* Convert to seconds */
     const char *sql = "UPDATE tracks SET play_count = play_count + 1, last_played = ? WHERE id=?;";
@@ -977,6 +1301,7 @@ gboolean database_increment_play_count(Database *db, gint track_id) {
 
 gboolean database_toggle_favorite(Database *db, gint track_id) {
     if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "UPDATE tracks SET is_favorite = NOT is_favorite WHERE id=?;";
     
@@ -997,6 +1322,7 @@ gboolean database_toggle_favorite(Database *db, gint track_id) {
 
 gboolean database_set_favorite(Database *db, gint track_id, gboolean is_favorite) {
     if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "UPDATE tracks SET is_favorite = ? WHERE id=?;";
     
@@ -1018,6 +1344,7 @@ gboolean database_set_favorite(Database *db, gint track_id, gboolean is_favorite
 
 gboolean database_is_favorite(Database *db, gint track_id) {
     if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT is_favorite FROM tracks WHERE id=?;";
     
@@ -1041,6 +1368,7 @@ gboolean database_is_favorite(Database *db, gint track_id) {
 
 GList* database_get_favorite_tracks(Database *db, gint limit) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added, last_played, is_favorite "
                       "FROM tracks WHERE is_favorite = 1 AND "
@@ -1079,6 +1407,7 @@ GList* database_get_favorite_tracks(Database *db, gint limit) {
 
 GList* database_get_most_played_tracks(Database *db, gint limit) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added "
                       "FROM tracks WHERE play_count > 0 AND "
@@ -1115,6 +1444,7 @@ GList* database_get_most_played_tracks(Database *db, gint limit) {
 
 GList* database_get_recent_tracks(Database *db, gint limit) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added "
                       "FROM tracks WHERE "
@@ -1151,6 +1481,7 @@ GList* database_get_recent_tracks(Database *db, gint limit) {
 
 GList* database_get_recently_played_tracks(Database *db, gint limit) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, title, artist, album, genre, track_number, duration, file_path, play_count, date_added, last_played "
                       "FROM tracks WHERE last_played IS NOT NULL AND last_played > 0 AND "
@@ -1218,6 +1549,7 @@ void database_free_playlist(Playlist *playlist) {
 gint database_add_podcast(Database *db, const gchar *title, const gchar *feed_url, const gchar *link,
                           const gchar *description, const gchar *author, const gchar *image_url, const gchar *language) {
     if (!db || !db->db) return -1;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "INSERT INTO podcasts (title, feed_url, link, description, author, image_url, language, last_fetched) "
                       "VALUES (?, ?, ?, ?, ?, ?, ?, ?);";
@@ -1248,6 +1580,7 @@ gint database_add_podcast_episode(Database *db, gint podcast_id, const gchar *gu
                                   const gchar *chapters_url, const gchar *chapters_type,
                                   const gchar *transcript_url, const gchar *transcript_type) {
     if (!db || !db->db) return -1;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "INSERT INTO podcast_episodes "
                       "(podcast_id, guid, title, description, enclosure_url, enclosure_length, enclosure_type, published_date, duration, "
@@ -1278,13 +1611,29 @@ gint database_add_podcast_episode(Database *db, gint podcast_id, const gchar *gu
     
     rc = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
-    
     if (rc != SQLITE_DONE) return -1;
-    return sqlite3_last_insert_rowid(db->db);
+    
+    /* last_insert_rowid is stale when the upsert updated an existing row */
+    if (sqlite3_prepare_v2(db->db, "SELECT id FROM podcast_episodes WHERE podcast_id = ? AND guid = ?;",
+                           -1, &stmt, NULL) != SQLITE_OK) {
+        return -1;
+    }
+    
+    sqlite3_bind_int(stmt, 1, podcast_id);
+    sqlite3_bind_text(stmt, 2, guid, -1, SQLITE_TRANSIENT);
+    
+    gint episode_id = -1;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        episode_id = sqlite3_column_int(stmt, 0);
+    }
+    
+    sqlite3_finalize(stmt);
+    return episode_id;
 }
 
 GList* database_get_podcast_episodes(Database *db, gint podcast_id) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, guid, title, description, enclosure_url, enclosure_length, enclosure_type, "
                       "published_date, duration, downloaded, local_file_path, play_position, played, "
@@ -1329,8 +1678,74 @@ GList* database_get_podcast_episodes(Database *db, gint podcast_id) {
     return g_list_reverse(episodes);
 }
 
+GArray* database_get_podcast_episode_keys(Database *db, gint podcast_id) {
+    GArray *keys = g_array_new(FALSE, FALSE, sizeof(EpisodeRowKey));
+    if (!db || !db->db) return keys;
+    DATABASE_LOCK_SCOPE(db);
+    
+    /* Same order as database_get_podcast_episode_page */
+    const char *sql = "SELECT id, title, published_date, duration, downloaded "
+                      "FROM podcast_episodes WHERE podcast_id = ? "
+                      "ORDER BY published_date DESC, id DESC;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) return keys;
+    
+    sqlite3_bind_int(stmt, 1, podcast_id);
+    
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const gchar *title = (const gchar *)sqlite3_column_text(stmt, 1);
+        EpisodeRowKey key;
+        key.id = sqlite3_column_int(stmt, 0);
+        key.state = g_str_hash(title ? title : "");
+        key.state = key.state * 31 + (guint)sqlite3_column_int64(stmt, 2);
+        key.state = key.state * 31 + (guint)sqlite3_column_int(stmt, 3);
+        key.state = key.state * 31 + (guint)sqlite3_column_int(stmt, 4);
+        g_array_append_val(keys, key);
+    }
+    
+    sqlite3_finalize(stmt);
+    return keys;
+}
+
+GList* database_get_podcast_episode_page(Database *db, gint podcast_id, gint offset, gint limit) {
+    if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
+    
+    /* Same order as database_get_podcast_episodes; id breaks ties so pages never overlap */
+    const char *sql = "SELECT id, title, published_date, duration, downloaded "
+                      "FROM podcast_episodes WHERE podcast_id = ? "
+                      "ORDER BY published_date DESC, id DESC LIMIT ? OFFSET ?;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) return NULL;
+    
+    sqlite3_bind_int(stmt, 1, podcast_id);
+    sqlite3_bind_int(stmt, 2, limit);
+    sqlite3_bind_int(stmt, 3, offset);
+    
+    GList *episodes = NULL;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        PodcastEpisode *episode = g_new0(PodcastEpisode, 1);
+        episode->id = sqlite3_column_int(stmt, 0);
+        episode->podcast_id = podcast_id;
+        episode->title = g_strdup((const gchar *)sqlite3_column_text(stmt, 1));
+        episode->published_date = sqlite3_column_int64(stmt, 2);
+        episode->duration = sqlite3_column_int(stmt, 3);
+        episode->downloaded = sqlite3_column_int(stmt, 4);
+        
+        episodes = g_list_prepend(episodes, episode);
+    }
+    
+    sqlite3_finalize(stmt);
+    return g_list_reverse(episodes);
+}
+
 PodcastEpisode* database_get_episode_by_id(Database *db, gint episode_id) {
     if (!db || !db->db || episode_id <= 0) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, podcast_id, guid, title, description, enclosure_url, enclosure_length, enclosure_type, "
                       "published_date, duration, downloaded, local_file_path, play_position, played, "
@@ -1376,11 +1791,98 @@ PodcastEpisode* database_get_episode_by_id(Database *db, gint episode_id) {
     return episode;
 }
 
+/* Fill in funding and value (with recipients) for a list of podcasts using
+ * one query per table, matched up by id in memory, instead of a round of
+ * queries per podcast. Rows are read in insertion order and prepended, so
+ * each list is reversed at the end. */
+static void database_load_podcast_extras(Database *db, GList *podcasts) {
+    if (!podcasts) return;
+    
+    GHashTable *podcasts_by_id = g_hash_table_new(g_direct_hash, g_direct_equal);
+    for (GList *l = podcasts; l != NULL; l = l->next) {
+        Podcast *podcast = (Podcast *)l->data;
+        g_hash_table_insert(podcasts_by_id, GINT_TO_POINTER(podcast->id), podcast);
+    }
+    
+    sqlite3_stmt *stmt;
+    const char *funding_sql = "SELECT podcast_id, url, message, platform FROM podcast_funding ORDER BY id;";
+    if (sqlite3_prepare_v2(db->db, funding_sql, -1, &stmt, NULL) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            Podcast *podcast = g_hash_table_lookup(podcasts_by_id, GINT_TO_POINTER(sqlite3_column_int(stmt, 0)));
+            if (!podcast) continue;
+            
+            PodcastFunding *funding = g_new0(PodcastFunding, 1);
+            funding->url = g_strdup((const gchar *)sqlite3_column_text(stmt, 1));
+            funding->message = g_strdup((const gchar *)sqlite3_column_text(stmt, 2));
+            funding->platform = g_strdup((const gchar *)sqlite3_column_text(stmt, 3));
+            podcast->funding = g_list_prepend(podcast->funding, funding);
+        }
+        sqlite3_finalize(stmt);
+    }
+    
+    GHashTable *values_by_id = g_hash_table_new_full(g_int64_hash, g_int64_equal, g_free, NULL);
+    const char *value_sql = "SELECT id, podcast_id, type, method, suggested FROM podcast_value ORDER BY id;";
+    if (sqlite3_prepare_v2(db->db, value_sql, -1, &stmt, NULL) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            Podcast *podcast = g_hash_table_lookup(podcasts_by_id, GINT_TO_POINTER(sqlite3_column_int(stmt, 1)));
+            if (!podcast) continue;
+            
+            PodcastValue *value = g_new0(PodcastValue, 1);
+            value->type = g_strdup((const gchar *)sqlite3_column_text(stmt, 2));
+            value->method = g_strdup((const gchar *)sqlite3_column_text(stmt, 3));
+            value->suggested = g_strdup((const gchar *)sqlite3_column_text(stmt, 4));
+            podcast->value = g_list_prepend(podcast->value, value);
+            
+            gint64 *value_id = g_new(gint64, 1);
+            *value_id = sqlite3_column_int64(stmt, 0);
+            g_hash_table_insert(values_by_id, value_id, value);
+        }
+        sqlite3_finalize(stmt);
+    }
+    
+    const char *recipient_sql = "SELECT value_id, name, recipient_type, address, split, fee, custom_key, custom_value "
+                                "FROM value_recipients WHERE value_type = 'podcast' ORDER BY id;";
+    if (g_hash_table_size(values_by_id) > 0 &&
+        sqlite3_prepare_v2(db->db, recipient_sql, -1, &stmt, NULL) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            gint64 value_id = sqlite3_column_int64(stmt, 0);
+            PodcastValue *value = g_hash_table_lookup(values_by_id, &value_id);
+            if (!value) continue;
+            
+            ValueRecipient *recipient = g_new0(ValueRecipient, 1);
+            recipient->name = g_strdup((const gchar *)sqlite3_column_text(stmt, 1));
+            recipient->type = g_strdup((const gchar *)sqlite3_column_text(stmt, 2));
+            recipient->address = g_strdup((const gchar *)sqlite3_column_text(stmt, 3));
+            recipient->split = sqlite3_column_int(stmt, 4);
+            recipient->fee = sqlite3_column_int(stmt, 5) != 0;
+            recipient->custom_key = g_strdup((const gchar *)sqlite3_column_text(stmt, 6));
+            recipient->custom_value = g_strdup((const gchar *)sqlite3_column_text(stmt, 7));
+            value->recipients = g_list_prepend(value->recipients, recipient);
+        }
+        sqlite3_finalize(stmt);
+    }
+    
+    for (GList *l = podcasts; l != NULL; l = l->next) {
+        Podcast *podcast = (Podcast *)l->data;
+        podcast->funding = g_list_reverse(podcast->funding);
+        podcast->value = g_list_reverse(podcast->value);
+        for (GList *v = podcast->value; v != NULL; v = v->next) {
+            PodcastValue *value = (PodcastValue *)v->data;
+            value->recipients = g_list_reverse(value->recipients);
+        }
+    }
+    
+    g_hash_table_destroy(values_by_id);
+    g_hash_table_destroy(podcasts_by_id);
+}
+
 GList* database_get_podcasts(Database *db) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, title, feed_url, link, description, author, image_url, language, "
-                      "last_updated, last_fetched, auto_download FROM podcasts ORDER BY title;";
+                      "last_updated, last_fetched, auto_download, keep_episodes, delete_played_after_days, next_refresh "
+                      "FROM podcasts ORDER BY title;";
     
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
@@ -1400,26 +1902,29 @@ GList* database_get_podcasts(Database *db) {
         podcast->last_updated = sqlite3_column_int64(stmt, 8);
         podcast->last_fetched = sqlite3_column_int64(stmt, 9);
         podcast->auto_download = sqlite3_column_int(stmt, 10);
-        
-        /* Load funding information */
-        podcast->funding = database_load_podcast_funding(db, podcast->id);
+        podcast->keep_episodes = sqlite3_column_int(stmt, 11);
+        podcast->delete_played_after_days = sqlite3_column_int(stmt, 12);
+        podcast->next_refresh = sqlite3_column_int64(stmt, 13);
         
         /* Initialize fields not stored in database */
         podcast->images = NULL;
-        podcast->value = database_load_podcast_value(db, podcast->id);
         
         podcasts = g_list_prepend(podcasts, podcast);
     }
     
     sqlite3_finalize(stmt);
+    
+    database_load_podcast_extras(db, podcasts);
     return g_list_reverse(podcasts);
 }
 
 Podcast* database_get_podcast_by_id(Database *db, gint podcast_id) {
     if (!db || !db->db || podcast_id <= 0) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, title, feed_url, link, description, author, image_url, language, "
-                      "last_updated, last_fetched, auto_download FROM podcasts WHERE id = ?;";
+                      "last_updated, last_fetched, auto_download, keep_episodes, delete_played_after_days, next_refresh "
+                      "FROM podcasts WHERE id = ?;";
     
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
@@ -1441,6 +1946,9 @@ Podcast* database_get_podcast_by_id(Database *db, gint podcast_id) {
         podcast->last_updated = sqlite3_column_int64(stmt, 8);
         podcast->last_fetched = sqlite3_column_int64(stmt, 9);
         podcast->auto_download = sqlite3_column_int(stmt, 10);
+        podcast->keep_episodes = sqlite3_column_int(stmt, 11);
+        podcast->delete_played_after_days = sqlite3_column_int(stmt, 12);
+        podcast->next_refresh = sqlite3_column_int64(stmt, 13);
         
         /* Load funding information */
         podcast->funding = database_load_podcast_funding(db, podcast_id);
@@ -1457,6 +1965,7 @@ Podcast* database_get_podcast_by_id(Database *db, gint podcast_id) {
 /* Funding operations */
 gboolean database_save_episode_funding(Database *db, gint episode_id, GList *funding_list) {
     if (!db || !db->db || episode_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     database_begin_transaction(db);
     
@@ -1500,6 +2009,7 @@ gboolean database_save_episode_funding(Database *db, gint episode_id, GList *fun
 
 GList* database_get_episode_funding(Database *db, gint episode_id) {
     if (!db || !db->db || episode_id <= 0) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT url, message, platform FROM episode_funding WHERE episode_id = ?;";
     
@@ -1523,88 +2033,493 @@ GList* database_get_episode_funding(Database *db, gint episode_id) {
     return g_list_reverse(funding_list);
 }
 
-gboolean database_save_podcast_funding(Database *db, gint podcast_id, GList *funding_list) {
-    if (!db || !db->db || podcast_id <= 0) return FALSE;
-    
-    database_begin_transaction(db);
-    
-    /* First, delete existing funding for this podcast */
-    const char *delete_sql = "DELETE FROM podcast_funding WHERE podcast_id = ?;";
-    sqlite3_stmt *delete_stmt;
-    int rc = sqlite3_prepare_v2(db->db, delete_sql, -1, &delete_stmt, NULL);
-    if (rc == SQLITE_OK) {
-        sqlite3_bind_int(delete_stmt, 1, podcast_id);
-        sqlite3_step(delete_stmt);
-        sqlite3_finalize(delete_stmt);
-    }
-    
-    if (!funding_list) {
-        database_commit_transaction(db);
-        return TRUE; /* No funding to save */
-    }
-    
-    /* Insert new funding entries */
-    const char *insert_sql = "INSERT INTO podcast_funding (podcast_id, url, message, platform) VALUES (?, ?, ?, ?);";
-    sqlite3_stmt *insert_stmt;
-    rc = sqlite3_prepare_v2(db->db, insert_sql, -1, &insert_stmt, NULL);
-    if (rc != SQLITE_OK) {
-        database_rollback_transaction(db);
-        return FALSE;
-    }
+/* Search operations */
+
+/* Turn free text into an FTS5 query: every word must match, as a prefix so
+ * results update while typing. Words are quoted so FTS syntax is inert. */
+static gchar* database_build_match_query(const gchar *text) {
+    gchar **words = g_strsplit_set(text, " \t\n", -1);
+    GString *query = g_string_new("");
     
-    for (GList *l = funding_list; l != NULL; l = l->next) {
-        PodcastFunding *funding = (PodcastFunding *)l->data;
-        if (!funding->url) continue; /* Skip invalid entries */
-        
-        sqlite3_bind_int(insert_stmt, 1, podcast_id);
-        sqlite3_bind_text(insert_stmt, 2, funding->url, -1, SQLITE_STATIC);
-        sqlite3_bind_text(insert_stmt, 3, funding->message, -1, SQLITE_STATIC);
-        sqlite3_bind_text(insert_stmt, 4, funding->platform, -1, SQLITE_STATIC);
+    for (gint i = 0; words[i] != NULL; i++) {
+        if (!*words[i]) continue;
+        gchar **parts = g_strsplit(words[i], "\"", -1);
+        gchar *escaped = g_strjoinv("\"\"", parts);
+        g_strfreev(parts);
         
-        sqlite3_step(insert_stmt);
-        sqlite3_reset(insert_stmt);
+        if (query->len > 0) g_string_append_c(query, ' ');
+        g_string_append_printf(query, "\"%s\"*", escaped);
+        g_free(escaped);
     }
+    g_strfreev(words);
     
-    sqlite3_finalize(insert_stmt);
-    database_commit_transaction(db);
-    return TRUE;
+    if (query->len == 0) {
+        g_string_free(query, TRUE);
+        return NULL;
+    }
+    return g_string_free(query, FALSE);
 }
 
-GList* database_load_podcast_funding(Database *db, gint podcast_id) {
-    if (!db || !db->db || podcast_id <= 0) return NULL;
+/* Without FTS5: the whole text as a substring, with LIKE wildcards escaped */
+static gchar* database_build_like_pattern(const gchar *text) {
+    gchar *stripped = g_strstrip(g_strdup(text));
+    if (!*stripped) {
+        g_free(stripped);
+        return NULL;
+    }
+    
+    GString *pattern = g_string_new("%");
+    for (const gchar *p = stripped; *p; p++) {
+        if (*p == '%' || *p == '_' || *p == '\\') g_string_append_c(pattern, '\\');
+        g_string_append_c(pattern, *p);
+    }
+    g_string_append_c(pattern, '%');
+    g_free(stripped);
+    return g_string_free(pattern, FALSE);
+}
+
+PodcastSearchResults* database_search_podcasts(Database *db, const gchar *text, gint max_episodes) {
+    if (!db || !db->db || !text) return NULL;
+    DATABASE_LOCK_SCOPE(db);
+    
+    gchar *match = db->has_fts5 ? database_build_match_query(text) : database_build_like_pattern(text);
+    if (!match) return NULL;
+    
+    /* Podcast and episode matches come back in one ranked result set; title
+     * hits weigh more than author and description hits */
+    const char *fts_sql = "SELECT 0, rowid, rowid, NULL, 0, 0, NULL, bm25(podcast_search, 4.0, 2.0) AS score "
+                      "FROM podcast_search WHERE podcast_search MATCH ?1 "
+                      "UNION ALL "
+                      "SELECT 1, e.id, e.podcast_id, e.title, e.published_date, e.duration, e.local_file_path, s.score "
+                      "FROM (SELECT rowid AS id, bm25(episode_search, 4.0, 1.0) AS score FROM episode_search "
+                      "WHERE episode_search MATCH ?1 ORDER BY score LIMIT ?2) AS s "
+                      "JOIN podcast_episodes e ON e.id = s.id "
+                      "ORDER BY score;";
+    /* Unranked; newest episodes first */
+    const char *like_sql = "SELECT 0, id, id, NULL, 0, 0, NULL FROM podcasts "
+                           "WHERE title LIKE ?1 ESCAPE '\\' OR author LIKE ?1 ESCAPE '\\' "
+                           "UNION ALL "
+                           "SELECT * FROM (SELECT 1, id, podcast_id, title, published_date, duration, local_file_path "
+                           "FROM podcast_episodes WHERE title LIKE ?1 ESCAPE '\\' "
+                           "OR strip_html(description) LIKE ?1 ESCAPE '\\' "
+                           "ORDER BY published_date DESC LIMIT ?2);";
     
-    const char *sql = "SELECT url, message, platform FROM podcast_funding WHERE podcast_id = ?;";
     sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return NULL;
+    int rc = sqlite3_prepare_v2(db->db, db->has_fts5 ? fts_sql : like_sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_warning("database_search_podcasts: prepare failed: %s", sqlite3_errmsg(db->db));
+        g_free(match);
+        return NULL;
+    }
     
-    sqlite3_bind_int(stmt, 1, podcast_id);
+    sqlite3_bind_text(stmt, 1, match, -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 2, max_episodes > 0 ? max_episodes : -1);
+    
+    PodcastSearchResults *results = g_new0(PodcastSearchResults, 1);
+    GHashTable *seen = g_hash_table_new(g_direct_hash, g_direct_equal);
     
-    GList *funding_list = NULL;
     while (sqlite3_step(stmt) == SQLITE_ROW) {
-        PodcastFunding *funding = g_new0(PodcastFunding, 1);
-        funding->url = g_strdup((const gchar *)sqlite3_column_text(stmt, 0));
-        funding->message = g_strdup((const gchar *)sqlite3_column_text(stmt, 1));
-        funding->platform = g_strdup((const gchar *)sqlite3_column_text(stmt, 2));
+        gint podcast_id = sqlite3_column_int(stmt, 2);
         
-        funding_list = g_list_prepend(funding_list, funding);
+        if (sqlite3_column_int(stmt, 0) == 1) {
+            PodcastEpisode *episode = g_new0(PodcastEpisode, 1);
+            episode->id = sqlite3_column_int(stmt, 1);
+            episode->podcast_id = podcast_id;
+            episode->title = g_strdup((const gchar *)sqlite3_column_text(stmt, 3));
+            episode->published_date = sqlite3_column_int64(stmt, 4);
+            episode->duration = sqlite3_column_int(stmt, 5);
+            episode->local_file_path = g_strdup((const gchar *)sqlite3_column_text(stmt, 6));
+            episode->downloaded = episode->local_file_path != NULL;
+            results->episodes = g_list_prepend(results->episodes, episode);
+        }
+        
+        /* A podcast is a hit when it matches itself or through any episode */
+        if (!g_hash_table_contains(seen, GINT_TO_POINTER(podcast_id))) {
+            g_hash_table_add(seen, GINT_TO_POINTER(podcast_id));
+            results->podcast_ids = g_list_prepend(results->podcast_ids, GINT_TO_POINTER(podcast_id));
+        }
     }
     
     sqlite3_finalize(stmt);
-    return g_list_reverse(funding_list);
+    g_hash_table_destroy(seen);
+    g_free(match);
+    
+    results->episodes = g_list_reverse(results->episodes);
+    results->podcast_ids = g_list_reverse(results->podcast_ids);
+    return results;
 }
 
-gboolean database_save_podcast_value(Database *db, gint podcast_id, GList *value_list) {
-    if (!db || !db->db || podcast_id <= 0) return FALSE;
+void database_search_results_free(PodcastSearchResults *results) {
+    if (!results) return;
+    g_list_free_full(results->episodes, (GDestroyNotify)podcast_episode_free);
+    g_list_free(results->podcast_ids);
+    g_free(results);
+}
+
+/* Segments are merged into passages of about this many bytes, so phrases
+ * spanning word-level JSON segments or short cues still match */
+#define TRANSCRIPT_PASSAGE_LENGTH 300
+
+gboolean database_save_episode_transcript(Database *db, gint episode_id, Transcript *transcript) {
+    if (!db || !db->db || episode_id <= 0 || !transcript) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     database_begin_transaction(db);
     
-    /* First, delete existing values for this podcast */
-    const char *delete_sql = "DELETE FROM podcast_value WHERE podcast_id = ?;";
-    sqlite3_stmt *delete_stmt;
-    int rc = sqlite3_prepare_v2(db->db, delete_sql, -1, &delete_stmt, NULL);
-    if (rc == SQLITE_OK) {
-        sqlite3_bind_int(delete_stmt, 1, podcast_id);
+    const char *delete_sql = "DELETE FROM transcript_passages WHERE episode_id = ?;";
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, delete_sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        database_rollback_transaction(db);
+        return FALSE;
+    }
+    sqlite3_bind_int(stmt, 1, episode_id);
+    sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    
+    const char *insert_sql = "INSERT INTO transcript_passages (episode_id, start_time, text) VALUES (?, ?, ?);";
+    rc = sqlite3_prepare_v2(db->db, insert_sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_warning("database_save_episode_transcript: prepare failed: %s", sqlite3_errmsg(db->db));
+        database_rollback_transaction(db);
+        return FALSE;
+    }
+    
+    gboolean success = TRUE;
+    GString *passage = g_string_new("");
+    gdouble passage_start = 0.0;
+    const gchar *passage_speaker = NULL;
+    
+    for (guint i = 0; i <= transcript->segments->len; i++) {
+        TranscriptSegment *segment = i < transcript->segments->len ?
+            (TranscriptSegment *)g_ptr_array_index(transcript->segments, i) : NULL;
+        
+        /* A passage ends when it is long enough or someone else speaks */
+        if (passage->len > 0 &&
+            (!segment || passage->len >= TRANSCRIPT_PASSAGE_LENGTH ||
+             (segment->speaker && g_strcmp0(segment->speaker, passage_speaker) != 0))) {
+            sqlite3_bind_int(stmt, 1, episode_id);
+            sqlite3_bind_double(stmt, 2, passage_start);
+            sqlite3_bind_text(stmt, 3, passage->str, (int)passage->len, SQLITE_TRANSIENT);
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
+                success = FALSE;
+            }
+            sqlite3_reset(stmt);
+            g_string_truncate(passage, 0);
+        }
+        if (!segment || !segment->text) continue;
+        
+        if (passage->len == 0) {
+            passage_start = segment->start_time;
+            passage_speaker = segment->speaker;
+        } else {
+            g_string_append_c(passage, ' ');
+        }
+        g_string_append(passage, segment->text);
+    }
+    
+    g_string_free(passage, TRUE);
+    sqlite3_finalize(stmt);
+    
+    const char *indexed_sql = "UPDATE podcast_episodes SET transcript_indexed = 1 WHERE id = ?;";
+    rc = sqlite3_prepare_v2(db->db, indexed_sql, -1, &stmt, NULL);
+    if (rc == SQLITE_OK) {
+        sqlite3_bind_int(stmt, 1, episode_id);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            success = FALSE;
+        }
+        sqlite3_finalize(stmt);
+    } else {
+        success = FALSE;
+    }
+    
+    if (success) {
+        database_commit_transaction(db);
+    } else {
+        database_rollback_transaction(db);
+    }
+    return success;
+}
+
+GList* database_get_unindexed_transcript_episodes(Database *db) {
+    if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "SELECT id, podcast_id, transcript_url, transcript_type FROM podcast_episodes "
+                      "WHERE downloaded = 1 AND transcript_indexed = 0 AND transcript_url IS NOT NULL;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_printerr("Failed to prepare statement: %s\n", sqlite3_errmsg(db->db));
+        return NULL;
+    }
+    
+    GList *episodes = NULL;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        PodcastEpisode *episode = g_new0(PodcastEpisode, 1);
+        episode->id = sqlite3_column_int(stmt, 0);
+        episode->podcast_id = sqlite3_column_int(stmt, 1);
+        episode->transcript_url = g_strdup((const gchar *)sqlite3_column_text(stmt, 2));
+        episode->transcript_type = g_strdup((const gchar *)sqlite3_column_text(stmt, 3));
+        episodes = g_list_prepend(episodes, episode);
+    }
+    
+    sqlite3_finalize(stmt);
+    return g_list_reverse(episodes);
+}
+
+GList* database_search_transcripts(Database *db, const gchar *text, gint limit) {
+    if (!db || !db->db || !text) return NULL;
+    DATABASE_LOCK_SCOPE(db);
+    
+    gchar *match = db->has_fts5 ? database_build_match_query(text) : database_build_like_pattern(text);
+    if (!match) return NULL;
+    
+    const char *fts_sql = "SELECT p.episode_id, e.podcast_id, e.title, p.start_time, "
+                      "snippet(transcript_search, 0, '', '', '…', 16), e.downloaded "
+                      "FROM transcript_search "
+                      "JOIN transcript_passages p ON p.id = transcript_search.rowid "
+                      "JOIN podcast_episodes e ON e.id = p.episode_id "
+                      "WHERE transcript_search MATCH ?1 ORDER BY bm25(transcript_search) LIMIT ?2;";
+    /* The whole passage stands in for the snippet */
+    const char *like_sql = "SELECT p.episode_id, e.podcast_id, e.title, p.start_time, p.text, e.downloaded "
+                           "FROM transcript_passages p "
+                           "JOIN podcast_episodes e ON e.id = p.episode_id "
+                           "WHERE p.text LIKE ?1 ESCAPE '\\' LIMIT ?2;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, db->has_fts5 ? fts_sql : like_sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_warning("database_search_transcripts: prepare failed: %s", sqlite3_errmsg(db->db));
+        g_free(match);
+        return NULL;
+    }
+    
+    sqlite3_bind_text(stmt, 1, match, -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 2, limit > 0 ? limit : -1);
+    
+    GList *hits = NULL;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        TranscriptHit *hit = g_new0(TranscriptHit, 1);
+        hit->episode_id = sqlite3_column_int(stmt, 0);
+        hit->podcast_id = sqlite3_column_int(stmt, 1);
+        hit->episode_title = g_strdup((const gchar *)sqlite3_column_text(stmt, 2));
+        hit->start_time = sqlite3_column_double(stmt, 3);
+        hit->snippet = g_strdup((const gchar *)sqlite3_column_text(stmt, 4));
+        hit->downloaded = sqlite3_column_int(stmt, 5) != 0;
+        hits = g_list_prepend(hits, hit);
+    }
+    
+    sqlite3_finalize(stmt);
+    g_free(match);
+    return g_list_reverse(hits);
+}
+
+void transcript_hit_free(TranscriptHit *hit) {
+    if (!hit) return;
+    g_free(hit->episode_title);
+    g_free(hit->snippet);
+    g_free(hit);
+}
+
+/* Embedded chapter operations */
+gint64 database_get_episode_chapters_scanned(Database *db, gint episode_id) {
+    if (!db || !db->db || episode_id <= 0) return 0;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "SELECT chapters_scanned FROM podcast_episodes WHERE id = ?;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) return 0;
+    
+    sqlite3_bind_int(stmt, 1, episode_id);
+    
+    gint64 scanned = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        scanned = sqlite3_column_int64(stmt, 0);
+    }
+    
+    sqlite3_finalize(stmt);
+    return scanned;
+}
+
+GList* database_get_episode_chapters(Database *db, gint episode_id) {
+    if (!db || !db->db || episode_id <= 0) return NULL;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "SELECT start_time, title, img, url FROM episode_chapters "
+                      "WHERE episode_id = ? ORDER BY start_time;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) return NULL;
+    
+    sqlite3_bind_int(stmt, 1, episode_id);
+    
+    GList *chapters = NULL;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        PodcastChapter *chapter = g_new0(PodcastChapter, 1);
+        chapter->start_time = sqlite3_column_double(stmt, 0);
+        chapter->title = g_strdup((const gchar *)sqlite3_column_text(stmt, 1));
+        chapter->img = g_strdup((const gchar *)sqlite3_column_text(stmt, 2));
+        chapter->url = g_strdup((const gchar *)sqlite3_column_text(stmt, 3));
+        
+        chapters = g_list_prepend(chapters, chapter);
+    }
+    
+    sqlite3_finalize(stmt);
+    return g_list_reverse(chapters);
+}
+
+gboolean database_save_episode_chapters(Database *db, gint episode_id, GList *chapters, gint64 scanned_mtime) {
+    if (!db || !db->db || episode_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    
+    database_begin_transaction(db);
+    
+    const char *delete_sql = "DELETE FROM episode_chapters WHERE episode_id = ?;";
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, delete_sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        database_rollback_transaction(db);
+        return FALSE;
+    }
+    sqlite3_bind_int(stmt, 1, episode_id);
+    sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    
+    const char *insert_sql = "INSERT INTO episode_chapters (episode_id, start_time, title, img, url) "
+                             "VALUES (?, ?, ?, ?, ?);";
+    rc = sqlite3_prepare_v2(db->db, insert_sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        database_rollback_transaction(db);
+        return FALSE;
+    }
+    
+    gboolean success = TRUE;
+    for (GList *l = chapters; l != NULL; l = l->next) {
+        PodcastChapter *chapter = (PodcastChapter *)l->data;
+        sqlite3_bind_int(stmt, 1, episode_id);
+        sqlite3_bind_double(stmt, 2, chapter->start_time);
+        sqlite3_bind_text(stmt, 3, chapter->title, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 4, chapter->img, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 5, chapter->url, -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            success = FALSE;
+        }
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+    
+    /* Remember which version of the file these came from, even when it had none */
+    const char *scanned_sql = "UPDATE podcast_episodes SET chapters_scanned = ? WHERE id = ?;";
+    rc = sqlite3_prepare_v2(db->db, scanned_sql, -1, &stmt, NULL);
+    if (rc == SQLITE_OK) {
+        sqlite3_bind_int64(stmt, 1, scanned_mtime);
+        sqlite3_bind_int(stmt, 2, episode_id);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            success = FALSE;
+        }
+        sqlite3_finalize(stmt);
+    } else {
+        success = FALSE;
+    }
+    
+    if (success) {
+        database_commit_transaction(db);
+    } else {
+        database_rollback_transaction(db);
+    }
+    return success;
+}
+
+gboolean database_save_podcast_funding(Database *db, gint podcast_id, GList *funding_list) {
+    if (!db || !db->db || podcast_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    
+    database_begin_transaction(db);
+    
+    /* First, delete existing funding for this podcast */
+    const char *delete_sql = "DELETE FROM podcast_funding WHERE podcast_id = ?;";
+    sqlite3_stmt *delete_stmt;
+    int rc = sqlite3_prepare_v2(db->db, delete_sql, -1, &delete_stmt, NULL);
+    if (rc == SQLITE_OK) {
+        sqlite3_bind_int(delete_stmt, 1, podcast_id);
+        sqlite3_step(delete_stmt);
+        sqlite3_finalize(delete_stmt);
+    }
+    
+    if (!funding_list) {
+        database_commit_transaction(db);
+        return TRUE; /* No funding to save */
+    }
+    
+    /* Insert new funding entries */
+    const char *insert_sql = "INSERT INTO podcast_funding (podcast_id, url, message, platform) VALUES (?, ?, ?, ?);";
+    sqlite3_stmt *insert_stmt;
+    rc = sqlite3_prepare_v2(db->db, insert_sql, -1, &insert_stmt, NULL);
+    if (rc != SQLITE_OK) {
+        database_rollback_transaction(db);
+        return FALSE;
+    }
+    
+    for (GList *l = funding_list; l != NULL; l = l->next) {
+        PodcastFunding *funding = (PodcastFunding *)l->data;
+        if (!funding->url) continue; /* Skip invalid entries */
+        
+        sqlite3_bind_int(insert_stmt, 1, podcast_id);
+        sqlite3_bind_text(insert_stmt, 2, funding->url, -1, SQLITE_STATIC);
+        sqlite3_bind_text(insert_stmt, 3, funding->message, -1, SQLITE_STATIC);
+        sqlite3_bind_text(insert_stmt, 4, funding->platform, -1, SQLITE_STATIC);
+        
+        sqlite3_step(insert_stmt);
+        sqlite3_reset(insert_stmt);
+    }
+    
+    sqlite3_finalize(insert_stmt);
+    database_commit_transaction(db);
+    return TRUE;
+}
+
+GList* database_load_podcast_funding(Database *db, gint podcast_id) {
+    if (!db || !db->db || podcast_id <= 0) return NULL;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "SELECT url, message, platform FROM podcast_funding WHERE podcast_id = ?;";
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) return NULL;
+    
+    sqlite3_bind_int(stmt, 1, podcast_id);
+    
+    GList *funding_list = NULL;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        PodcastFunding *funding = g_new0(PodcastFunding, 1);
+        funding->url = g_strdup((const gchar *)sqlite3_column_text(stmt, 0));
+        funding->message = g_strdup((const gchar *)sqlite3_column_text(stmt, 1));
+        funding->platform = g_strdup((const gchar *)sqlite3_column_text(stmt, 2));
+        
+        funding_list = g_list_prepend(funding_list, funding);
+    }
+    
+    sqlite3_finalize(stmt);
+    return g_list_reverse(funding_list);
+}
+
+gboolean database_save_podcast_value(Database *db, gint podcast_id, GList *value_list) {
+    if (!db || !db->db || podcast_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    
+    database_begin_transaction(db);
+    
+    /* First, delete existing values for this podcast */
+    const char *delete_sql = "DELETE FROM podcast_value WHERE podcast_id = ?;";
+    sqlite3_stmt *delete_stmt;
+    int rc = sqlite3_prepare_v2(db->db, delete_sql, -1, &delete_stmt, NULL);
+    if (rc == SQLITE_OK) {
+        sqlite3_bind_int(delete_stmt, 1, podcast_id);
         sqlite3_step(delete_stmt);
         sqlite3_finalize(delete_stmt);
     }
@@ -1678,6 +2593,7 @@ gboolean database_save_podcast_value(Database *db, gint podcast_id, GList *value
 
 gboolean database_save_episode_value(Database *db, gint episode_id, GList *value_list) {
     if (!db || !db->db || episode_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     database_begin_transaction(db);
     
@@ -1760,6 +2676,7 @@ gboolean database_save_episode_value(Database *db, gint episode_id, GList *value
 
 GList* database_load_podcast_value(Database *db, gint podcast_id) {
     if (!db || !db->db || podcast_id <= 0) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, type, method, suggested FROM podcast_value WHERE podcast_id = ?;";
     sqlite3_stmt *stmt;
@@ -1810,6 +2727,7 @@ GList* database_load_podcast_value(Database *db, gint podcast_id) {
 
 GList* database_load_episode_value(Database *db, gint episode_id) {
     if (!db || !db->db || episode_id <= 0) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, type, method, suggested FROM episode_value WHERE episode_id = ?;";
     sqlite3_stmt *stmt;
@@ -1860,6 +2778,7 @@ GList* database_load_episode_value(Database *db, gint episode_id) {
 
 gboolean database_update_episode_downloaded(Database *db, gint episode_id, const gchar *local_path) {
     if (!db || !db->db || episode_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "UPDATE podcast_episodes SET downloaded=1, local_file_path=? WHERE id=?;";
     
@@ -1881,8 +2800,12 @@ gboolean database_update_episode_downloaded(Database *db, gint episode_id, const
 
 gboolean database_update_episode_progress(Database *db, gint episode_id, gint position, gboolean played) {
     if (!db || !db->db || episode_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
-    const char *sql = "UPDATE podcast_episodes SET play_position=?, played=? WHERE id=?;";
+    /* played_date records when the episode was first marked played, for retention */
+    const char *sql = "UPDATE podcast_episodes SET play_position=?1, played=?2, "
+                      "played_date=CASE WHEN ?2 THEN COALESCE(NULLIF(played_date, 0), ?4) ELSE 0 END "
+                      "WHERE id=?3;";
     
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
@@ -1894,6 +2817,7 @@ gboolean database_update_episode_progress(Database *db, gint episode_id, gint po
     sqlite3_bind_int(stmt, 1, position);
     sqlite3_bind_int(stmt, 2, played ? 1 : 0);
     sqlite3_bind_int(stmt, 3, episode_id);
+    sqlite3_bind_int64(stmt, 4, g_get_real_time() / G_USEC_PER_SEC);
     
     rc = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
@@ -1903,6 +2827,7 @@ gboolean database_update_episode_progress(Database *db, gint episode_id, gint po
 
 gboolean database_delete_podcast(Database *db, gint podcast_id) {
     if (!db || !db->db || podcast_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     database_begin_transaction(db);
     
@@ -1920,6 +2845,12 @@ gboolean database_delete_podcast(Database *db, gint podcast_id) {
         "(SELECT id FROM podcast_episodes WHERE podcast_id=?));";
     
     /* Delete episode-level child tables */
+    const char *sql_delete_download_queue =
+        "DELETE FROM download_queue WHERE episode_id IN "
+        "(SELECT id FROM podcast_episodes WHERE podcast_id=?);";
+    const char *sql_delete_episode_chapters =
+        "DELETE FROM episode_chapters WHERE episode_id IN "
+        "(SELECT id FROM podcast_episodes WHERE podcast_id=?);";
     const char *sql_delete_episode_funding =
         "DELETE FROM episode_funding WHERE episode_id IN "
         "(SELECT id FROM podcast_episodes WHERE podcast_id=?);";
@@ -1943,6 +2874,8 @@ gboolean database_delete_podcast(Database *db, gint podcast_id) {
     const char *queries[] = {
         sql_delete_podcast_recipients,
         sql_delete_episode_recipients,
+        sql_delete_download_queue,
+        sql_delete_episode_chapters,
         sql_delete_episode_funding,
         sql_delete_episode_value,
         sql_delete_content_links,
@@ -1985,7 +2918,298 @@ gboolean database_delete_podcast(Database *db, gint podcast_id) {
 gboolean database_clear_episode_download(Database *db, gint episode_id) {
     if (!db || !db->db || episode_id <= 0) return FALSE;
     
-    const char *sql = "UPDATE podcast_episodes SET downloaded=0, local_file_path=NULL WHERE id=?;";
+    GList *ids = g_list_prepend(NULL, GINT_TO_POINTER(episode_id));
+    gboolean success = database_clear_episode_downloads(db, ids);
+    g_list_free(ids);
+    return success;
+}
+
+gboolean database_clear_episode_downloads(Database *db, GList *episode_ids) {
+    if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    if (!episode_ids) return TRUE;
+    
+    /* The transcript index only covers downloaded episodes */
+    const char *sql = "UPDATE podcast_episodes SET downloaded=0, local_file_path=NULL, transcript_indexed=0 WHERE id=?;";
+    const char *passages_sql = "DELETE FROM transcript_passages WHERE episode_id=?;";
+    
+    sqlite3_stmt *stmt;
+    sqlite3_stmt *passages_stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_warning("database_clear_episode_downloads: prepare failed: %s", sqlite3_errmsg(db->db));
+        return FALSE;
+    }
+    rc = sqlite3_prepare_v2(db->db, passages_sql, -1, &passages_stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_warning("database_clear_episode_downloads: prepare failed: %s", sqlite3_errmsg(db->db));
+        sqlite3_finalize(stmt);
+        return FALSE;
+    }
+    
+    database_begin_transaction(db);
+    
+    gboolean success = TRUE;
+    for (GList *l = episode_ids; l != NULL; l = l->next) {
+        sqlite3_bind_int(stmt, 1, GPOINTER_TO_INT(l->data));
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            success = FALSE;
+        }
+        sqlite3_reset(stmt);
+        
+        sqlite3_bind_int(passages_stmt, 1, GPOINTER_TO_INT(l->data));
+        if (sqlite3_step(passages_stmt) != SQLITE_DONE) {
+            success = FALSE;
+        }
+        sqlite3_reset(passages_stmt);
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_finalize(passages_stmt);
+    
+    if (success) {
+        database_commit_transaction(db);
+    } else {
+        database_rollback_transaction(db);
+    }
+    return success;
+}
+
+/* Auto-download and retention */
+gboolean database_set_podcast_download_settings(Database *db, gint podcast_id, gboolean auto_download,
+                                                gint keep_episodes, gint delete_played_after_days) {
+    if (!db || !db->db || podcast_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    
+    /* Switching auto-download on starts from the newest episode already known,
+     * so enabling it doesn't pull in the whole back catalogue */
+    const char *sql = "UPDATE podcasts SET "
+                      "auto_download_since=CASE WHEN ?1 AND auto_download=0 THEN "
+                      "(SELECT COALESCE(MAX(published_date), 0) FROM podcast_episodes WHERE podcast_id=?4) "
+                      "ELSE auto_download_since END, "
+                      "auto_download=?1, keep_episodes=?2, delete_played_after_days=?3 WHERE id=?4;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_warning("database_set_podcast_download_settings: prepare failed: %s", sqlite3_errmsg(db->db));
+        return FALSE;
+    }
+    
+    sqlite3_bind_int(stmt, 1, auto_download ? 1 : 0);
+    sqlite3_bind_int(stmt, 2, MAX(0, keep_episodes));
+    sqlite3_bind_int(stmt, 3, MAX(0, delete_played_after_days));
+    sqlite3_bind_int(stmt, 4, podcast_id);
+    
+    rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    
+    return (rc == SQLITE_DONE);
+}
+
+gboolean database_set_podcast_refresh(Database *db, gint podcast_id, gint64 last_fetched, gint64 next_refresh) {
+    if (!db || !db->db || podcast_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "UPDATE podcasts SET last_fetched = COALESCE(?, last_fetched), next_refresh = ? WHERE id = ?;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_warning("database_set_podcast_refresh: prepare failed: %s", sqlite3_errmsg(db->db));
+        return FALSE;
+    }
+    
+    /* A failed fetch leaves last_fetched alone */
+    if (last_fetched > 0) {
+        sqlite3_bind_int64(stmt, 1, last_fetched);
+    } else {
+        sqlite3_bind_null(stmt, 1);
+    }
+    sqlite3_bind_int64(stmt, 2, next_refresh);
+    sqlite3_bind_int(stmt, 3, podcast_id);
+    
+    rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    
+    return (rc == SQLITE_DONE);
+}
+
+GArray* database_get_episode_publish_dates(Database *db, gint podcast_id, gint limit) {
+    if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "SELECT published_date FROM podcast_episodes "
+                      "WHERE podcast_id = ? AND published_date > 0 "
+                      "ORDER BY published_date DESC LIMIT ?;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) return NULL;
+    
+    sqlite3_bind_int(stmt, 1, podcast_id);
+    sqlite3_bind_int(stmt, 2, limit);
+    
+    GArray *dates = g_array_new(FALSE, FALSE, sizeof(gint64));
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        gint64 date = sqlite3_column_int64(stmt, 0);
+        g_array_append_val(dates, date);
+    }
+    
+    sqlite3_finalize(stmt);
+    return dates;
+}
+
+GList* database_get_auto_download_episodes(Database *db) {
+    if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
+    
+    /* New, untouched episodes of auto-download podcasts. With a keep limit,
+     * only the newest keep_episodes candidates are worth fetching. */
+    const char *sql = "SELECT id, podcast_id, title, enclosure_url, enclosure_length FROM ("
+                      "SELECT e.id, e.podcast_id, e.title, e.enclosure_url, e.enclosure_length, "
+                      "e.published_date, p.keep_episodes, "
+                      "ROW_NUMBER() OVER (PARTITION BY e.podcast_id ORDER BY e.published_date DESC) AS rn "
+                      "FROM podcast_episodes e JOIN podcasts p ON p.id = e.podcast_id "
+                      "WHERE p.auto_download=1 AND e.downloaded=0 AND e.played=0 AND e.auto_queued=0 "
+                      "AND e.enclosure_url IS NOT NULL AND e.published_date > p.auto_download_since) "
+                      "WHERE keep_episodes=0 OR rn <= keep_episodes "
+                      "ORDER BY published_date DESC;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_printerr("Failed to prepare statement: %s\n", sqlite3_errmsg(db->db));
+        return NULL;
+    }
+    
+    GList *episodes = NULL;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        PodcastEpisode *episode = g_new0(PodcastEpisode, 1);
+        episode->id = sqlite3_column_int(stmt, 0);
+        episode->podcast_id = sqlite3_column_int(stmt, 1);
+        episode->title = g_strdup((const gchar *)sqlite3_column_text(stmt, 2));
+        episode->enclosure_url = g_strdup((const gchar *)sqlite3_column_text(stmt, 3));
+        episode->enclosure_length = sqlite3_column_int64(stmt, 4);
+        episodes = g_list_prepend(episodes, episode);
+    }
+    
+    sqlite3_finalize(stmt);
+    return g_list_reverse(episodes);
+}
+
+gboolean database_mark_episodes_auto_queued(Database *db, GList *episode_ids) {
+    if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    if (!episode_ids) return TRUE;
+    
+    const char *sql = "UPDATE podcast_episodes SET auto_queued=1 WHERE id=?;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) return FALSE;
+    
+    database_begin_transaction(db);
+    for (GList *l = episode_ids; l != NULL; l = l->next) {
+        sqlite3_bind_int(stmt, 1, GPOINTER_TO_INT(l->data));
+        sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+    
+    return database_commit_transaction(db);
+}
+
+GList* database_get_expired_episode_downloads(Database *db) {
+    if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
+    
+    /* Downloaded episodes past their podcast's retention rules: beyond the
+     * newest keep_episodes downloads, or played longer ago than allowed */
+    const char *sql = "SELECT id, podcast_id, local_file_path FROM ("
+                      "SELECT e.id, e.podcast_id, e.local_file_path, e.played, e.played_date, "
+                      "p.keep_episodes, p.delete_played_after_days, "
+                      "ROW_NUMBER() OVER (PARTITION BY e.podcast_id ORDER BY e.published_date DESC) AS rn "
+                      "FROM podcast_episodes e JOIN podcasts p ON p.id = e.podcast_id "
+                      "WHERE e.downloaded=1) "
+                      "WHERE (keep_episodes > 0 AND rn > keep_episodes) "
+                      "OR (delete_played_after_days > 0 AND played=1 AND played_date > 0 "
+                      "AND played_date <= ?1 - delete_played_after_days * 86400);";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_printerr("Failed to prepare statement: %s\n", sqlite3_errmsg(db->db));
+        return NULL;
+    }
+    
+    sqlite3_bind_int64(stmt, 1, g_get_real_time() / G_USEC_PER_SEC);
+    
+    GList *episodes = NULL;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        PodcastEpisode *episode = g_new0(PodcastEpisode, 1);
+        episode->id = sqlite3_column_int(stmt, 0);
+        episode->podcast_id = sqlite3_column_int(stmt, 1);
+        episode->local_file_path = g_strdup((const gchar *)sqlite3_column_text(stmt, 2));
+        episodes = g_list_prepend(episodes, episode);
+    }
+    
+    sqlite3_finalize(stmt);
+    return g_list_reverse(episodes);
+}
+
+/* Download queue operations */
+gboolean database_enqueue_download(Database *db, gint episode_id, gint priority) {
+    if (!db || !db->db || episode_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    
+    /* Re-queueing keeps the retry state but never lowers the priority */
+    const char *sql = "INSERT INTO download_queue (episode_id, priority, date_added) VALUES (?, ?, ?) "
+                      "ON CONFLICT(episode_id) DO UPDATE SET priority=MAX(priority, excluded.priority);";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_printerr("Failed to prepare statement: %s\n", sqlite3_errmsg(db->db));
+        return FALSE;
+    }
+    
+    sqlite3_bind_int(stmt, 1, episode_id);
+    sqlite3_bind_int(stmt, 2, priority);
+    sqlite3_bind_int64(stmt, 3, g_get_real_time() / 1000000);
+    
+    rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    
+    return (rc == SQLITE_DONE);
+}
+
+gboolean database_update_download_retry(Database *db, gint episode_id, gint attempts,
+                                        gint64 next_attempt, const gchar *last_error) {
+    if (!db || !db->db || episode_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "UPDATE download_queue SET attempts=?, next_attempt=?, last_error=? WHERE episode_id=?;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) return FALSE;
+    
+    sqlite3_bind_int(stmt, 1, attempts);
+    sqlite3_bind_int64(stmt, 2, next_attempt);
+    sqlite3_bind_text(stmt, 3, last_error, -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 4, episode_id);
+    
+    rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    
+    return (rc == SQLITE_DONE);
+}
+
+gboolean database_remove_download(Database *db, gint episode_id) {
+    if (!db || !db->db || episode_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "DELETE FROM download_queue WHERE episode_id=?;";
     
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
@@ -1999,6 +3223,34 @@ gboolean database_clear_episode_download(Database *db, gint episode_id) {
     return (rc == SQLITE_DONE);
 }
 
+GList* database_get_download_queue(Database *db) {
+    if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
+    
+    const char *sql = "SELECT episode_id, priority, attempts, next_attempt FROM download_queue "
+                      "ORDER BY priority DESC, date_added ASC;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        g_printerr("Failed to prepare statement: %s\n", sqlite3_errmsg(db->db));
+        return NULL;
+    }
+    
+    GList *entries = NULL;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        DownloadQueueEntry *entry = g_new0(DownloadQueueEntry, 1);
+        entry->episode_id = sqlite3_column_int(stmt, 0);
+        entry->priority = sqlite3_column_int(stmt, 1);
+        entry->attempts = sqlite3_column_int(stmt, 2);
+        entry->next_attempt = sqlite3_column_int64(stmt, 3);
+        entries = g_list_prepend(entries, entry);
+    }
+    
+    sqlite3_finalize(stmt);
+    return g_list_reverse(entries);
+}
+
 /* Preference operations */
 gboolean database_set_preference(Database *db, const gchar *key, const gchar *value) {
     if (!db || !db->db || !key) {
@@ -2006,6 +3258,8 @@ gboolean database_set_preference(Database *db, const gchar *key, const gchar *va
         return FALSE;
     }
     
+    DATABASE_LOCK_SCOPE(db);
+    
     const char *sql = "INSERT OR REPLACE INTO preferences (key, value) VALUES (?, ?);";
     
     sqlite3_stmt *stmt;
@@ -2050,6 +3304,8 @@ gchar* database_get_preference(Database *db, const gchar *key, const gchar *defa
         return g_strdup(default_value);
     }
     
+    DATABASE_LOCK_SCOPE(db);
+    
     const char *sql = "SELECT value FROM preferences WHERE key = ?;";
     
     sqlite3_stmt *stmt;
@@ -2113,6 +3369,7 @@ gdouble database_get_preference_double(Database *db, const gchar *key, gdouble d
 /* Live item database operations */
 gboolean database_save_podcast_live_items(Database *db, gint podcast_id, GList *live_items) {
     if (!db || !db->db || podcast_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     database_begin_transaction(db);
     
@@ -2191,6 +3448,7 @@ gboolean database_save_podcast_live_items(Database *db, gint podcast_id, GList *
 
 GList* database_load_podcast_live_items(Database *db, gint podcast_id) {
     if (!db || !db->db || podcast_id <= 0) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT id, guid, title, description, enclosure_url, enclosure_type, "
                       "enclosure_length, start_time, end_time, status, image_url "
@@ -2243,6 +3501,7 @@ GList* database_load_podcast_live_items(Database *db, gint podcast_id) {
 
 gboolean database_has_active_live_item(Database *db, gint podcast_id) {
     if (!db || !db->db || podcast_id <= 0) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
     
     const char *sql = "SELECT COUNT(*) FROM podcast_live_items WHERE podcast_id = ? AND status = 'live';";
     
@@ -2271,6 +3530,7 @@ void database_browse_result_free(DatabaseBrowseResult *result) {
 
 static GList* database_browse_query(Database *db, const char *sql, const gchar *bind_text) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
@@ -2333,6 +3593,7 @@ GList* database_browse_years(Database *db) {
 
 static GList* database_distinct_query(Database *db, const char *sql, const gchar *bind_text) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
     
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL);
@@ -0,0 +1,379 @@
+#include "feednotifier.h"
+#include <curl/curl.h>
+#include <json-glib/json-glib.h>
+#include <string.h>
+
+FeedNotifier* feed_notifier_new(const FeedNotifierClass *klass, gsize size) {
+    g_return_val_if_fail(klass != NULL && size >= sizeof(FeedNotifier), NULL);
+    
+    FeedNotifier *notifier = g_malloc0(size);
+    notifier->klass = klass;
+    g_atomic_ref_count_init(&notifier->ref_count);
+    return notifier;
+}
+
+FeedNotifier* feed_notifier_ref(FeedNotifier *notifier) {
+    g_atomic_ref_count_inc(&notifier->ref_count);
+    return notifier;
+}
+
+void feed_notifier_unref(FeedNotifier *notifier) {
+    if (!notifier || !g_atomic_ref_count_dec(&notifier->ref_count)) return;
+    
+    if (notifier->klass->finalize) {
+        notifier->klass->finalize(notifier);
+    }
+    if (notifier->context) {
+        g_main_context_unref(notifier->context);
+    }
+    g_free(notifier);
+}
+
+const gchar* feed_notifier_get_name(FeedNotifier *notifier) {
+    return notifier ? notifier->klass->name : NULL;
+}
+
+gboolean feed_notifier_start(FeedNotifier *notifier, FeedChangedCallback callback,
+                             gpointer user_data, GError **error) {
+    g_return_val_if_fail(notifier != NULL, FALSE);
+    
+    if (g_atomic_int_get(&notifier->running)) return TRUE;
+    
+    notifier->callback = callback;
+    notifier->user_data = user_data;
+    if (!notifier->context) {
+        notifier->context = g_main_context_ref_thread_default();
+    }
+    
+    g_atomic_int_set(&notifier->running, TRUE);
+    if (notifier->klass->start && !notifier->klass->start(notifier, error)) {
+        g_atomic_int_set(&notifier->running, FALSE);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* After this returns the callback is never called again */
+void feed_notifier_stop(FeedNotifier *notifier) {
+    if (!notifier || !g_atomic_int_get(&notifier->running)) return;
+    
+    g_atomic_int_set(&notifier->running, FALSE);
+    if (notifier->klass->stop) {
+        notifier->klass->stop(notifier);
+    }
+}
+
+typedef struct {
+    FeedNotifier *notifier;
+    gchar *feed_url;
+} FeedChange;
+
+static void feed_change_free(gpointer data) {
+    FeedChange *change = (FeedChange *)data;
+    feed_notifier_unref(change->notifier);
+    g_free(change->feed_url);
+    g_free(change);
+}
+
+static gboolean feed_change_dispatch(gpointer user_data) {
+    FeedChange *change = (FeedChange *)user_data;
+    FeedNotifier *notifier = change->notifier;
+    
+    /* Notifications still queued when the notifier was stopped are dropped */
+    if (g_atomic_int_get(&notifier->running) && notifier->callback) {
+        notifier->callback(change->feed_url, notifier->user_data);
+    }
+    return G_SOURCE_REMOVE;
+}
+
+void feed_notifier_emit(FeedNotifier *notifier, const gchar *feed_url) {
+    if (!notifier || !feed_url || !*feed_url || !notifier->context) return;
+    
+    FeedChange *change = g_new0(FeedChange, 1);
+    change->notifier = feed_notifier_ref(notifier);
+    change->feed_url = g_strdup(feed_url);
+    g_main_context_invoke_full(notifier->context, G_PRIORITY_DEFAULT,
+                               feed_change_dispatch, change, feed_change_free);
+}
+
+/* Podping payloads list changed feeds under "iris" (v1.0) or "urls" (v0.x) */
+static void feed_notifier_handle_json(FeedNotifier *notifier, const gchar *json) {
+    JsonParser *parser = json_parser_new();
+    
+    if (json_parser_load_from_data(parser, json, -1, NULL)) {
+        JsonNode *root = json_parser_get_root(parser);
+        if (root && JSON_NODE_HOLDS_OBJECT(root)) {
+            JsonObject *object = json_node_get_object(root);
+            const gchar *members[] = { "iris", "urls" };
+            
+            for (gsize i = 0; i < G_N_ELEMENTS(members); i++) {
+                if (!json_object_has_member(object, members[i])) continue;
+                
+                JsonArray *array = json_object_get_array_member(object, members[i]);
+                guint length = array ? json_array_get_length(array) : 0;
+                for (guint j = 0; j < length; j++) {
+                    feed_notifier_emit(notifier, json_array_get_string_element(array, j));
+                }
+            }
+        }
+    }
+    
+    g_object_unref(parser);
+}
+
+void feed_notifier_handle_line(FeedNotifier *notifier, const gchar *line) {
+    if (!notifier || !line) return;
+    
+    gchar *text = g_strstrip(g_strdup(line));
+    const gchar *payload = text;
+    
+    /* Server-Sent Events framing; other SSE fields (event:, id:) are ignored */
+    if (g_str_has_prefix(payload, "data:")) {
+        payload += 5;
+        while (*payload == ' ') payload++;
+    }
+    
+    if (payload[0] == '{') {
+        feed_notifier_handle_json(notifier, payload);
+    } else if (g_str_has_prefix(payload, "http://") || g_str_has_prefix(payload, "https://")) {
+        feed_notifier_emit(notifier, payload);
+    }
+    
+    g_free(text);
+}
+
+/* HTTP stream backend. A worker thread holds a long-lived connection to a
+ * podping/WebSub-style relay that writes one notification per line, and
+ * reconnects with exponential backoff when the stream drops. */
+
+#define STREAM_BACKOFF_MIN 5
+#define STREAM_BACKOFF_MAX 300
+
+typedef struct {
+    FeedNotifier parent;
+    gchar *url;
+    GThread *thread;
+    GMutex mutex;
+    GCond cond;          /* Wakes the backoff wait on stop */
+    GString *line;       /* Partial line, worker thread only */
+} StreamNotifier;
+
+static size_t stream_write_callback(void *contents, size_t size, size_t nmemb, void *userp) {
+    size_t len = size * nmemb;
+    StreamNotifier *self = (StreamNotifier *)userp;
+    
+    if (!g_atomic_int_get(&self->parent.running)) return 0;
+    
+    g_string_append_len(self->line, contents, len);
+    
+    gchar *newline;
+    while ((newline = memchr(self->line->str, '\n', self->line->len))) {
+        *newline = '\0';
+        feed_notifier_handle_line(&self->parent, self->line->str);
+        g_string_erase(self->line, 0, newline - self->line->str + 1);
+    }
+    return len;
+}
+
+static int stream_progress_callback(void *clientp, curl_off_t dltotal, curl_off_t dlnow,
+                                    curl_off_t ultotal, curl_off_t ulnow) {
+    (void)dltotal; (void)dlnow; (void)ultotal; (void)ulnow;
+    StreamNotifier *self = (StreamNotifier *)clientp;
+    return g_atomic_int_get(&self->parent.running) ? 0 : 1;
+}
+
+static gpointer stream_notifier_thread(gpointer data) {
+    StreamNotifier *self = (StreamNotifier *)data;
+    gint backoff = STREAM_BACKOFF_MIN;
+    
+    while (g_atomic_int_get(&self->parent.running)) {
+        CURL *curl = curl_easy_init();
+        if (!curl) break;
+        
+        curl_easy_setopt(curl, CURLOPT_URL, self->url);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, stream_write_callback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, self);
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, "Shriek/1.0 (Podcast 2.0)");
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 30L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        /* A relay that goes silent for five minutes is treated as dropped */
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 300L);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, stream_progress_callback);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, self);
+        
+        gint64 connected_at = g_get_monotonic_time();
+        CURLcode res = curl_easy_perform(curl);
+        curl_easy_cleanup(curl);
+        g_string_truncate(self->line, 0);
+        
+        if (!g_atomic_int_get(&self->parent.running)) break;
+        
+        /* A stream that stayed up for a while resets the backoff */
+        if (g_get_monotonic_time() - connected_at > (gint64)STREAM_BACKOFF_MAX * G_USEC_PER_SEC) {
+            backoff = STREAM_BACKOFF_MIN;
+        }
+        g_debug("Feed notification stream '%s' closed (%s), reconnecting in %d s",
+                self->url, curl_easy_strerror(res), backoff);
+        
+        g_mutex_lock(&self->mutex);
+        gint64 wake = g_get_monotonic_time() + (gint64)backoff * G_USEC_PER_SEC;
+        while (g_atomic_int_get(&self->parent.running) &&
+               g_cond_wait_until(&self->cond, &self->mutex, wake)) {
+            /* Spurious wakeup, keep waiting */
+        }
+        g_mutex_unlock(&self->mutex);
+        
+        backoff = MIN(backoff * 2, STREAM_BACKOFF_MAX);
+    }
+    
+    return NULL;
+}
+
+static gboolean stream_notifier_start(FeedNotifier *notifier, GError **error) {
+    StreamNotifier *self = (StreamNotifier *)notifier;
+    
+    self->thread = g_thread_try_new("feed-notifier", stream_notifier_thread, self, error);
+    return self->thread != NULL;
+}
+
+static void stream_notifier_stop(FeedNotifier *notifier) {
+    StreamNotifier *self = (StreamNotifier *)notifier;
+    
+    g_mutex_lock(&self->mutex);
+    g_cond_signal(&self->cond);
+    g_mutex_unlock(&self->mutex);
+    
+    if (self->thread) {
+        g_thread_join(self->thread);
+        self->thread = NULL;
+    }
+}
+
+static void stream_notifier_finalize(FeedNotifier *notifier) {
+    StreamNotifier *self = (StreamNotifier *)notifier;
+    
+    g_free(self->url);
+    g_string_free(self->line, TRUE);
+    g_mutex_clear(&self->mutex);
+    g_cond_clear(&self->cond);
+}
+
+static const FeedNotifierClass stream_notifier_class = {
+    "stream",
+    stream_notifier_start,
+    stream_notifier_stop,
+    stream_notifier_finalize
+};
+
+FeedNotifier* feed_notifier_stream_new(const gchar *url) {
+    g_return_val_if_fail(url != NULL, NULL);
+    
+    StreamNotifier *self = (StreamNotifier *)feed_notifier_new(&stream_notifier_class, sizeof(StreamNotifier));
+    self->url = g_strdup(url);
+    self->line = g_string_new(NULL);
+    g_mutex_init(&self->mutex);
+    g_cond_init(&self->cond);
+    return &self->parent;
+}
+
+/* File backend, a local stand-in for offline testing: every line appended
+ * to the file is handled like a line of the stream, e.g.
+ *   echo https://example.com/feed.xml >> podping.txt */
+
+typedef struct {
+    FeedNotifier parent;
+    GFile *file;
+    GFileMonitor *monitor;
+    goffset offset;      /* Bytes already handled */
+} FileNotifier;
+
+static void file_notifier_read(FileNotifier *self) {
+    gchar *contents = NULL;
+    gsize length = 0;
+    
+    if (!g_file_load_contents(self->file, NULL, &contents, &length, NULL, NULL)) {
+        self->offset = 0;
+        return;
+    }
+    
+    /* Truncated or replaced: start over */
+    if ((goffset)length < self->offset) {
+        self->offset = 0;
+    }
+    
+    /* Only complete lines; a partial last line waits for the next change */
+    gchar *start = contents + self->offset;
+    gchar *end = contents + length;
+    gchar *newline;
+    while (start < end && (newline = memchr(start, '\n', end - start))) {
+        *newline = '\0';
+        feed_notifier_handle_line(&self->parent, start);
+        start = newline + 1;
+    }
+    self->offset = start - contents;
+    
+    g_free(contents);
+}
+
+static void on_notifier_file_changed(GFileMonitor *monitor, GFile *file, GFile *other_file,
+                                     GFileMonitorEvent event_type, gpointer user_data) {
+    (void)monitor; (void)file; (void)other_file;
+    
+    if (event_type == G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT ||
+        event_type == G_FILE_MONITOR_EVENT_CREATED) {
+        file_notifier_read((FileNotifier *)user_data);
+    }
+}
+
+static gboolean file_notifier_start(FeedNotifier *notifier, GError **error) {
+    FileNotifier *self = (FileNotifier *)notifier;
+    
+    self->monitor = g_file_monitor_file(self->file, G_FILE_MONITOR_NONE, NULL, error);
+    if (!self->monitor) return FALSE;
+    
+    /* Lines written before we started are not news */
+    GFileInfo *info = g_file_query_info(self->file, G_FILE_ATTRIBUTE_STANDARD_SIZE,
+                                        G_FILE_QUERY_INFO_NONE, NULL, NULL);
+    self->offset = info ? g_file_info_get_size(info) : 0;
+    if (info) {
+        g_object_unref(info);
+    }
+    
+    g_signal_connect(self->monitor, "changed", G_CALLBACK(on_notifier_file_changed), self);
+    return TRUE;
+}
+
+static void file_notifier_stop(FeedNotifier *notifier) {
+    FileNotifier *self = (FileNotifier *)notifier;
+    
+    if (self->monitor) {
+        g_file_monitor_cancel(self->monitor);
+        g_signal_handlers_disconnect_by_data(self->monitor, self);
+        g_clear_object(&self->monitor);
+    }
+}
+
+static void file_notifier_finalize(FeedNotifier *notifier) {
+    FileNotifier *self = (FileNotifier *)notifier;
+    
+    g_clear_object(&self->monitor);
+    g_object_unref(self->file);
+}
+
+static const FeedNotifierClass file_notifier_class = {
+    "file",
+    file_notifier_start,
+    file_notifier_stop,
+    file_notifier_finalize
+};
+
+FeedNotifier* feed_notifier_file_new(const gchar *path) {
+    g_return_val_if_fail(path != NULL, NULL);
+    
+    FileNotifier *self = (FileNotifier *)feed_notifier_new(&file_notifier_class, sizeof(FileNotifier));
+    self->file = g_file_new_for_path(path);
+    return &self->parent;
+}
@@ -129,7 +129,7 @@ static void extract_tags_from_file(const gchar *filepath, Track *track) {
     gst_object_unref(pipeline);
 }
 
-static void scan_directory_recursive(const gchar *path, Database *db, CoverArtManager *cover_mgr, gint *count) {
+static void scan_directory_recursive(const gchar *path, Database *db, CoverArtScan *covers, gint *count) {
     GDir *dir = g_dir_open(path, 0, NULL);
     if (!dir) return;
     
@@ -138,7 +138,7 @@ static void scan_directory_recursive(const gchar *path, Database *db, CoverArtMa
         gchar *fullpath = g_build_filename(path, name, NULL);
         
         if (g_file_test(fullpath, G_FILE_TEST_IS_DIR)) {
-            scan_directory_recursive(fullpath, db, cover_mgr, count);
+            scan_directory_recursive(fullpath, db, covers, count);
         } else if (is_media_file(name)) {
             Track *track = g_new0(Track, 1);
             track->file_path = g_strdup(fullpath);
@@ -155,9 +155,9 @@ static void scan_directory_recursive(const gchar *path, Database *db, CoverArtMa
             /* Try to extract metadata */
             extract_tags_from_file(fullpath, track);
             
-            /* Extract and cache album art if we have a cover art manager */
-            if (cover_mgr && track->artist && track->album) {
-                coverart_extract_and_cache(cover_mgr, fullpath, track->artist, track->album);
+            /* Resolve album art once per album in this directory */
+            if (covers && track->artist && track->album) {
+                coverart_scan_resolve(covers, fullpath, track->artist, track->album);
             }
             
             /* Add to database - all media files go to tracks table for consistency */
@@ -188,7 +188,9 @@ void import_media_from_directory_with_covers(const gchar *directory, Database *d
     
     g_print("Scanning %s for media files", cover_mgr ? " and extracting cover art" : "");
     g_print("...\n");
-    scan_directory_recursive(directory, db, cover_mgr, &count);
+    CoverArtScan *covers = cover_mgr ? coverart_scan_new(cover_mgr, db) : NULL;
+    scan_directory_recursive(directory, db, covers, &count);
+    coverart_scan_free(covers);
     g_print("\nImported %d tracks total.\n", count);
 }
 
@@ -196,7 +198,7 @@ void import_media_from_directory(const gchar *directory, Database *db) {
     import_media_from_directory_with_covers(directory, db, NULL);
 }
 
-static void scan_audio_files_recursive(const gchar *path, Database *db, CoverArtManager *cover_mgr, gint *count) {
+static void scan_audio_files_recursive(const gchar *path, Database *db, CoverArtScan *covers, gint *count) {
     GDir *dir = g_dir_open(path, 0, NULL);
     if (!dir) return;
     
@@ -205,7 +207,7 @@ static void scan_audio_files_recursive(const gchar *path, Database *db, CoverArt
         gchar *fullpath = g_build_filename(path, name, NULL);
         
         if (g_file_test(fullpath, G_FILE_TEST_IS_DIR)) {
-            scan_audio_files_recursive(fullpath, db, cover_mgr, count);
+            scan_audio_files_recursive(fullpath, db, covers, count);
         } else if (is_audio_file(name)) {
             Track *track = g_new0(Track, 1);
             track->file_path = g_strdup(fullpath);
@@ -222,9 +224,9 @@ static void scan_audio_files_recursive(const gchar *path, Database *db, CoverArt
             /* Try to extract metadata */
             extract_tags_from_file(fullpath, track);
             
-            /* Extract and cache album art if we have a cover art manager */
-            if (cover_mgr && track->artist && track->album) {
-                coverart_extract_and_cache(cover_mgr, fullpath, track->artist, track->album);
+            /* Resolve album art once per album in this directory */
+            if (covers && track->artist && track->album) {
+                coverart_scan_resolve(covers, fullpath, track->artist, track->album);
             }
             
             /* Add to database - only audio files */
@@ -302,7 +304,9 @@ void import_audio_from_directory_with_covers(const gchar *directory, Database *d
     
     g_print("Scanning %s for audio files", cover_mgr ? " and extracting cover art" : "");
     g_print("...\n");
-    scan_audio_files_recursive(directory, db, cover_mgr, &count);
+    CoverArtScan *covers = cover_mgr ? coverart_scan_new(cover_mgr, db) : NULL;
+    scan_audio_files_recursive(directory, db, covers, &count);
+    coverart_scan_free(covers);
     g_print("\nImported %d audio tracks total.\n", count);
 }
 
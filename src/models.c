@@ -1,4 +1,5 @@
 #include "models.h"
+#include "podcast.h"
 #include <string.h>
 
 /* ============================================================================
@@ -654,18 +655,20 @@ struct _ShriekEpisodeObject {
     
     gint id;
     gchar *title;
-    gchar *date;
-    gchar *duration;
+    gint64 published_date;
+    gint duration;
     gboolean downloaded;
+    gdouble start_time;
 };
 
 enum {
     EPISODE_PROP_0,
     EPISODE_PROP_ID,
     EPISODE_PROP_TITLE,
-    EPISODE_PROP_DATE,
+    EPISODE_PROP_PUBLISHED_DATE,
     EPISODE_PROP_DURATION,
     EPISODE_PROP_DOWNLOADED,
+    EPISODE_PROP_START_TIME,
     EPISODE_N_PROPERTIES
 };
 
@@ -676,8 +679,6 @@ G_DEFINE_TYPE(ShriekEpisodeObject, shriek_episode_object, G_TYPE_OBJECT)
 static void shriek_episode_object_finalize(GObject *object) {
     ShriekEpisodeObject *self = SHRIEK_EPISODE_OBJECT(object);
     g_free(self->title);
-    g_free(self->date);
-    g_free(self->duration);
     G_OBJECT_CLASS(shriek_episode_object_parent_class)->finalize(object);
 }
 
@@ -692,15 +693,18 @@ static void shriek_episode_object_get_property(GObject *object, guint prop_id,
         case EPISODE_PROP_TITLE:
             g_value_set_string(value, self->title);
             break;
-        case EPISODE_PROP_DATE:
-            g_value_set_string(value, self->date);
+        case EPISODE_PROP_PUBLISHED_DATE:
+            g_value_set_int64(value, self->published_date);
             break;
         case EPISODE_PROP_DURATION:
-            g_value_set_string(value, self->duration);
+            g_value_set_int(value, self->duration);
             break;
         case EPISODE_PROP_DOWNLOADED:
             g_value_set_boolean(value, self->downloaded);
             break;
+        case EPISODE_PROP_START_TIME:
+            g_value_set_double(value, self->start_time);
+            break;
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
     }
@@ -718,17 +722,18 @@ static void shriek_episode_object_set_property(GObject *object, guint prop_id,
             g_free(self->title);
             self->title = g_value_dup_string(value);
             break;
-        case EPISODE_PROP_DATE:
-            g_free(self->date);
-            self->date = g_value_dup_string(value);
+        case EPISODE_PROP_PUBLISHED_DATE:
+            self->published_date = g_value_get_int64(value);
             break;
         case EPISODE_PROP_DURATION:
-            g_free(self->duration);
-            self->duration = g_value_dup_string(value);
+            self->duration = g_value_get_int(value);
             break;
         case EPISODE_PROP_DOWNLOADED:
             self->downloaded = g_value_get_boolean(value);
             break;
+        case EPISODE_PROP_START_TIME:
+            self->start_time = g_value_get_double(value);
+            break;
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
     }
@@ -751,40 +756,46 @@ static void shriek_episode_object_class_init(ShriekEpisodeObjectClass *klass) {
                             NULL,
                             G_PARAM_READWRITE | G_PARAM_CONSTRUCT);
     
-    episode_properties[EPISODE_PROP_DATE] =
-        g_param_spec_string("date", "Date", "Episode publish date",
-                            NULL,
-                            G_PARAM_READWRITE | G_PARAM_CONSTRUCT);
+    episode_properties[EPISODE_PROP_PUBLISHED_DATE] =
+        g_param_spec_int64("published-date", "Published Date", "Episode publish date (Unix time)",
+                           0, G_MAXINT64, 0,
+                           G_PARAM_READWRITE | G_PARAM_CONSTRUCT);
     
     episode_properties[EPISODE_PROP_DURATION] =
-        g_param_spec_string("duration", "Duration", "Episode duration",
-                            NULL,
-                            G_PARAM_READWRITE | G_PARAM_CONSTRUCT);
+        g_param_spec_int("duration", "Duration", "Episode duration in seconds",
+                         0, G_MAXINT, 0,
+                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT);
     
     episode_properties[EPISODE_PROP_DOWNLOADED] =
         g_param_spec_boolean("downloaded", "Downloaded", "Whether episode is downloaded",
                              FALSE,
                              G_PARAM_READWRITE | G_PARAM_CONSTRUCT);
     
+    episode_properties[EPISODE_PROP_START_TIME] =
+        g_param_spec_double("start-time", "Start Time", "Seconds to seek to when played, e.g. a transcript match",
+                            0.0, G_MAXDOUBLE, 0.0,
+                            G_PARAM_READWRITE);
+    
     g_object_class_install_properties(object_class, EPISODE_N_PROPERTIES, episode_properties);
 }
 
 static void shriek_episode_object_init(ShriekEpisodeObject *self) {
     self->id = 0;
     self->title = NULL;
-    self->date = NULL;
-    self->duration = NULL;
+    self->published_date = 0;
+    self->duration = 0;
     self->downloaded = FALSE;
+    self->start_time = 0.0;
 }
 
 ShriekEpisodeObject* shriek_episode_object_new(gint id, const gchar *title,
-                                                  const gchar *date, const gchar *duration,
+                                                  gint64 published_date, gint duration,
                                                   gboolean downloaded) {
     return g_object_new(SHRIEK_TYPE_EPISODE_OBJECT,
                         "id", id,
                         "title", title,
-                        "date", date,
-                        "duration", duration,
+                        "published-date", MAX(published_date, 0),
+                        "duration", MAX(duration, 0),
                         "downloaded", downloaded,
                         NULL);
 }
@@ -799,13 +810,13 @@ const gchar* shriek_episode_object_get_title(ShriekEpisodeObject *self) {
     return self->title;
 }
 
-const gchar* shriek_episode_object_get_date(ShriekEpisodeObject *self) {
-    g_return_val_if_fail(SHRIEK_IS_EPISODE_OBJECT(self), NULL);
-    return self->date;
+gint64 shriek_episode_object_get_published_date(ShriekEpisodeObject *self) {
+    g_return_val_if_fail(SHRIEK_IS_EPISODE_OBJECT(self), 0);
+    return self->published_date;
 }
 
-const gchar* shriek_episode_object_get_duration(ShriekEpisodeObject *self) {
-    g_return_val_if_fail(SHRIEK_IS_EPISODE_OBJECT(self), NULL);
+gint shriek_episode_object_get_duration(ShriekEpisodeObject *self) {
+    g_return_val_if_fail(SHRIEK_IS_EPISODE_OBJECT(self), 0);
     return self->duration;
 }
 
@@ -814,6 +825,180 @@ gboolean shriek_episode_object_get_downloaded(ShriekEpisodeObject *self) {
     return self->downloaded;
 }
 
+gdouble shriek_episode_object_get_start_time(ShriekEpisodeObject *self) {
+    g_return_val_if_fail(SHRIEK_IS_EPISODE_OBJECT(self), 0.0);
+    return self->start_time;
+}
+
+void shriek_episode_object_set_start_time(ShriekEpisodeObject *self, gdouble start_time) {
+    g_return_if_fail(SHRIEK_IS_EPISODE_OBJECT(self));
+    g_object_set(self, "start-time", MAX(start_time, 0.0), NULL);
+}
+
+/* ============================================================================
+ * ShriekEpisodeListModel Implementation
+ * ============================================================================ */
+
+/* Rows are fetched from the database a page at a time, only when the list
+ * view asks for them, and only the most recently used pages are kept */
+#define EPISODE_PAGE_SIZE 100
+#define EPISODE_MAX_CACHED_PAGES 16
+
+struct _ShriekEpisodeListModel {
+    GObject parent_instance;
+    
+    Database *database;
+    gint podcast_id;
+    guint n_items;
+    GArray *keys;        /* EpisodeRowKey per row, as of the last reload */
+    GHashTable *pages;   /* page index -> GPtrArray of ShriekEpisodeObject */
+    GQueue page_order;   /* Cached page indexes, least recently used first */
+};
+
+static void shriek_episode_list_model_iface_init(GListModelInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE(ShriekEpisodeListModel, shriek_episode_list_model, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(G_TYPE_LIST_MODEL, shriek_episode_list_model_iface_init))
+
+static GType shriek_episode_list_model_get_item_type(GListModel *list) {
+    (void)list;
+    return SHRIEK_TYPE_EPISODE_OBJECT;
+}
+
+static guint shriek_episode_list_model_get_n_items(GListModel *list) {
+    return SHRIEK_EPISODE_LIST_MODEL(list)->n_items;
+}
+
+static GPtrArray* shriek_episode_list_model_load_page(ShriekEpisodeListModel *self, guint page) {
+    GList *episodes = database_get_podcast_episode_page(self->database, self->podcast_id,
+                                                        (gint)(page * EPISODE_PAGE_SIZE), EPISODE_PAGE_SIZE);
+    GPtrArray *items = g_ptr_array_new_full(EPISODE_PAGE_SIZE, g_object_unref);
+    
+    for (GList *l = episodes; l != NULL; l = l->next) {
+        PodcastEpisode *episode = (PodcastEpisode *)l->data;
+        g_ptr_array_add(items, shriek_episode_object_new(episode->id,
+                                                         episode->title ? episode->title : "Unknown",
+                                                         episode->published_date, episode->duration,
+                                                         episode->downloaded));
+    }
+    g_list_free_full(episodes, (GDestroyNotify)podcast_episode_free);
+    
+    /* Rows deleted since the last reload leave the page short. Every position
+     * below n_items must give an object, so the gap is filled with blank rows
+     * until the next reload drops them. */
+    guint expected = MIN(EPISODE_PAGE_SIZE, self->n_items - page * EPISODE_PAGE_SIZE);
+    while (items->len < expected) {
+        EpisodeRowKey *key = &g_array_index(self->keys, EpisodeRowKey, page * EPISODE_PAGE_SIZE + items->len);
+        g_ptr_array_add(items, shriek_episode_object_new(key->id, "", 0, 0, FALSE));
+    }
+    
+    g_hash_table_insert(self->pages, GUINT_TO_POINTER(page), items);
+    g_queue_push_tail(&self->page_order, GUINT_TO_POINTER(page));
+    
+    while (g_queue_get_length(&self->page_order) > EPISODE_MAX_CACHED_PAGES) {
+        g_hash_table_remove(self->pages, g_queue_pop_head(&self->page_order));
+    }
+    return items;
+}
+
+static gpointer shriek_episode_list_model_get_item(GListModel *list, guint position) {
+    ShriekEpisodeListModel *self = SHRIEK_EPISODE_LIST_MODEL(list);
+    if (position >= self->n_items) return NULL;
+    
+    guint page = position / EPISODE_PAGE_SIZE;
+    GPtrArray *items = g_hash_table_lookup(self->pages, GUINT_TO_POINTER(page));
+    if (items) {
+        /* Mark as recently used */
+        g_queue_remove(&self->page_order, GUINT_TO_POINTER(page));
+        g_queue_push_tail(&self->page_order, GUINT_TO_POINTER(page));
+    } else {
+        items = shriek_episode_list_model_load_page(self, page);
+    }
+    
+    return g_object_ref(g_ptr_array_index(items, position % EPISODE_PAGE_SIZE));
+}
+
+static void shriek_episode_list_model_iface_init(GListModelInterface *iface) {
+    iface->get_item_type = shriek_episode_list_model_get_item_type;
+    iface->get_n_items = shriek_episode_list_model_get_n_items;
+    iface->get_item = shriek_episode_list_model_get_item;
+}
+
+static void shriek_episode_list_model_finalize(GObject *object) {
+    ShriekEpisodeListModel *self = SHRIEK_EPISODE_LIST_MODEL(object);
+    g_array_unref(self->keys);
+    g_hash_table_destroy(self->pages);
+    g_queue_clear(&self->page_order);
+    G_OBJECT_CLASS(shriek_episode_list_model_parent_class)->finalize(object);
+}
+
+static void shriek_episode_list_model_class_init(ShriekEpisodeListModelClass *klass) {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+    object_class->finalize = shriek_episode_list_model_finalize;
+}
+
+static void shriek_episode_list_model_init(ShriekEpisodeListModel *self) {
+    self->keys = g_array_new(FALSE, FALSE, sizeof(EpisodeRowKey));
+    self->pages = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
+                                        (GDestroyNotify)g_ptr_array_unref);
+    g_queue_init(&self->page_order);
+}
+
+ShriekEpisodeListModel* shriek_episode_list_model_new(Database *database) {
+    ShriekEpisodeListModel *self = g_object_new(SHRIEK_TYPE_EPISODE_LIST_MODEL, NULL);
+    self->database = database;
+    return self;
+}
+
+void shriek_episode_list_model_set_podcast(ShriekEpisodeListModel *self, gint podcast_id) {
+    g_return_if_fail(SHRIEK_IS_EPISODE_LIST_MODEL(self));
+    
+    GArray *old_keys = self->keys;
+    self->keys = podcast_id > 0 ? database_get_podcast_episode_keys(self->database, podcast_id)
+                                : g_array_new(FALSE, FALSE, sizeof(EpisodeRowKey));
+    self->podcast_id = podcast_id;
+    self->n_items = self->keys->len;
+    
+    /* Only the rows between the unchanged head and tail are reported, so a
+     * refresh that adds a few new episodes doesn't rebuild the whole list */
+    guint old_len = old_keys->len;
+    guint new_len = self->keys->len;
+    guint head = 0;
+    while (head < old_len && head < new_len &&
+           memcmp(&g_array_index(old_keys, EpisodeRowKey, head),
+                  &g_array_index(self->keys, EpisodeRowKey, head), sizeof(EpisodeRowKey)) == 0) {
+        head++;
+    }
+    guint tail = 0;
+    while (tail < old_len - head && tail < new_len - head &&
+           memcmp(&g_array_index(old_keys, EpisodeRowKey, old_len - 1 - tail),
+                  &g_array_index(self->keys, EpisodeRowKey, new_len - 1 - tail), sizeof(EpisodeRowKey)) == 0) {
+        tail++;
+    }
+    g_array_unref(old_keys);
+    
+    if (head == old_len && head == new_len) return;
+    
+    /* Cached pages from the first changed row on may hold stale or shifted rows */
+    guint first_stale = head / EPISODE_PAGE_SIZE;
+    GHashTableIter iter;
+    gpointer page;
+    g_hash_table_iter_init(&iter, self->pages);
+    while (g_hash_table_iter_next(&iter, &page, NULL)) {
+        if (GPOINTER_TO_UINT(page) >= first_stale) {
+            g_queue_remove(&self->page_order, page);
+            g_hash_table_iter_remove(&iter);
+        }
+    }
+    
+    g_list_model_items_changed(G_LIST_MODEL(self), head, old_len - head - tail, new_len - head - tail);
+}
+
+gint shriek_episode_list_model_get_podcast(ShriekEpisodeListModel *self) {
+    g_return_val_if_fail(SHRIEK_IS_EPISODE_LIST_MODEL(self), 0);
+    return self->podcast_id;
+}
+
 /* ============================================================================
  * ShriekVideoObject Implementation
  * ============================================================================ */
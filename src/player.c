@@ -123,6 +123,14 @@ static gboolean bus_callback(GstBus *bus, GstMessage *msg, gpointer data) {
                 } else if (new_state == GST_STATE_READY) {
                     player->state = PLAYER_STATE_READY;
                 }
+                
+                /* A seek requested before the new stream could seek */
+                if ((new_state == GST_STATE_PAUSED || new_state == GST_STATE_PLAYING) &&
+                    player->pending_seek >= 0) {
+                    gint64 position = player->pending_seek;
+                    player->pending_seek = -1;
+                    player_seek(player, position);
+                }
             }
             break;
         }
@@ -215,6 +223,7 @@ MediaPlayer* player_new(void) {
     player->volume = 1.0;
     player->duration = 0;
     player->position = 0;
+    player->pending_seek = -1;
     
     return player;
 }
@@ -265,6 +274,7 @@ gboolean player_set_uri(MediaPlayer *player, const gchar *uri) {
     gst_element_set_state(player->playbin, GST_STATE_NULL);
     
     /* Set new URI */
+    player->pending_seek = -1;
     g_free(player->current_uri);
     player->current_uri = g_strdup(uri);
     
@@ -445,6 +455,10 @@ gboolean player_seek(MediaPlayer *player, gint64 position) {
     
     if (ret) {
         player->position = position;
+    } else if (GST_STATE(player->playbin) < GST_STATE_PAUSED || GST_STATE_PENDING(player->playbin) != GST_STATE_VOID_PENDING) {
+        /* Still starting up, e.g. seeking straight after player_play() */
+        player->pending_seek = position;
+        ret = TRUE;
     }
     
     return ret;
@@ -1,17 +1,32 @@
-#define _XOPEN_SOURCE
+#ifdef __linux__
+#define _GNU_SOURCE  /* fallocate() */
+#endif
+#define _XOPEN_SOURCE 700
 #include "podcast.h"
 #include "database.h"
+#include "transcript.h"
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 #include <libxml/xpath.h>
 #include <curl/curl.h>
 #include <json-glib/json-glib.h>
+#include <gst/gst.h>
+#include <gst/pbutils/pbutils.h>
 #include <glib/gstdio.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <time.h>
 #include <sqlite3.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <errno.h>
+#ifdef _WIN32
+#include <io.h>
+#include <malloc.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #ifdef _WIN32
 /* Helper to convert month name to number, returns -1 if not found */
@@ -84,8 +99,57 @@ static size_t write_memory_callback(void *contents, size_t size, size_t nmemb, v
     return realsize;
 }
 
-/* Internal fetch function that can optionally reuse a curl handle */
-static gchar* fetch_url_with_handle(const gchar *url, CURL *reuse_handle) {
+/* Abort a transfer once its cancellable fires */
+static int fetch_cancel_callback(void *clientp, curl_off_t dltotal, curl_off_t dlnow,
+                                 curl_off_t ultotal, curl_off_t ulnow) {
+    (void)dltotal; (void)dlnow; (void)ultotal; (void)ulnow;
+    return g_cancellable_is_cancelled((GCancellable *)clientp) ? 1 : 0;
+}
+
+/* Caching hints of a feed response, used by the refresh scheduler */
+typedef struct {
+    glong status;
+    gint64 max_age;      /* Cache-Control max-age in seconds, -1 if absent */
+    gint64 retry_after;  /* Retry-After in seconds from now, -1 if absent */
+} FetchHints;
+
+static size_t fetch_header_callback(char *buffer, size_t size, size_t nitems, void *userdata) {
+    size_t len = size * nitems;
+    FetchHints *hints = (FetchHints *)userdata;
+    
+    if (len > 5 && strncmp(buffer, "HTTP/", 5) == 0) {
+        /* Start of a new response, e.g. after a redirect */
+        hints->max_age = -1;
+        hints->retry_after = -1;
+    } else if (len > 14 && g_ascii_strncasecmp(buffer, "Cache-Control:", 14) == 0) {
+        gchar *value = g_ascii_strdown(buffer + 14, len - 14);
+        const gchar *max_age = strstr(value, "max-age=");
+        if (max_age) {
+            hints->max_age = g_ascii_strtoll(max_age + 8, NULL, 10);
+        }
+        g_free(value);
+    } else if (len > 12 && g_ascii_strncasecmp(buffer, "Retry-After:", 12) == 0) {
+        /* Either delay-seconds or an HTTP date */
+        gchar *value = g_strstrip(g_strndup(buffer + 12, len - 12));
+        gchar *end = NULL;
+        gint64 seconds = g_ascii_strtoll(value, &end, 10);
+        if (end != value && *end == '\0') {
+            hints->retry_after = MAX(0, seconds);
+        } else {
+            time_t when = curl_getdate(value, NULL);
+            if (when > 0) {
+                hints->retry_after = MAX(0, (gint64)when - g_get_real_time() / G_USEC_PER_SEC);
+            }
+        }
+        g_free(value);
+    }
+    return len;
+}
+
+/* Internal fetch function that can optionally reuse a curl handle. With hints,
+ * HTTP error responses count as failures and caching headers are reported. */
+static gchar* fetch_url_with_handle(const gchar *url, CURL *reuse_handle, GCancellable *cancellable,
+                                    FetchHints *hints) {
     CURL *curl;
     CURLcode res;
     MemoryBuffer chunk = {NULL, 0};
@@ -107,33 +171,67 @@ static gchar* fetch_url_with_handle(const gchar *url, CURL *reuse_handle) {
     curl_easy_setopt(curl, CURLOPT_USERAGENT, "Shriek/1.0 (Podcast 2.0)");
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+    if (cancellable) {
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, fetch_cancel_callback);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, cancellable);
+    }
+    if (hints) {
+        hints->status = 0;
+        hints->max_age = -1;
+        hints->retry_after = -1;
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, fetch_header_callback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, hints);
+    }
     
     res = curl_easy_perform(curl);
     
+    if (hints && res == CURLE_OK) {
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &hints->status);
+    }
+    
     if (own_handle) {
         curl_easy_cleanup(curl);
     }
     
+    if (res == CURLE_ABORTED_BY_CALLBACK) {
+        g_free(chunk.data);
+        return NULL;
+    }
     if (res != CURLE_OK) {
         g_warning("Failed to fetch URL '%s': %s", url, curl_easy_strerror(res));
         g_free(chunk.data);
         return NULL;
     }
+    if (hints && hints->status >= 400) {
+        g_warning("Failed to fetch URL '%s': HTTP %ld", url, hints->status);
+        g_free(chunk.data);
+        return NULL;
+    }
     
     return chunk.data;
 }
 
 gchar* fetch_url(const gchar *url) {
-    return fetch_url_with_handle(url, NULL);
+    return fetch_url_with_handle(url, NULL, NULL, NULL);
 }
 
+/* Binary fetches (cover art) run on pool threads. Each thread keeps its
+ * handle, so artwork from the same host reuses the open connection. */
+static GPrivate binary_fetch_handle = G_PRIVATE_INIT((GDestroyNotify)curl_easy_cleanup);
+
 gchar* fetch_binary_url(const gchar *url, gsize *out_size) {
-    CURL *curl;
     CURLcode res;
     MemoryBuffer chunk = {NULL, 0};
     
-    curl = curl_easy_init();
-    if (!curl) return NULL;
+    CURL *curl = g_private_get(&binary_fetch_handle);
+    if (curl) {
+        curl_easy_reset(curl);  /* Reset options but keep connection */
+    } else {
+        curl = curl_easy_init();
+        if (!curl) return NULL;
+        g_private_set(&binary_fetch_handle, curl);
+    }
     
     curl_easy_setopt(curl, CURLOPT_URL, url);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_memory_callback);
@@ -143,7 +241,6 @@ gchar* fetch_binary_url(const gchar *url, gsize *out_size) {
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
     
     res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
     
     if (res != CURLE_OK) {
         g_warning("Failed to fetch binary URL '%s': %s", url, curl_easy_strerror(res));
@@ -158,11 +255,203 @@ gchar* fetch_binary_url(const gchar *url, gsize *out_size) {
     return chunk.data;
 }
 
+/* Sidecar cache: chapters and transcript files fetched for episodes are kept
+ * under the user cache dir, named by the SHA-1 of their URL, with the server's
+ * ETag stored next to them. Fresh entries are served without touching the
+ * network; stale ones are revalidated with If-None-Match, and the cached copy
+ * is used whenever the server can't be reached. */
+
+#define SIDECAR_MAX_AGE_SECONDS (24 * 60 * 60)
+
+static gchar* sidecar_cache_path(const gchar *url, const gchar *suffix) {
+    gchar *hash = g_compute_checksum_for_string(G_CHECKSUM_SHA1, url, -1);
+    gchar *name = g_strconcat(hash, suffix, NULL);
+    gchar *path = g_build_filename(g_get_user_cache_dir(), "shriek", "podcast-sidecars", name, NULL);
+    g_free(name);
+    g_free(hash);
+    return path;
+}
+
+static size_t sidecar_header_callback(char *buffer, size_t size, size_t nitems, void *userdata) {
+    size_t len = size * nitems;
+    gchar **etag = (gchar **)userdata;
+    
+    if (len > 5 && g_ascii_strncasecmp(buffer, "ETag:", 5) == 0) {
+        g_free(*etag);
+        *etag = g_strstrip(g_strndup(buffer + 5, len - 5));
+    }
+    return len;
+}
+
+gchar* podcast_sidecar_fetch(const gchar *url, gboolean revalidate) {
+    if (!url || !*url) return NULL;
+    
+    gchar *path = sidecar_cache_path(url, "");
+    gchar *etag_path = sidecar_cache_path(url, ".etag");
+    gchar *cached = NULL;
+    gchar *etag = NULL;
+    GStatBuf st;
+    
+    if (g_stat(path, &st) == 0 && g_file_get_contents(path, &cached, NULL, NULL)) {
+        gint64 age = g_get_real_time() / G_USEC_PER_SEC - (gint64)st.st_mtime;
+        if (!revalidate && age >= 0 && age < SIDECAR_MAX_AGE_SECONDS) {
+            g_free(path);
+            g_free(etag_path);
+            return cached;
+        }
+        g_file_get_contents(etag_path, &etag, NULL, NULL);
+    }
+    
+    CURL *curl = curl_easy_init();
+    if (!curl) {
+        g_free(etag);
+        g_free(path);
+        g_free(etag_path);
+        return cached;
+    }
+    
+    MemoryBuffer chunk = {NULL, 0};
+    gchar *new_etag = NULL;
+    struct curl_slist *headers = NULL;
+    
+    curl_easy_setopt(curl, CURLOPT_URL, url);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_memory_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&chunk);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, sidecar_header_callback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)&new_etag);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "Shriek/1.0 (Podcast 2.0)");
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+    if (cached && etag && *etag) {
+        gchar *header = g_strdup_printf("If-None-Match: %s", etag);
+        headers = curl_slist_append(headers, header);
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        g_free(header);
+    }
+    
+    CURLcode res = curl_easy_perform(curl);
+    long response_code = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(curl);
+    
+    gchar *result = NULL;
+    if (res == CURLE_OK && response_code == 304 && cached) {
+        /* Still current - restart the freshness window */
+        g_utime(path, NULL);
+        result = cached;
+        cached = NULL;
+    } else if (res == CURLE_OK && chunk.data) {
+        gchar *dir = g_path_get_dirname(path);
+        g_mkdir_with_parents(dir, 0755);
+        g_free(dir);
+        
+        GError *error = NULL;
+        if (!g_file_set_contents(path, chunk.data, (gssize)chunk.size, &error)) {
+            g_warning("Failed to cache '%s': %s", url, error->message);
+            g_error_free(error);
+        } else if (new_etag && *new_etag) {
+            g_file_set_contents(etag_path, new_etag, -1, NULL);
+        } else {
+            g_unlink(etag_path);
+        }
+        result = chunk.data;
+        chunk.data = NULL;
+    } else if (cached) {
+        /* Offline or server trouble - the cached copy is better than nothing */
+        g_debug("Using cached copy of '%s': %s", url, curl_easy_strerror(res));
+        result = cached;
+        cached = NULL;
+    } else {
+        g_warning("Failed to fetch URL '%s': %s", url, curl_easy_strerror(res));
+    }
+    
+    g_free(chunk.data);
+    g_free(cached);
+    g_free(new_etag);
+    g_free(etag);
+    g_free(path);
+    g_free(etag_path);
+    return result;
+}
+
+static void sidecar_fetch_thread(GTask *task, gpointer source_object, gpointer task_data,
+                                 GCancellable *cancellable) {
+    (void)source_object;
+    (void)cancellable;
+    const gchar *url = (const gchar *)task_data;
+    
+    gchar *data = podcast_sidecar_fetch(url, FALSE);
+    if (data) {
+        g_task_return_pointer(task, data, g_free);
+    } else {
+        g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_FAILED, "Failed to fetch %s", url);
+    }
+}
+
+void podcast_sidecar_fetch_async(const gchar *url, GCancellable *cancellable,
+                                 GAsyncReadyCallback callback, gpointer user_data) {
+    GTask *task = g_task_new(NULL, cancellable, callback, user_data);
+    g_task_set_task_data(task, g_strdup(url), g_free);
+    g_task_set_return_on_cancel(task, TRUE);
+    g_task_run_in_thread(task, sidecar_fetch_thread);
+    g_object_unref(task);
+}
+
+gchar* podcast_sidecar_fetch_finish(GAsyncResult *result, GError **error) {
+    return g_task_propagate_pointer(G_TASK(result), error);
+}
+
+gchar* podcast_sidecar_read_cached(const gchar *url) {
+    if (!url || !*url) return NULL;
+    
+    gchar *path = sidecar_cache_path(url, "");
+    gchar *data = NULL;
+    g_file_get_contents(path, &data, NULL, NULL);
+    g_free(path);
+    return data;
+}
+
+/* Add an episode's transcript to the offline search index. Only the sidecar
+ * cache is read; a transcript that isn't cached yet is left for a later pass. */
+static void podcast_index_transcript(Database *database, gint episode_id,
+                                     const gchar *url, const gchar *type) {
+    gchar *data = podcast_sidecar_read_cached(url);
+    if (!data) return;
+    
+    Transcript *transcript = transcript_parse(data, transcript_detect_format(data, url, type));
+    database_save_episode_transcript(database, episode_id, transcript);
+    transcript_unref(transcript);
+    g_free(data);
+}
+
+/* Runs on the feed worker at startup for episodes downloaded before their
+ * transcript was indexed */
+static void podcast_index_transcripts_run(GTask *task, PodcastManager *manager) {
+    GList *episodes = database_get_unindexed_transcript_episodes(manager->database);
+    
+    for (GList *l = episodes; l != NULL; l = l->next) {
+        PodcastEpisode *episode = (PodcastEpisode *)l->data;
+        podcast_index_transcript(manager->database, episode->id,
+                                 episode->transcript_url, episode->transcript_type);
+    }
+    
+    g_list_free_full(episodes, (GDestroyNotify)podcast_episode_free);
+    g_task_return_boolean(task, TRUE);
+}
+
+static void download_thread_func(gpointer data, gpointer user_data);
+static void download_task_free(DownloadTask *task);
+static void podcast_manager_restore_downloads(PodcastManager *manager);
+static void feed_thread_func(gpointer data, gpointer user_data);
+
 PodcastManager* podcast_manager_new(Database *database) {
     PodcastManager *manager = g_new0(PodcastManager, 1);
     manager->database = database;
     manager->update_timer_id = 0;
     manager->update_interval_minutes = 0;
+    manager->cancellable = g_cancellable_new();
     
     /* Initialize curl globally (thread-safe, only once) */
     curl_global_init(CURL_GLOBAL_DEFAULT);
@@ -182,14 +471,44 @@ PodcastManager* podcast_manager_new(Database *database) {
     
     /* Initialize downloads tracking - NULL destroy func since we manage task lifecycle */
     manager->active_downloads = g_hash_table_new(g_direct_hash, g_direct_equal);
+    manager->downloads_per_host = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
     g_mutex_init(&manager->downloads_mutex);
     
-    /* Create thread pool for downloads (max 3 concurrent downloads) */
-    manager->download_pool = NULL;
+    /* Download scheduler limits */
+    manager->max_downloads = MAX(1, database_get_preference_int(database, "podcast_max_downloads", 3));
+    manager->max_downloads_per_host = MAX(0, database_get_preference_int(database, "podcast_max_downloads_per_host", 2));
+    manager->max_download_retries = MAX(0, database_get_preference_int(database, "podcast_download_max_retries", 5));
+    manager->download_rate_limit = (gint64)MAX(0, database_get_preference_int(database, "podcast_download_rate_limit_kbps", 0)) * 1024;
+    
+    /* Create thread pool for downloads; the scheduler never hands it more than max_downloads */
+    GError *error = NULL;
+    manager->download_pool = g_thread_pool_new(download_thread_func, NULL, manager->max_downloads, FALSE, &error);
+    if (error) {
+        g_warning("Failed to create download thread pool: %s", error->message);
+        g_clear_error(&error);
+    }
+    
+    /* A single feed worker, so the reusable curl handle is never shared */
+    manager->feed_pool = g_thread_pool_new(feed_thread_func, NULL, 1, FALSE, &error);
+    if (error) {
+        g_warning("Failed to create feed thread pool: %s", error->message);
+        g_error_free(error);
+    }
     
     /* Create reusable curl handle for feed updates */
     manager->curl_handle = curl_easy_init();
     
+    /* Pick up downloads that were queued when the application last exited */
+    podcast_manager_restore_downloads(manager);
+    
+    /* Catch up on transcripts the search index doesn't have yet */
+    if (manager->feed_pool) {
+        GTask *task = g_task_new(NULL, NULL, NULL, NULL);
+        g_task_set_source_tag(task, podcast_index_transcripts_run);
+        g_task_set_task_data(task, manager, NULL);
+        g_thread_pool_push(manager->feed_pool, task, NULL);
+    }
+    
     return manager;
 }
 
@@ -199,6 +518,55 @@ void podcast_manager_free(PodcastManager *manager) {
     /* Stop auto-update timer */
     podcast_manager_stop_auto_update(manager);
     
+    /* Stop listening for feed changes */
+    for (GList *l = manager->notifiers; l != NULL; l = l->next) {
+        feed_notifier_stop((FeedNotifier *)l->data);
+    }
+    g_list_free_full(manager->notifiers, (GDestroyNotify)feed_notifier_unref);
+    manager->notifiers = NULL;
+    if (manager->notify_timer_id > 0) {
+        g_source_remove(manager->notify_timer_id);
+        manager->notify_timer_id = 0;
+    }
+    g_list_free(manager->notified_feeds);
+    manager->notified_feeds = NULL;
+    
+    /* Stop the feed worker; a running update gives up at its next transfer
+     * and results it already queued are dropped unapplied */
+    g_cancellable_cancel(manager->cancellable);
+    if (manager->update_cancellable) {
+        g_cancellable_cancel(manager->update_cancellable);
+    }
+    if (manager->feed_pool) {
+        g_thread_pool_free(manager->feed_pool, FALSE, TRUE);
+        manager->feed_pool = NULL;
+    }
+    g_clear_object(&manager->update_cancellable);
+    g_clear_object(&manager->cancellable);
+    
+    /* Stop the download scheduler. Running downloads are interrupted but keep
+     * their part files and queue entries so they resume on next start. */
+    g_mutex_lock(&manager->downloads_mutex);
+    manager->shutting_down = TRUE;
+    if (manager->download_retry_id > 0) {
+        g_source_remove(manager->download_retry_id);
+        manager->download_retry_id = 0;
+    }
+    GHashTableIter iter;
+    gpointer value;
+    g_hash_table_iter_init(&iter, manager->active_downloads);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        ((DownloadTask *)value)->cancelled = TRUE;
+    }
+    g_list_free_full(manager->download_queue, (GDestroyNotify)download_task_free);
+    manager->download_queue = NULL;
+    g_mutex_unlock(&manager->downloads_mutex);
+    
+    if (manager->download_pool) {
+        g_thread_pool_free(manager->download_pool, FALSE, TRUE);
+        manager->download_pool = NULL;
+    }
+    
     /* Cleanup reusable curl handle */
     if (manager->curl_handle) {
         curl_easy_cleanup((CURL *)manager->curl_handle);
@@ -208,12 +576,12 @@ void podcast_manager_free(PodcastManager *manager) {
     curl_global_cleanup();
     
     g_list_free_full(manager->podcasts, (GDestroyNotify)podcast_free);
-    if (manager->download_pool) {
-        g_thread_pool_free(manager->download_pool, FALSE, TRUE);
-    }
     if (manager->active_downloads) {
         g_hash_table_destroy(manager->active_downloads);
     }
+    if (manager->downloads_per_host) {
+        g_hash_table_destroy(manager->downloads_per_host);
+    }
     g_mutex_clear(&manager->downloads_mutex);
     g_free(manager->download_dir);
     g_free(manager);
@@ -645,6 +1013,58 @@ static PodcastValue* parse_podcast_value_node(xmlNodePtr node) {
     return value;
 }
 
+/* Seconds between episodes declared by an iCalendar RRULE, 0 if unknown */
+static gint64 parse_rrule_interval(const gchar *rrule) {
+    gint64 period = 0;
+    gint64 interval = 1;
+    gint per_period = 1;
+    
+    gchar **parts = g_strsplit(rrule, ";", -1);
+    for (gint i = 0; parts[i]; i++) {
+        gchar *part = g_strstrip(parts[i]);
+        if (g_ascii_strncasecmp(part, "FREQ=", 5) == 0) {
+            const gchar *freq = part + 5;
+            if (g_ascii_strcasecmp(freq, "MINUTELY") == 0) period = 60;
+            else if (g_ascii_strcasecmp(freq, "HOURLY") == 0) period = 60 * 60;
+            else if (g_ascii_strcasecmp(freq, "DAILY") == 0) period = 24 * 60 * 60;
+            else if (g_ascii_strcasecmp(freq, "WEEKLY") == 0) period = 7 * 24 * 60 * 60;
+            else if (g_ascii_strcasecmp(freq, "MONTHLY") == 0) period = 30 * 24 * 60 * 60;
+            else if (g_ascii_strcasecmp(freq, "YEARLY") == 0) period = 365 * 24 * 60 * 60;
+        } else if (g_ascii_strncasecmp(part, "INTERVAL=", 9) == 0) {
+            interval = MAX(1, g_ascii_strtoll(part + 9, NULL, 10));
+        } else if (g_ascii_strncasecmp(part, "BYDAY=", 6) == 0) {
+            /* e.g. FREQ=WEEKLY;BYDAY=MO,WE,FR publishes three times a period */
+            gchar **days = g_strsplit(part + 6, ",", -1);
+            per_period = MAX(1, (gint)g_strv_length(days));
+            g_strfreev(days);
+        }
+    }
+    g_strfreev(parts);
+    
+    return period * interval / per_period;
+}
+
+/* Parse <podcast:updateFrequency> from the channel */
+static void parse_update_frequency(xmlNodePtr channel, gint64 *frequency_out, gboolean *complete_out) {
+    for (xmlNodePtr cur = channel->children; cur; cur = cur->next) {
+        if (cur->type != XML_ELEMENT_NODE || !is_podcast_namespace(cur) ||
+            xmlStrcmp(cur->name, (const xmlChar *)"updateFrequency") != 0) {
+            continue;
+        }
+        
+        gchar *complete = xml_get_prop_string(cur, "complete");
+        *complete_out = (g_strcmp0(complete, "true") == 0);
+        g_free(complete);
+        
+        gchar *rrule = xml_get_prop_string(cur, "rrule");
+        if (rrule) {
+            *frequency_out = parse_rrule_interval(rrule);
+            g_free(rrule);
+        }
+        break;
+    }
+}
+
 /* Parse all Podcast 2.0 elements from a parent node (channel or item) */
 static void parse_podcast_ns_elements(xmlNodePtr parent, 
                                       GList **images_out,
@@ -827,15 +1247,9 @@ static GList* parse_podcast_live_items(xmlNodePtr channel, gint podcast_id) {
 }
 
 /* Internal version that can reuse a curl handle */
-static Podcast* podcast_parse_feed_internal(const gchar *feed_url, CURL *curl_handle) {
-    gchar *xml_data = fetch_url_with_handle(feed_url, curl_handle);
-    if (!xml_data) {
-        g_warning("Failed to fetch feed: %s", feed_url);
-        return NULL;
-    }
-    
+/* Parse the channel-level information of an already fetched feed */
+static Podcast* podcast_parse_feed_xml(const gchar *xml_data, const gchar *feed_url) {
     xmlDocPtr doc = xmlReadMemory(xml_data, strlen(xml_data), feed_url, NULL, 0);
-    g_free(xml_data);
     
     if (!doc) {
         g_warning("Failed to parse XML feed");
@@ -879,6 +1293,11 @@ static Podcast* podcast_parse_feed_internal(const gchar *feed_url, CURL *curl_ha
         podcast->language = g_strdup((gchar *)content);
         xmlFree(content);
     }
+    if ((content = get_node_content(channel, "ttl"))) {
+        podcast->ttl = MAX(0, atoi((gchar *)content));
+        xmlFree(content);
+    }
+    parse_update_frequency(channel, &podcast->update_frequency, &podcast->update_complete);
     
     /* Get image */
     xmlNodePtr image_node = channel->children;
@@ -920,7 +1339,15 @@ static Podcast* podcast_parse_feed_internal(const gchar *feed_url, CURL *curl_ha
 
 /* Public wrapper that creates a new curl handle */
 Podcast* podcast_parse_feed(const gchar *feed_url) {
-    return podcast_parse_feed_internal(feed_url, NULL);
+    gchar *xml_data = fetch_url(feed_url);
+    if (!xml_data) {
+        g_warning("Failed to fetch feed: %s", feed_url);
+        return NULL;
+    }
+    
+    Podcast *podcast = podcast_parse_feed_xml(xml_data, feed_url);
+    g_free(xml_data);
+    return podcast;
 }
 
 GList* podcast_parse_episodes(const gchar *xml_data, gint podcast_id) {
@@ -1106,93 +1533,6 @@ GList* podcast_parse_episodes(const gchar *xml_data, gint podcast_id) {
     return g_list_reverse(episodes);
 }
 
-gboolean podcast_manager_subscribe(PodcastManager *manager, const gchar *feed_url) {
-    if (!manager || !feed_url) return FALSE;
-    
-    g_debug("Subscribing to podcast: %s", feed_url);
-    
-    Podcast *podcast = podcast_parse_feed(feed_url);
-    if (!podcast) {
-        g_warning("Failed to parse podcast feed");
-        return FALSE;
-    }
-    
-    g_debug("Subscribed to: %s", podcast->title);
-    
-    /* Check if already subscribed */
-    for (GList *l = manager->podcasts; l != NULL; l = l->next) {
-        Podcast *existing = (Podcast *)l->data;
-        if (g_strcmp0(existing->feed_url, feed_url) == 0) {
-            g_debug("Already subscribed to: %s", existing->title);
-            podcast_free(podcast);
-            return TRUE;  /* Not an error, just already exists */
-        }
-    }
-    
-    /* Save podcast to database */
-    gint podcast_id = database_add_podcast(manager->database, podcast->title, podcast->feed_url,
-                                          podcast->link, podcast->description, podcast->author,
-                                          podcast->image_url, podcast->language);
-    
-    if (podcast_id < 0) {
-        g_warning("Failed to save podcast to database (may already exist)");
-        podcast_free(podcast);
-        return FALSE;
-    }
-    
-    podcast->id = podcast_id;
-    manager->podcasts = g_list_append(manager->podcasts, podcast);
-    
-    /* Save podcast funding information if available */
-    if (podcast->funding) {
-        database_save_podcast_funding(manager->database, podcast_id, podcast->funding);
-    }
-    
-    /* Save podcast value information if available */
-    if (podcast->value) {
-        database_save_podcast_value(manager->database, podcast_id, podcast->value);
-    }
-    
-    /* Save podcast live items if available */
-    if (podcast->live_items) {
-        database_save_podcast_live_items(manager->database, podcast_id, podcast->live_items);
-    }
-    
-    /* Fetch and parse episodes */
-    gchar *xml_data = fetch_url(feed_url);
-    if (xml_data) {
-        GList *episodes = podcast_parse_episodes(xml_data, podcast_id);
-        g_free(xml_data);
-        
-        /* Save episodes to database */
-        for (GList *l = episodes; l != NULL; l = l->next) {
-            PodcastEpisode *episode = (PodcastEpisode *)l->data;
-            gint episode_id = database_add_podcast_episode(manager->database, podcast_id, episode->guid,
-                                        episode->title, episode->description,
-                                        episode->enclosure_url, episode->enclosure_length,
-                                        episode->enclosure_type, episode->published_date,
-                                        episode->duration, episode->chapters_url,
-                                        episode->chapters_type, episode->transcript_url,
-                                        episode->transcript_type);
-            
-            /* Save funding information if available */
-            if (episode_id > 0 && episode->funding) {
-                database_save_episode_funding(manager->database, episode_id, episode->funding);
-            }
-            
-            /* Save value information if available */
-            if (episode_id > 0 && episode->value) {
-                database_save_episode_value(manager->database, episode_id, episode->value);
-            }
-        }
-        
-        g_debug("Added %d episodes", g_list_length(episodes));
-        g_list_free_full(episodes, (GDestroyNotify)podcast_episode_free);
-    }
-    
-    return TRUE;
-}
-
 gboolean podcast_manager_unsubscribe(PodcastManager *manager, gint podcast_id) {
     if (!manager || !manager->database) return FALSE;
     
@@ -1241,86 +1581,201 @@ gboolean podcast_manager_unsubscribe(PodcastManager *manager, gint podcast_id) {
     return TRUE;
 }
 
-void podcast_manager_update_feed(PodcastManager *manager, gint podcast_id) {
-    if (!manager) return;
+/* Refresh scheduling. Each feed gets its own next-due time, learned from the
+ * gaps between its recent episodes and never sooner than the feed (<ttl>) or
+ * the server (Cache-Control, Retry-After) allow. Timer ticks only refresh the
+ * feeds that are due. */
+
+#define REFRESH_MIN_INTERVAL (15 * 60)
+#define REFRESH_DEFAULT_INTERVAL (60 * 60)
+#define REFRESH_MAX_INTERVAL (7 * 24 * 60 * 60)
+#define REFRESH_HISTORY_EPISODES 10
+
+static gint compare_int64(gconstpointer a, gconstpointer b) {
+    gint64 x = *(const gint64 *)a;
+    gint64 y = *(const gint64 *)b;
+    return (x > y) - (x < y);
+}
+
+/* Median gap between consecutive episodes, 0 without enough history */
+static gint64 podcast_publish_cadence(GArray *dates) {
+    if (!dates || dates->len < 2) return 0;
     
-    /* Find the podcast by ID */
-    Podcast *podcast = NULL;
-    for (GList *l = manager->podcasts; l != NULL; l = l->next) {
-        Podcast *p = (Podcast *)l->data;
-        if (p->id == podcast_id) {
-            podcast = p;
-            break;
+    GArray *gaps = g_array_sized_new(FALSE, FALSE, sizeof(gint64), dates->len - 1);
+    for (guint i = 1; i < dates->len; i++) {
+        gint64 gap = g_array_index(dates, gint64, i - 1) - g_array_index(dates, gint64, i);
+        if (gap > 0) {
+            g_array_append_val(gaps, gap);
         }
     }
     
-    if (!podcast || !podcast->feed_url) {
-        g_warning("Podcast not found or has no feed URL\n");
-        return;
+    gint64 cadence = 0;
+    if (gaps->len > 0) {
+        g_array_sort(gaps, compare_int64);
+        cadence = g_array_index(gaps, gint64, gaps->len / 2);
+    }
+    g_array_unref(gaps);
+    return cadence;
+}
+
+/* Worker thread: when the feed should next be fetched. parsed is NULL if this fetch failed. */
+static gint64 podcast_compute_next_refresh(PodcastManager *manager, gint podcast_id,
+                                           Podcast *parsed, FetchHints *hints, gint64 now) {
+    GArray *dates = database_get_episode_publish_dates(manager->database, podcast_id,
+                                                       REFRESH_HISTORY_EPISODES + 1);
+    gint64 cadence = podcast_publish_cadence(dates);
+    gint64 newest = (dates && dates->len > 0) ? g_array_index(dates, gint64, 0) : 0;
+    if (dates) {
+        g_array_unref(dates);
     }
     
-    g_debug("Updating podcast feed: %s", podcast->title);
-    
-    /* Re-parse podcast-level information (including funding) using reusable handle */
-    Podcast *updated_podcast = podcast_parse_feed_internal(podcast->feed_url, manager->curl_handle);
-    if (updated_podcast && updated_podcast->funding) {
-        database_save_podcast_funding(manager->database, podcast_id, updated_podcast->funding);
-        
-        /* Update the in-memory podcast funding */
-        if (podcast->funding) {
-            g_list_free_full(podcast->funding, (GDestroyNotify)podcast_funding_free);
-        }
-        podcast->funding = g_list_copy_deep(updated_podcast->funding, (GCopyFunc)podcast_funding_copy, NULL);
+    /* A declared schedule beats the learned one */
+    if (parsed && parsed->update_frequency > 0) {
+        cadence = parsed->update_frequency;
     }
-    if (updated_podcast && updated_podcast->value) {
-        database_save_podcast_value(manager->database, podcast_id, updated_podcast->value);
+    
+    gint64 interval = REFRESH_DEFAULT_INTERVAL;
+    if (cadence > 0) {
+        /* Look a few times per expected episode so new ones show up promptly */
+        interval = cadence / 4;
         
-        /* Update the in-memory podcast value */
-        if (podcast->value) {
-            g_list_free_full(podcast->value, (GDestroyNotify)podcast_value_free);
+        /* A feed that has gone quiet backs off as the silence grows */
+        if (newest > 0 && now - newest > 2 * cadence) {
+            interval = MAX(interval, (now - newest) / 4);
         }
-        podcast->value = g_list_copy_deep(updated_podcast->value, (GCopyFunc)podcast_value_copy, NULL);
     }
-    /* Update live items - these change frequently so always update */
-    if (updated_podcast) {
-        database_save_podcast_live_items(manager->database, podcast_id, updated_podcast->live_items);
-        
-        /* Update the in-memory podcast live items */
-        if (podcast->live_items) {
-            g_list_free_full(podcast->live_items, (GDestroyNotify)podcast_live_item_free);
-        }
-        podcast->live_items = g_list_copy_deep(updated_podcast->live_items, (GCopyFunc)podcast_live_item_copy, NULL);
-        podcast->has_active_live = podcast_has_active_live_item(podcast);
-        
-        if (podcast->has_active_live) {
-            g_debug("Podcast '%s' is currently LIVE!", podcast->title);
-        }
+    if (parsed && parsed->update_complete) {
+        interval = REFRESH_MAX_INTERVAL;
     }
-    if (updated_podcast) {
-        podcast_free(updated_podcast);
+    
+    /* The user's update interval is the longest a feed waits on our account */
+    gint64 max_interval = REFRESH_MAX_INTERVAL;
+    if (manager->update_interval_minutes > 0) {
+        max_interval = CLAMP((gint64)manager->update_interval_minutes * 60, REFRESH_MIN_INTERVAL, REFRESH_MAX_INTERVAL);
     }
+    interval = CLAMP(interval, REFRESH_MIN_INTERVAL, max_interval);
     
-    /* Fetch and parse episodes using reusable handle */
-    gchar *xml_data = fetch_url_with_handle(podcast->feed_url, manager->curl_handle);
-    if (!xml_data) {
-        g_warning("Failed to fetch feed\n");
-        return;
+    /* Never sooner than the feed or the server allow */
+    if (parsed && parsed->ttl > 0) {
+        interval = MAX(interval, MIN((gint64)parsed->ttl * 60, REFRESH_MAX_INTERVAL));
+    }
+    if (hints->max_age > 0) {
+        interval = MAX(interval, MIN(hints->max_age, REFRESH_MAX_INTERVAL));
+    }
+    if (hints->retry_after >= 0) {
+        interval = MAX(interval, hints->retry_after);
     }
     
-    GList *episodes = podcast_parse_episodes(xml_data, podcast_id);
-    g_free(xml_data);
+    return now + interval;
+}
+
+/* Feed engine. Subscriptions and refreshes run on manager->feed_pool, a single
+ * worker thread that owns manager->curl_handle. The worker writes the database;
+ * the in-memory podcast list is only changed on the main thread. */
+
+typedef struct {
+    gint podcast_id;
+    gchar *feed_url;
+    gchar *title;
+} FeedUpdateItem;
+
+typedef struct {
+    PodcastManager *manager;
+    GList *items;                 /* FeedUpdateItem, in podcast list order */
+    FeedUpdateProgressCallback progress_callback;
+    gpointer progress_data;
+    GCancellable *cancellable;    /* Caller's cancellable, forwarded to update_cancellable */
+    gulong cancel_id;
+    GMainContext *context;
+} FeedUpdateJob;
+
+typedef struct {
+    PodcastManager *manager;
+    gchar *feed_url;
+    GMainContext *context;
+} FeedSubscribeJob;
+
+/* Outcome of one feed, handed to the main thread */
+typedef struct {
+    PodcastManager *manager;
+    gint podcast_id;
+    gchar *title;
+    Podcast *parsed;              /* NULL if the feed could not be fetched or parsed */
+    gint64 next_refresh;          /* 0 if the run was cancelled before scheduling */
+    gint done;
+    gint total;
+    FeedUpdateProgressCallback progress_callback;
+    gpointer progress_data;
+    GCancellable *update_cancellable; /* The run's; suppresses progress once cancelled */
+    GCancellable *cancellable;    /* The manager's; once cancelled the manager is gone */
+} FeedResult;
+
+static void feed_update_item_free(FeedUpdateItem *item) {
+    g_free(item->feed_url);
+    g_free(item->title);
+    g_free(item);
+}
+
+static void feed_update_job_free(gpointer data) {
+    FeedUpdateJob *job = (FeedUpdateJob *)data;
     
-    if (!episodes) {
-        g_warning("No episodes found or failed to parse feed\n");
-        return;
+    if (job->cancellable) {
+        g_cancellable_disconnect(job->cancellable, job->cancel_id);
+        g_object_unref(job->cancellable);
     }
+    g_list_free_full(job->items, (GDestroyNotify)feed_update_item_free);
+    g_main_context_unref(job->context);
+    g_free(job);
+}
+
+static void feed_subscribe_job_free(gpointer data) {
+    FeedSubscribeJob *job = (FeedSubscribeJob *)data;
     
-    /* Save/update episodes to database - ON CONFLICT will update existing episodes */
-    for (GList *l = episodes; l != NULL; l = l->next) {
-        PodcastEpisode *episode = (PodcastEpisode *)l->data;
-        gint episode_id = database_add_podcast_episode(manager->database, podcast_id, episode->guid,
-                                    episode->title, episode->description,
-                                    episode->enclosure_url, episode->enclosure_length,
+    g_free(job->feed_url);
+    g_main_context_unref(job->context);
+    g_free(job);
+}
+
+static void feed_result_free(FeedResult *result) {
+    g_free(result->title);
+    if (result->parsed) {
+        podcast_free(result->parsed);
+    }
+    if (result->update_cancellable) {
+        g_object_unref(result->update_cancellable);
+    }
+    g_object_unref(result->cancellable);
+    g_free(result);
+}
+
+static Podcast* podcast_manager_find_podcast(PodcastManager *manager, gint podcast_id) {
+    for (GList *l = manager->podcasts; l != NULL; l = l->next) {
+        Podcast *podcast = (Podcast *)l->data;
+        if (podcast->id == podcast_id) {
+            return podcast;
+        }
+    }
+    return NULL;
+}
+
+/* Write a fetched feed's podcast-level data and episodes to the database (worker thread) */
+static void feed_save(PodcastManager *manager, gint podcast_id, Podcast *parsed, const gchar *xml_data) {
+    if (parsed->funding) {
+        database_save_podcast_funding(manager->database, podcast_id, parsed->funding);
+    }
+    if (parsed->value) {
+        database_save_podcast_value(manager->database, podcast_id, parsed->value);
+    }
+    /* Live items change frequently so always replace them */
+    database_save_podcast_live_items(manager->database, podcast_id, parsed->live_items);
+    
+    /* ON CONFLICT in database_add_podcast_episode updates existing episodes */
+    GList *episodes = podcast_parse_episodes(xml_data, podcast_id);
+    for (GList *l = episodes; l != NULL; l = l->next) {
+        PodcastEpisode *episode = (PodcastEpisode *)l->data;
+        gint episode_id = database_add_podcast_episode(manager->database, podcast_id, episode->guid,
+                                    episode->title, episode->description,
+                                    episode->enclosure_url, episode->enclosure_length,
                                     episode->enclosure_type, episode->published_date,
                                     episode->duration, episode->chapters_url,
                                     episode->chapters_type, episode->transcript_url,
@@ -1337,55 +1792,328 @@ void podcast_manager_update_feed(PodcastManager *manager, gint podcast_id) {
         }
     }
     
-    g_debug("Updated %d episodes", g_list_length(episodes));
+    g_debug("Saved %d episodes", g_list_length(episodes));
     g_list_free_full(episodes, (GDestroyNotify)podcast_episode_free);
-    
-    /* Update last_fetched timestamp */
-    podcast->last_fetched = g_get_real_time() / G_USEC_PER_SEC;
 }
 
-void podcast_manager_update_all_feeds(PodcastManager *manager) {
-    if (!manager) return;
+/* Main thread: move a refreshed feed into the in-memory podcast and report progress */
+static gboolean feed_apply_update(gpointer user_data) {
+    FeedResult *result = (FeedResult *)user_data;
+    if (g_cancellable_is_cancelled(result->cancellable)) {
+        feed_result_free(result);
+        return G_SOURCE_REMOVE;
+    }
     
-    /* Don't start if already updating */
-    if (manager->update_in_progress) {
-        g_debug("Feed update already in progress");
-        return;
+    Podcast *parsed = result->parsed;
+    Podcast *podcast = podcast_manager_find_podcast(result->manager, result->podcast_id);
+    
+    if (podcast && result->next_refresh > 0) {
+        podcast->next_refresh = result->next_refresh;
+    }
+    if (podcast && parsed) {
+        if (parsed->funding) {
+            g_list_free_full(podcast->funding, (GDestroyNotify)podcast_funding_free);
+            podcast->funding = parsed->funding;
+            parsed->funding = NULL;
+        }
+        if (parsed->value) {
+            g_list_free_full(podcast->value, (GDestroyNotify)podcast_value_free);
+            podcast->value = parsed->value;
+            parsed->value = NULL;
+        }
+        g_list_free_full(podcast->live_items, (GDestroyNotify)podcast_live_item_free);
+        podcast->live_items = parsed->live_items;
+        parsed->live_items = NULL;
+        podcast->has_active_live = podcast_has_active_live_item(podcast);
+        podcast->last_fetched = parsed->last_fetched;
+        
+        if (podcast->has_active_live) {
+            g_debug("Podcast '%s' is currently LIVE!", podcast->title);
+        }
     }
     
-    manager->update_in_progress = TRUE;
-    manager->update_cancelled = FALSE;
+    if (result->progress_callback && !g_cancellable_is_cancelled(result->update_cancellable)) {
+        result->progress_callback(result->progress_data, result->podcast_id, result->title,
+                                  result->done, result->total, parsed != NULL);
+    }
     
-    g_debug("Automatically checking for new podcast episodes...");
+    feed_result_free(result);
+    return G_SOURCE_REMOVE;
+}
+
+/* Main thread: add a freshly subscribed podcast to the in-memory list */
+static gboolean feed_apply_subscribe(gpointer user_data) {
+    FeedResult *result = (FeedResult *)user_data;
     
-    for (GList *l = manager->podcasts; l != NULL; l = l->next) {
+    if (!g_cancellable_is_cancelled(result->cancellable) &&
+        !podcast_manager_find_podcast(result->manager, result->podcast_id)) {
+        result->manager->podcasts = g_list_append(result->manager->podcasts, result->parsed);
+        result->parsed = NULL;
+    }
+    
+    feed_result_free(result);
+    return G_SOURCE_REMOVE;
+}
+
+static void feed_update_run(GTask *task, FeedUpdateJob *job) {
+    PodcastManager *manager = job->manager;
+    GCancellable *cancellable = g_task_get_cancellable(task);
+    gint total = g_list_length(job->items);
+    gint done = 0;
+    
+    for (GList *l = job->items; l != NULL; l = l->next) {
         /* Check for cancellation before each feed */
-        if (manager->update_cancelled) {
+        if (g_cancellable_is_cancelled(cancellable)) {
             g_debug("Feed update cancelled");
             break;
         }
         
+        FeedUpdateItem *item = (FeedUpdateItem *)l->data;
+        g_debug("Updating podcast feed: %s", item->title);
+        
+        /* One transfer per feed; channel and episodes are parsed from the same document */
+        Podcast *parsed = NULL;
+        FetchHints hints;
+        gchar *xml_data = fetch_url_with_handle(item->feed_url, (CURL *)manager->curl_handle,
+                                                cancellable, &hints);
+        if (xml_data) {
+            parsed = podcast_parse_feed_xml(xml_data, item->feed_url);
+            if (parsed) {
+                feed_save(manager, item->podcast_id, parsed, xml_data);
+            } else {
+                g_warning("Failed to parse feed: %s", item->feed_url);
+            }
+            g_free(xml_data);
+        }
+        
+        /* Failed feeds are rescheduled too, so a dead server isn't hit on every tick */
+        gint64 next_refresh = 0;
+        if (!g_cancellable_is_cancelled(cancellable)) {
+            gint64 now = g_get_real_time() / G_USEC_PER_SEC;
+            next_refresh = podcast_compute_next_refresh(manager, item->podcast_id, parsed, &hints, now);
+            database_set_podcast_refresh(manager->database, item->podcast_id,
+                                         parsed ? parsed->last_fetched : 0, next_refresh);
+        }
+        
+        FeedResult *result = g_new0(FeedResult, 1);
+        result->manager = manager;
+        result->podcast_id = item->podcast_id;
+        result->title = g_strdup(item->title);
+        result->parsed = parsed;
+        result->next_refresh = next_refresh;
+        result->done = ++done;
+        result->total = total;
+        result->progress_callback = job->progress_callback;
+        result->progress_data = job->progress_data;
+        result->update_cancellable = cancellable ? g_object_ref(cancellable) : NULL;
+        result->cancellable = g_object_ref(manager->cancellable);
+        
+        /* Ahead of the task's own completion, which is dispatched at default priority */
+        g_main_context_invoke_full(job->context, G_PRIORITY_HIGH, feed_apply_update, result, NULL);
+    }
+    
+    /* Queue new episodes and prune old ones now that the feeds are current */
+    if (!g_cancellable_is_cancelled(cancellable)) {
+        podcast_manager_auto_download(manager);
+        podcast_manager_apply_retention(manager);
+    }
+    
+    g_atomic_int_set(&manager->update_in_progress, FALSE);
+    if (!g_task_return_error_if_cancelled(task)) {
+        g_task_return_boolean(task, TRUE);
+    }
+}
+
+static void feed_subscribe_run(GTask *task, FeedSubscribeJob *job) {
+    PodcastManager *manager = job->manager;
+    GCancellable *cancellable = g_task_get_cancellable(task);
+    
+    g_debug("Subscribing to podcast: %s", job->feed_url);
+    
+    FetchHints hints;
+    gchar *xml_data = fetch_url_with_handle(job->feed_url, (CURL *)manager->curl_handle,
+                                            cancellable, &hints);
+    if (!xml_data) {
+        if (!g_task_return_error_if_cancelled(task)) {
+            g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_FAILED,
+                                    "Failed to fetch feed: %s", job->feed_url);
+        }
+        return;
+    }
+    
+    Podcast *podcast = podcast_parse_feed_xml(xml_data, job->feed_url);
+    if (!podcast) {
+        g_free(xml_data);
+        g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                                "Not a valid podcast feed: %s", job->feed_url);
+        return;
+    }
+    
+    /* Save podcast to database */
+    gint podcast_id = database_add_podcast(manager->database, podcast->title, podcast->feed_url,
+                                          podcast->link, podcast->description, podcast->author,
+                                          podcast->image_url, podcast->language);
+    if (podcast_id < 0) {
+        g_free(xml_data);
+        podcast_free(podcast);
+        g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_FAILED,
+                                "Failed to save podcast to database (may already exist)");
+        return;
+    }
+    
+    podcast->id = podcast_id;
+    feed_save(manager, podcast_id, podcast, xml_data);
+    g_free(xml_data);
+    
+    podcast->next_refresh = podcast_compute_next_refresh(manager, podcast_id, podcast, &hints,
+                                                         podcast->last_fetched);
+    database_set_podcast_refresh(manager->database, podcast_id, podcast->last_fetched, podcast->next_refresh);
+    
+    g_debug("Subscribed to: %s", podcast->title);
+    
+    FeedResult *result = g_new0(FeedResult, 1);
+    result->manager = manager;
+    result->podcast_id = podcast_id;
+    result->parsed = podcast;
+    result->cancellable = g_object_ref(manager->cancellable);
+    g_main_context_invoke_full(job->context, G_PRIORITY_HIGH, feed_apply_subscribe, result, NULL);
+    
+    g_task_return_int(task, podcast_id);
+}
+
+static void feed_thread_func(gpointer data, gpointer user_data) {
+    GTask *task = G_TASK(data);
+    (void)user_data;
+    
+    if (g_task_get_source_tag(task) == podcast_manager_subscribe_async) {
+        feed_subscribe_run(task, (FeedSubscribeJob *)g_task_get_task_data(task));
+    } else if (g_task_get_source_tag(task) == podcast_index_transcripts_run) {
+        podcast_index_transcripts_run(task, (PodcastManager *)g_task_get_task_data(task));
+    } else {
+        feed_update_run(task, (FeedUpdateJob *)g_task_get_task_data(task));
+    }
+    
+    g_object_unref(task);
+}
+
+void podcast_manager_subscribe_async(PodcastManager *manager, const gchar *feed_url,
+                                     GCancellable *cancellable,
+                                     GAsyncReadyCallback callback, gpointer user_data) {
+    GTask *task = g_task_new(NULL, cancellable, callback, user_data);
+    g_task_set_source_tag(task, podcast_manager_subscribe_async);
+    
+    if (!manager || !feed_url || !manager->feed_pool) {
+        g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT, "Cannot subscribe");
+        g_object_unref(task);
+        return;
+    }
+    
+    /* Check if already subscribed - not an error, just already exists */
+    for (GList *l = manager->podcasts; l != NULL; l = l->next) {
+        Podcast *existing = (Podcast *)l->data;
+        if (g_strcmp0(existing->feed_url, feed_url) == 0) {
+            g_debug("Already subscribed to: %s", existing->title);
+            g_task_return_int(task, existing->id);
+            g_object_unref(task);
+            return;
+        }
+    }
+    
+    FeedSubscribeJob *job = g_new0(FeedSubscribeJob, 1);
+    job->manager = manager;
+    job->feed_url = g_strdup(feed_url);
+    job->context = g_main_context_ref_thread_default();
+    g_task_set_task_data(task, job, feed_subscribe_job_free);
+    
+    /* The pool takes over our reference */
+    g_thread_pool_push(manager->feed_pool, task, NULL);
+}
+
+gint podcast_manager_subscribe_finish(GAsyncResult *result, GError **error) {
+    return (gint)g_task_propagate_int(G_TASK(result), error);
+}
+
+static void feed_forward_cancel(GCancellable *cancellable, gpointer user_data) {
+    (void)cancellable;
+    g_cancellable_cancel(G_CANCELLABLE(user_data));
+}
+
+void podcast_manager_update_feeds_async(PodcastManager *manager, GList *podcast_ids,
+                                        GCancellable *cancellable,
+                                        FeedUpdateProgressCallback progress_callback,
+                                        gpointer progress_data,
+                                        GAsyncReadyCallback callback, gpointer user_data) {
+    if (!manager || !manager->feed_pool) {
+        g_task_report_new_error(NULL, callback, user_data, podcast_manager_update_feeds_async,
+                                G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT, "Cannot update feeds");
+        return;
+    }
+    
+    /* Don't start if already updating */
+    if (podcast_manager_is_updating(manager)) {
+        g_debug("Feed update already in progress");
+        g_task_report_new_error(NULL, callback, user_data, podcast_manager_update_feeds_async,
+                                G_IO_ERROR, G_IO_ERROR_PENDING, "A feed update is already in progress");
+        return;
+    }
+    
+    FeedUpdateJob *job = g_new0(FeedUpdateJob, 1);
+    job->manager = manager;
+    job->progress_callback = progress_callback;
+    job->progress_data = progress_data;
+    job->context = g_main_context_ref_thread_default();
+    
+    /* Snapshot what the worker needs so it never reads manager->podcasts */
+    for (GList *l = manager->podcasts; l != NULL; l = l->next) {
         Podcast *podcast = (Podcast *)l->data;
-        podcast_manager_update_feed(manager, podcast->id);
+        if (!podcast->feed_url) continue;
+        if (podcast_ids && !g_list_find(podcast_ids, GINT_TO_POINTER(podcast->id))) continue;
+        
+        FeedUpdateItem *item = g_new0(FeedUpdateItem, 1);
+        item->podcast_id = podcast->id;
+        item->feed_url = g_strdup(podcast->feed_url);
+        item->title = g_strdup(podcast->title);
+        job->items = g_list_prepend(job->items, item);
+    }
+    job->items = g_list_reverse(job->items);
+    
+    /* podcast_manager_cancel_updates and the caller's cancellable both stop this run */
+    g_clear_object(&manager->update_cancellable);
+    manager->update_cancellable = g_cancellable_new();
+    if (cancellable) {
+        job->cancellable = g_object_ref(cancellable);
+        job->cancel_id = g_cancellable_connect(cancellable, G_CALLBACK(feed_forward_cancel),
+                                               g_object_ref(manager->update_cancellable),
+                                               g_object_unref);
     }
     
-    manager->update_in_progress = FALSE;
-    manager->update_cancelled = FALSE;
+    GTask *task = g_task_new(NULL, manager->update_cancellable, callback, user_data);
+    g_task_set_source_tag(task, podcast_manager_update_feeds_async);
+    g_task_set_task_data(task, job, feed_update_job_free);
+    
+    g_debug("Checking %d podcast feed(s) for new episodes...", g_list_length(job->items));
+    
+    g_atomic_int_set(&manager->update_in_progress, TRUE);
+    g_thread_pool_push(manager->feed_pool, task, NULL);
+}
+
+gboolean podcast_manager_update_feeds_finish(GAsyncResult *result, GError **error) {
+    return g_task_propagate_boolean(G_TASK(result), error);
 }
 
 /* Cancel any ongoing feed updates */
 void podcast_manager_cancel_updates(PodcastManager *manager) {
     if (!manager) return;
     
-    if (manager->update_in_progress) {
-        manager->update_cancelled = TRUE;
+    if (podcast_manager_is_updating(manager) && manager->update_cancellable) {
+        g_cancellable_cancel(manager->update_cancellable);
         g_debug("Requesting feed update cancellation...");
     }
 }
 
 /* Check if feed update is in progress */
 gboolean podcast_manager_is_updating(PodcastManager *manager) {
-    return manager ? manager->update_in_progress : FALSE;
+    return manager ? g_atomic_int_get(&manager->update_in_progress) : FALSE;
 }
 
 /* Timer callback for automatic feed updates */
@@ -1395,8 +2123,24 @@ static gboolean podcast_update_timer_callback(gpointer user_data) {
     g_print("Podcast auto-update timer triggered\n");
     
     if (manager && manager->podcasts) {
-        g_print("Starting automatic feed update for %d podcast(s)\n", g_list_length(manager->podcasts));
-        podcast_manager_update_all_feeds(manager);
+        /* Only feeds whose scheduled refresh has come up */
+        gint64 now = g_get_real_time() / G_USEC_PER_SEC;
+        GList *due = NULL;
+        for (GList *l = manager->podcasts; l != NULL; l = l->next) {
+            Podcast *podcast = (Podcast *)l->data;
+            if (podcast->next_refresh <= now) {
+                due = g_list_prepend(due, GINT_TO_POINTER(podcast->id));
+            }
+        }
+        
+        if (due) {
+            g_print("Starting automatic feed update for %d of %d podcast(s)\n",
+                    g_list_length(due), g_list_length(manager->podcasts));
+            podcast_manager_update_feeds_async(manager, due, NULL, NULL, NULL, NULL, NULL);
+            g_list_free(due);
+        } else {
+            g_print("No podcast feeds are due for a refresh\n");
+        }
     } else {
         g_print("No podcasts to update (manager=%p, podcasts=%p)\n", 
                 (void*)manager, manager ? (void*)manager->podcasts : NULL);
@@ -1415,10 +2159,11 @@ void podcast_manager_start_auto_update(PodcastManager *manager, gint interval_mi
     manager->update_interval_minutes = interval_minutes;
     
     if (interval_minutes > 0) {
-        /* Convert minutes to seconds for GLib timer */
-        guint interval_seconds = interval_minutes * 60;
+        /* The interval bounds how stale a feed may get; ticks come often enough
+         * to catch each feed's own schedule and only refresh what is due */
+        guint interval_seconds = MIN((guint)interval_minutes * 60, REFRESH_MIN_INTERVAL);
         
-        g_print("Podcast auto-update: checking every %d minutes (%d hours, %d mins)\n",
+        g_print("Podcast auto-update: feeds refreshed at least every %d minutes (%d hours, %d mins)\n",
                 interval_minutes, interval_minutes / 60, interval_minutes % 60);
         
         manager->update_timer_id = g_timeout_add_seconds(
@@ -1434,6 +2179,75 @@ void podcast_manager_start_auto_update(PodcastManager *manager, gint interval_mi
     }
 }
 
+/* Push-style updates. Notifiers report changed feed URLs (podping relays
+ * report every feed on the network, so most are ignored); matching podcasts
+ * are collected for a few seconds and refreshed in one update. */
+
+#define FEED_NOTIFY_DELAY_SECONDS 5
+
+/* Feed URLs as reported may differ from ours in scheme */
+static const gchar* feed_url_without_scheme(const gchar *url) {
+    const gchar *rest = strstr(url, "://");
+    return rest ? rest + 3 : url;
+}
+
+static gboolean podcast_manager_flush_notified(gpointer user_data) {
+    PodcastManager *manager = (PodcastManager *)user_data;
+    
+    /* Try again once the running update is done */
+    if (podcast_manager_is_updating(manager)) {
+        return G_SOURCE_CONTINUE;
+    }
+    
+    manager->notify_timer_id = 0;
+    
+    g_print("Refreshing %d podcast feed(s) reported as changed\n", g_list_length(manager->notified_feeds));
+    podcast_manager_update_feeds_async(manager, manager->notified_feeds, NULL, NULL, NULL, NULL, NULL);
+    g_list_free(manager->notified_feeds);
+    manager->notified_feeds = NULL;
+    
+    return G_SOURCE_REMOVE;
+}
+
+static void on_feed_changed(const gchar *feed_url, gpointer user_data) {
+    PodcastManager *manager = (PodcastManager *)user_data;
+    const gchar *wanted = feed_url_without_scheme(feed_url);
+    
+    for (GList *l = manager->podcasts; l != NULL; l = l->next) {
+        Podcast *podcast = (Podcast *)l->data;
+        if (!podcast->feed_url || g_strcmp0(feed_url_without_scheme(podcast->feed_url), wanted) != 0) {
+            continue;
+        }
+        
+        g_debug("Feed change notification for: %s", podcast->title);
+        if (!g_list_find(manager->notified_feeds, GINT_TO_POINTER(podcast->id))) {
+            manager->notified_feeds = g_list_prepend(manager->notified_feeds, GINT_TO_POINTER(podcast->id));
+        }
+        if (manager->notify_timer_id == 0) {
+            manager->notify_timer_id = g_timeout_add_seconds(FEED_NOTIFY_DELAY_SECONDS,
+                                                             podcast_manager_flush_notified, manager);
+        }
+        break;
+    }
+}
+
+gboolean podcast_manager_add_notifier(PodcastManager *manager, FeedNotifier *notifier) {
+    if (!manager || !notifier) return FALSE;
+    
+    GError *error = NULL;
+    if (!feed_notifier_start(notifier, on_feed_changed, manager, &error)) {
+        g_warning("Failed to start %s feed notifier: %s", feed_notifier_get_name(notifier),
+                  error ? error->message : "unknown error");
+        g_clear_error(&error);
+        feed_notifier_unref(notifier);
+        return FALSE;
+    }
+    
+    g_print("Listening for feed changes (%s)\n", feed_notifier_get_name(notifier));
+    manager->notifiers = g_list_append(manager->notifiers, notifier);
+    return TRUE;
+}
+
 /* Stop automatic feed update timer */
 void podcast_manager_stop_auto_update(PodcastManager *manager) {
     if (!manager) return;
@@ -1455,52 +2269,587 @@ GList* podcast_manager_get_episodes(PodcastManager *manager, gint podcast_id) {
     return database_get_podcast_episodes(manager->database, podcast_id);
 }
 
-GList* podcast_manager_get_live_items(PodcastManager *manager, gint podcast_id) {
-    if (!manager) return NULL;
+GList* podcast_manager_get_live_items(PodcastManager *manager, gint podcast_id) {
+    if (!manager) return NULL;
+    
+    /* Find the podcast and return its live items */
+    for (GList *l = manager->podcasts; l != NULL; l = l->next) {
+        Podcast *p = (Podcast *)l->data;
+        if (p->id == podcast_id) {
+            /* Return a deep copy of the live items list */
+            return g_list_copy_deep(p->live_items, (GCopyFunc)podcast_live_item_copy, NULL);
+        }
+    }
+    
+    return NULL;
+}
+
+/* Enclosures at least this large may be fetched as parallel byte ranges */
+#define DOWNLOAD_SEGMENT_MIN_SIZE (32 * 1024 * 1024)
+#define DOWNLOAD_MAX_SEGMENTS 8
+
+/* Per-download state shared between the worker thread and curl callbacks */
+typedef struct {
+    DownloadTask *task;
+    FILE *fp;
+    const gchar *part_path;
+    CURL *curl;
+    curl_off_t resume_from;   /* Bytes already on disk when the request started */
+    gboolean range_checked;   /* Response code inspected on first write */
+    curl_off_t max_speed;     /* Bytes/s cap for this download, 0 = unlimited */
+    long response_code;       /* HTTP status of the last request */
+    gpointer write_buffer;    /* stdio buffer for fp */
+    gint64 last_progress;     /* Monotonic time of the last progress notification */
+} DownloadContext;
+
+/* One byte range of a segmented download */
+typedef struct {
+    DownloadContext *ctx;
+    FILE *fp;
+    gpointer write_buffer;
+    curl_off_t start;
+    curl_off_t end;           /* Inclusive */
+    curl_off_t received;
+} DownloadSegment;
+
+/* Downloads are written through a large page-aligned stdio buffer so the
+ * many small chunks libcurl delivers turn into few large write() calls */
+#define DOWNLOAD_WRITE_BUFFER_SIZE (1024 * 1024)
+#define DOWNLOAD_WRITE_BUFFER_ALIGN 4096
+
+/* At most this often per download, so parallel downloads don't flood the main loop */
+#define DOWNLOAD_PROGRESS_INTERVAL (250 * G_TIME_SPAN_MILLISECOND)
+
+static gpointer download_buffer_new(void) {
+#ifdef _WIN32
+    return _aligned_malloc(DOWNLOAD_WRITE_BUFFER_SIZE, DOWNLOAD_WRITE_BUFFER_ALIGN);
+#else
+    void *buffer = NULL;
+    if (posix_memalign(&buffer, DOWNLOAD_WRITE_BUFFER_ALIGN, DOWNLOAD_WRITE_BUFFER_SIZE) != 0) {
+        return NULL;
+    }
+    return buffer;
+#endif
+}
+
+static void download_buffer_free(gpointer buffer) {
+    if (!buffer) return;
+#ifdef _WIN32
+    _aligned_free(buffer);
+#else
+    free(buffer);
+#endif
+}
+
+/* Attach buffer to a freshly opened stream; falls back to default buffering */
+static void download_file_set_buffer(FILE *fp, gpointer buffer) {
+    if (fp && buffer) {
+        setvbuf(fp, buffer, _IOFBF, DOWNLOAD_WRITE_BUFFER_SIZE);
+    }
+}
+
+/* Reserve disk space for length more bytes after offset without changing the
+ * file size, which resuming relies on. Best effort: only Linux can do this. */
+static void download_file_reserve(FILE *fp, curl_off_t offset, curl_off_t length) {
+#ifdef __linux__
+    if (length > 0 && fallocate(fileno(fp), FALLOC_FL_KEEP_SIZE, (off_t)offset, (off_t)length) != 0) {
+        g_debug("Could not preallocate %" CURL_FORMAT_CURL_OFF_T " bytes: %s", length, g_strerror(errno));
+    }
+#else
+    (void)fp;
+    (void)offset;
+    (void)length;
+#endif
+}
+
+/* Size a segmented download's part file to its full length up front */
+static gboolean download_file_preallocate(FILE *fp, curl_off_t length) {
+#ifdef _WIN32
+    return _chsize_s(_fileno(fp), (__int64)length) == 0;
+#else
+    int fd = fileno(fp);
+    /* posix_fallocate fails on filesystems without support; a sparse file still works */
+    return posix_fallocate(fd, 0, (off_t)length) == 0 || ftruncate(fd, (off_t)length) == 0;
+#endif
+}
+
+static void download_report_progress(DownloadContext *ctx, curl_off_t now, curl_off_t total) {
+    DownloadTask *task = ctx->task;
+    if (total <= 0 || !task->progress_callback) return;
+    
+    gint64 time_now = g_get_monotonic_time();
+    if (time_now - ctx->last_progress < DOWNLOAD_PROGRESS_INTERVAL) return;
+    ctx->last_progress = time_now;
+    
+    gdouble progress = (gdouble)now / (gdouble)total;
+    gchar *status = g_strdup_printf("Downloading: %.1f MB / %.1f MB",
+                                   now / 1048576.0, total / 1048576.0);
+    task->progress_callback(task->user_data, task->episode->id, progress, status);
+    g_free(status);
+}
+
+static size_t write_file_callback(void *ptr, size_t size, size_t nmemb, void *userp) {
+    DownloadContext *ctx = (DownloadContext *)userp;
+    
+    /* Reserve the rest of the file now to limit fragmentation */
+    if (!ctx->range_checked) {
+        ctx->range_checked = TRUE;
+        curl_off_t remaining = -1;
+        curl_easy_getinfo(ctx->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &remaining);
+        download_file_reserve(ctx->fp, ctx->resume_from, remaining);
+    }
+    
+    return fwrite(ptr, size, nmemb, ctx->fp);
+}
+
+static size_t write_segment_callback(void *ptr, size_t size, size_t nmemb, void *userp) {
+    DownloadSegment *seg = (DownloadSegment *)userp;
+    return fwrite(ptr, size, nmemb, seg->fp);
+}
+
+/* Progress callback for curl */
+static int download_progress_callback(void *clientp, curl_off_t dltotal, curl_off_t dlnow, 
+                                      curl_off_t ultotal, curl_off_t ulnow) {
+    (void)ultotal;
+    (void)ulnow;
+    
+    DownloadContext *ctx = (DownloadContext *)clientp;
+    
+    /* Check if download was cancelled */
+    if (ctx->task->cancelled) {
+        return 1;  /* Non-zero return value cancels download */
+    }
+    
+    /* dltotal/dlnow only cover the requested range, add what was already on disk */
+    if (dltotal > 0) {
+        download_report_progress(ctx, ctx->resume_from + dlnow, ctx->resume_from + dltotal);
+    }
+    
+    return 0;
+}
+
+static int download_segment_progress_callback(void *clientp, curl_off_t dltotal, curl_off_t dlnow,
+                                              curl_off_t ultotal, curl_off_t ulnow) {
+    (void)dltotal;
+    (void)ultotal;
+    (void)ulnow;
+    
+    DownloadSegment *seg = (DownloadSegment *)clientp;
+    seg->received = dlnow;
+    return seg->ctx->task->cancelled ? 1 : 0;
+}
+
+static void download_setup_handle(CURL *curl, const gchar *url, curl_off_t max_speed) {
+    curl_easy_setopt(curl, CURLOPT_URL, url);
+    if (max_speed > 0) {
+        curl_easy_setopt(curl, CURLOPT_MAX_RECV_SPEED_LARGE, max_speed);
+    }
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 600L);  /* 10 minute timeout */
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "Shriek Media Player/1.0");
+}
+
+static size_t probe_header_callback(char *buffer, size_t size, size_t nitems, void *userp) {
+    size_t len = size * nitems;
+    gboolean *accepts_ranges = (gboolean *)userp;
+    
+    if (len >= 20 && g_ascii_strncasecmp(buffer, "Accept-Ranges:", 14) == 0) {
+        gchar *value = g_strstrip(g_strndup(buffer + 14, len - 14));
+        *accepts_ranges = (g_ascii_strcasecmp(value, "bytes") == 0);
+        g_free(value);
+    }
+    
+    return len;
+}
+
+/* HEAD the enclosure to learn its size and whether byte ranges are honoured */
+static curl_off_t download_probe_length(const gchar *url, gboolean *accepts_ranges) {
+    CURL *curl = curl_easy_init();
+    curl_off_t length = -1;
+    
+    *accepts_ranges = FALSE;
+    if (!curl) return -1;
+    
+    download_setup_handle(curl, url, 0);
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, probe_header_callback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, accepts_ranges);
+    
+    if (curl_easy_perform(curl) == CURLE_OK) {
+        curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+    }
+    curl_easy_cleanup(curl);
+    
+    return length;
+}
+
+/* Fetch [0, total) into part_path as n_segments concurrent range requests.
+ * The part file must already be preallocated to the full size. */
+static CURLcode download_segmented(DownloadContext *ctx, const gchar *url,
+                                   curl_off_t total, gint n_segments) {
+    CURLM *multi = curl_multi_init();
+    if (!multi) return CURLE_FAILED_INIT;
+    
+    DownloadSegment *segs = g_new0(DownloadSegment, n_segments);
+    CURL **handles = g_new0(CURL *, n_segments);
+    curl_off_t seg_size = total / n_segments;
+    CURLcode result = CURLE_OK;
+    
+    for (gint i = 0; i < n_segments; i++) {
+        segs[i].ctx = ctx;
+        segs[i].start = i * seg_size;
+        segs[i].end = (i == n_segments - 1) ? total - 1 : (i + 1) * seg_size - 1;
+        segs[i].fp = fopen(ctx->part_path, "r+b");
+        segs[i].write_buffer = download_buffer_new();
+        download_file_set_buffer(segs[i].fp, segs[i].write_buffer);
+        if (!segs[i].fp || fseeko(segs[i].fp, (off_t)segs[i].start, SEEK_SET) != 0) {
+            result = CURLE_WRITE_ERROR;
+            goto cleanup;
+        }
+        
+        handles[i] = curl_easy_init();
+        if (!handles[i]) {
+            result = CURLE_FAILED_INIT;
+            goto cleanup;
+        }
+        
+        gchar *range = g_strdup_printf("%" CURL_FORMAT_CURL_OFF_T "-%" CURL_FORMAT_CURL_OFF_T,
+                                       segs[i].start, segs[i].end);
+        download_setup_handle(handles[i], url, ctx->max_speed / n_segments);
+        curl_easy_setopt(handles[i], CURLOPT_RANGE, range);
+        curl_easy_setopt(handles[i], CURLOPT_WRITEFUNCTION, write_segment_callback);
+        curl_easy_setopt(handles[i], CURLOPT_WRITEDATA, &segs[i]);
+        curl_easy_setopt(handles[i], CURLOPT_XFERINFOFUNCTION, download_segment_progress_callback);
+        curl_easy_setopt(handles[i], CURLOPT_XFERINFODATA, &segs[i]);
+        curl_easy_setopt(handles[i], CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(handles[i], CURLOPT_PRIVATE, &segs[i]);
+        g_free(range);
+        
+        curl_multi_add_handle(multi, handles[i]);
+    }
+    
+    int running = 0;
+    do {
+        CURLMcode mc = curl_multi_perform(multi, &running);
+        if (mc == CURLM_OK && running) {
+            mc = curl_multi_wait(multi, NULL, 0, 500, NULL);
+        }
+        if (mc != CURLM_OK) {
+            result = CURLE_RECV_ERROR;
+            break;
+        }
+        
+        int msgs_left = 0;
+        CURLMsg *msg;
+        while ((msg = curl_multi_info_read(multi, &msgs_left))) {
+            if (msg->msg != CURLMSG_DONE) continue;
+            
+            long response_code = 0;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &response_code);
+            if (msg->data.result != CURLE_OK) {
+                result = msg->data.result;
+            } else if (response_code != 206) {
+                /* Full body instead of the requested range would corrupt the file */
+                result = CURLE_RANGE_ERROR;
+            }
+        }
+        if (result != CURLE_OK) break;
+        
+        curl_off_t now = 0;
+        for (gint i = 0; i < n_segments; i++) {
+            now += segs[i].received;
+        }
+        download_report_progress(ctx, now, total);
+    } while (running && !ctx->task->cancelled);
+    
+    if (ctx->task->cancelled) {
+        result = CURLE_ABORTED_BY_CALLBACK;
+    }
+    
+cleanup:
+    for (gint i = 0; i < n_segments; i++) {
+        if (handles[i]) {
+            curl_multi_remove_handle(multi, handles[i]);
+            curl_easy_cleanup(handles[i]);
+        }
+        if (segs[i].fp && fclose(segs[i].fp) != 0 && result == CURLE_OK) {
+            result = CURLE_WRITE_ERROR;
+        }
+        download_buffer_free(segs[i].write_buffer);
+    }
+    curl_multi_cleanup(multi);
+    g_free(handles);
+    g_free(segs);
+    
+    return result;
+}
+
+/* One transfer of url into part_path starting at resume_from */
+static CURLcode download_resumable_attempt(DownloadContext *ctx, const gchar *url,
+                                           curl_off_t resume_from, curl_off_t *out_total) {
+    ctx->resume_from = resume_from;
+    ctx->range_checked = FALSE;
+    
+    ctx->curl = curl_easy_init();
+    if (!ctx->curl) return CURLE_FAILED_INIT;
+    
+    ctx->fp = fopen(ctx->part_path, ctx->resume_from > 0 ? "ab" : "wb");
+    download_file_set_buffer(ctx->fp, ctx->write_buffer);
+    if (!ctx->fp) {
+        curl_easy_cleanup(ctx->curl);
+        ctx->curl = NULL;
+        return CURLE_WRITE_ERROR;
+    }
+    
+    if (ctx->resume_from > 0) {
+        g_debug("Resuming %s at %" CURL_FORMAT_CURL_OFF_T " bytes", url, ctx->resume_from);
+    }
+    
+    download_setup_handle(ctx->curl, url, ctx->max_speed);
+    curl_easy_setopt(ctx->curl, CURLOPT_RESUME_FROM_LARGE, ctx->resume_from);
+    curl_easy_setopt(ctx->curl, CURLOPT_WRITEFUNCTION, write_file_callback);
+    curl_easy_setopt(ctx->curl, CURLOPT_WRITEDATA, ctx);
+    
+    /* Set up progress tracking */
+    curl_easy_setopt(ctx->curl, CURLOPT_XFERINFOFUNCTION, download_progress_callback);
+    curl_easy_setopt(ctx->curl, CURLOPT_XFERINFODATA, ctx);
+    curl_easy_setopt(ctx->curl, CURLOPT_NOPROGRESS, 0L);
+    
+    CURLcode res = curl_easy_perform(ctx->curl);
+    
+    long response_code = 0;
+    curl_off_t remaining = -1;
+    curl_easy_getinfo(ctx->curl, CURLINFO_RESPONSE_CODE, &response_code);
+    ctx->response_code = response_code;
+    curl_easy_getinfo(ctx->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &remaining);
+    
+    if (ctx->fp && fclose(ctx->fp) != 0 && res == CURLE_OK) {
+        res = CURLE_WRITE_ERROR;
+    }
+    ctx->fp = NULL;
+    curl_easy_cleanup(ctx->curl);
+    ctx->curl = NULL;
+    
+    /* 416 on a resume usually means the part file already holds the whole
+     * body; leave the total unknown so the size check falls back to the feed. */
+    if (res == CURLE_HTTP_RETURNED_ERROR && response_code == 416 && ctx->resume_from > 0) {
+        *out_total = -1;
+        return CURLE_OK;
+    }
+    
+    /* A 200 whose length matches the part file means curl found the document
+     * already complete and skipped the body; the length is the full size. */
+    if (res == CURLE_OK && response_code == 200 && ctx->resume_from > 0 &&
+        remaining == ctx->resume_from) {
+        *out_total = ctx->resume_from;
+        return CURLE_OK;
+    }
+    
+    *out_total = (res == CURLE_OK && remaining >= 0) ? ctx->resume_from + remaining : -1;
+    return res;
+}
+
+/* Fetch url into part_path, appending to whatever is already there */
+static CURLcode download_resumable(DownloadContext *ctx, const gchar *url, curl_off_t *out_total) {
+    GStatBuf st;
+    curl_off_t resume_from = (g_stat(ctx->part_path, &st) == 0) ? (curl_off_t)st.st_size : 0;
+    
+    CURLcode res = download_resumable_attempt(ctx, url, resume_from, out_total);
+    
+    /* curl refuses a 200 answer to a range request, so a server without range
+     * support would fail every retry; start the part file over instead. */
+    if (res == CURLE_RANGE_ERROR && resume_from > 0 && !ctx->task->cancelled) {
+        g_debug("Server ignored range request, restarting %s", ctx->part_path);
+        res = download_resumable_attempt(ctx, url, 0, out_total);
+    }
+    
+    return res;
+}
+
+/* Build the on-disk path for an episode's enclosure */
+static gchar* download_local_path(PodcastManager *manager, PodcastEpisode *episode) {
+    gchar *basename = g_path_get_basename(episode->enclosure_url);
+    
+    /* Clean up filename - remove query strings */
+    gchar *query = strchr(basename, '?');
+    if (query) *query = '\0';
+    
+    gchar *path = g_build_filename(manager->download_dir, basename, NULL);
+    g_free(basename);
+    return path;
+}
+
+/* Download scheduler.
+ *
+ * Every queued or running download has a DownloadTask in active_downloads and
+ * a row in the download_queue table. Waiting tasks sit in manager->download_queue
+ * ordered by priority, then enqueue order. download_scheduler_pump_locked()
+ * hands tasks to the pool while the global and per-host limits allow it; it
+ * runs whenever a download is queued or finishes, and from a timer when a
+ * retry backoff expires. All of this is guarded by downloads_mutex. */
+
+#define DOWNLOAD_RETRY_BASE_SECONDS 30
+#define DOWNLOAD_RETRY_MAX_SECONDS 3600
+
+static void download_task_free(DownloadTask *task) {
+    if (!task) return;
+    
+    /* The episode is the minimal copy made when the task was queued */
+    if (task->episode) {
+        g_free(task->episode->enclosure_url);
+        g_free(task->episode->title);
+        g_free(task->episode->chapters_url);
+        g_free(task->episode->transcript_url);
+        g_free(task->episode->transcript_type);
+        g_free(task->episode);
+    }
+    g_free(task->host);
+    g_free(task);
+}
+
+static gint download_task_compare(gconstpointer a, gconstpointer b) {
+    const DownloadTask *ta = (const DownloadTask *)a;
+    const DownloadTask *tb = (const DownloadTask *)b;
+    
+    if (ta->priority != tb->priority) {
+        return (ta->priority > tb->priority) ? -1 : 1;
+    }
+    return (ta->sequence < tb->sequence) ? -1 : (ta->sequence > tb->sequence);
+}
+
+static gchar* download_url_host(const gchar *url) {
+    GUri *uri = g_uri_parse(url, G_URI_FLAGS_NONE, NULL);
+    gchar *host = NULL;
     
-    /* Find the podcast and return its live items */
-    for (GList *l = manager->podcasts; l != NULL; l = l->next) {
-        Podcast *p = (Podcast *)l->data;
-        if (p->id == podcast_id) {
-            /* Return a deep copy of the live items list */
-            return g_list_copy_deep(p->live_items, (GCopyFunc)podcast_live_item_copy, NULL);
-        }
+    if (uri) {
+        host = g_ascii_strdown(g_uri_get_host(uri) ? g_uri_get_host(uri) : "", -1);
+        g_uri_unref(uri);
     }
-    
-    return NULL;
+    return host ? host : g_strdup("");
 }
 
-static size_t write_file_callback(void *ptr, size_t size, size_t nmemb, FILE *stream) {
-    return fwrite(ptr, size, nmemb, stream);
+static DownloadTask* download_task_new(PodcastManager *manager, PodcastEpisode *episode,
+                                       DownloadPriority priority) {
+    /* Create a minimal copy of the episode for the download thread.
+     * This avoids ownership issues - caller keeps ownership of original episode. */
+    PodcastEpisode *episode_copy = g_new0(PodcastEpisode, 1);
+    episode_copy->id = episode->id;
+    episode_copy->podcast_id = episode->podcast_id;
+    episode_copy->enclosure_url = g_strdup(episode->enclosure_url);
+    episode_copy->title = g_strdup(episode->title);
+    episode_copy->enclosure_length = episode->enclosure_length;
+    episode_copy->chapters_url = g_strdup(episode->chapters_url);
+    episode_copy->transcript_url = g_strdup(episode->transcript_url);
+    episode_copy->transcript_type = g_strdup(episode->transcript_type);
+    
+    DownloadTask *task = g_new0(DownloadTask, 1);
+    task->episode = episode_copy;  /* Task owns this copy */
+    task->manager = manager;
+    task->priority = priority;
+    task->host = download_url_host(episode->enclosure_url);
+    task->sequence = manager->download_sequence++;
+    return task;
 }
 
-/* Progress callback for curl */
-static int download_progress_callback(void *clientp, curl_off_t dltotal, curl_off_t dlnow, 
-                                      curl_off_t ultotal, curl_off_t ulnow) {
-    (void)ultotal;
-    (void)ulnow;
+static gboolean download_retry_timeout_cb(gpointer user_data);
+
+/* Start whatever the limits allow. Must be called with downloads_mutex held. */
+static void download_scheduler_pump_locked(PodcastManager *manager) {
+    if (manager->shutting_down || !manager->download_pool) return;
     
-    DownloadTask *task = (DownloadTask *)clientp;
+    gint64 now = g_get_monotonic_time();
+    gint64 wake_at = G_MAXINT64;
+    GList *l = manager->download_queue;
     
-    /* Check if download was cancelled */
-    if (task->cancelled) {
-        return 1;  /* Non-zero return value cancels download */
+    while (l) {
+        GList *next = l->next;
+        DownloadTask *task = (DownloadTask *)l->data;
+        
+        if (task->next_attempt > now) {
+            wake_at = MIN(wake_at, task->next_attempt);
+            l = next;
+            continue;
+        }
+        if (manager->running_downloads >= manager->max_downloads) {
+            break;
+        }
+        
+        gint host_running = GPOINTER_TO_INT(g_hash_table_lookup(manager->downloads_per_host, task->host));
+        if (manager->max_downloads_per_host > 0 && host_running >= manager->max_downloads_per_host) {
+            l = next;
+            continue;
+        }
+        
+        GError *error = NULL;
+        g_thread_pool_push(manager->download_pool, task, &error);
+        if (error) {
+            g_warning("Failed to queue download: %s", error->message);
+            g_error_free(error);
+            break;
+        }
+        
+        manager->download_queue = g_list_delete_link(manager->download_queue, l);
+        task->running = TRUE;
+        manager->running_downloads++;
+        g_hash_table_insert(manager->downloads_per_host, g_strdup(task->host),
+                            GINT_TO_POINTER(host_running + 1));
+        l = next;
+    }
+    
+    /* Wake up again when the earliest backoff expires */
+    if (wake_at != G_MAXINT64 &&
+        (manager->download_retry_id == 0 || wake_at < manager->download_retry_at)) {
+        if (manager->download_retry_id > 0) {
+            g_source_remove(manager->download_retry_id);
+        }
+        guint delay_ms = (guint)MIN((wake_at - now) / 1000 + 1, (gint64)G_MAXUINT);
+        manager->download_retry_at = wake_at;
+        manager->download_retry_id = g_timeout_add(delay_ms, download_retry_timeout_cb, manager);
     }
+}
+
+static gboolean download_retry_timeout_cb(gpointer user_data) {
+    PodcastManager *manager = (PodcastManager *)user_data;
+    
+    g_mutex_lock(&manager->downloads_mutex);
+    manager->download_retry_id = 0;
+    download_scheduler_pump_locked(manager);
+    g_mutex_unlock(&manager->downloads_mutex);
+    
+    return G_SOURCE_REMOVE;
+}
+
+/* Re-queue the tasks persisted in the download_queue table */
+static void podcast_manager_restore_downloads(PodcastManager *manager) {
+    GList *entries = database_get_download_queue(manager->database);
+    gint64 now_real = g_get_real_time() / G_USEC_PER_SEC;
+    gint64 now = g_get_monotonic_time();
     
-    /* Calculate progress */
-    if (dltotal > 0 && task->progress_callback) {
-        gdouble progress = (gdouble)dlnow / (gdouble)dltotal;
+    g_mutex_lock(&manager->downloads_mutex);
+    for (GList *l = entries; l != NULL; l = l->next) {
+        DownloadQueueEntry *entry = (DownloadQueueEntry *)l->data;
+        PodcastEpisode *episode = database_get_episode_by_id(manager->database, entry->episode_id);
         
-        /* Format status message */
-        gchar *status = g_strdup_printf("Downloading: %.1f MB / %.1f MB", 
-                                       dlnow / 1048576.0, dltotal / 1048576.0);
+        if (!episode || episode->downloaded || !episode->enclosure_url) {
+            database_remove_download(manager->database, entry->episode_id);
+        } else if (!g_hash_table_contains(manager->active_downloads, GINT_TO_POINTER(episode->id))) {
+            DownloadTask *task = download_task_new(manager, episode, (DownloadPriority)entry->priority);
+            task->attempts = entry->attempts;
+            if (entry->next_attempt > now_real) {
+                task->next_attempt = now + (entry->next_attempt - now_real) * G_USEC_PER_SEC;
+            }
+            g_hash_table_insert(manager->active_downloads, GINT_TO_POINTER(episode->id), task);
+            manager->download_queue = g_list_insert_sorted(manager->download_queue, task, download_task_compare);
+        }
         
-        /* Call progress callback on main thread */
-        task->progress_callback(task->user_data, task->episode->id, progress, status);
-        g_free(status);
+        if (episode) podcast_episode_free(episode);
     }
+    download_scheduler_pump_locked(manager);
+    g_mutex_unlock(&manager->downloads_mutex);
     
-    return 0;
+    g_list_free_full(entries, g_free);
 }
 
 /* Thread function for downloading */
@@ -1511,172 +2860,338 @@ static void download_thread_func(gpointer data, gpointer user_data) {
     (void)user_data;
     
     gboolean success = FALSE;
+    gboolean retryable = TRUE;
     gchar *error_msg = NULL;
     gchar *local_path = NULL;
+    gchar *part_path = NULL;
+    CURLcode res = CURLE_OK;
+    curl_off_t total = -1;
     
     /* Create download directory if it doesn't exist */
     g_mkdir_with_parents(manager->download_dir, 0755);
     
-    /* Generate local filename */
-    gchar *basename = g_path_get_basename(episode->enclosure_url);
-    gchar *safe_basename = g_strdup(basename);
-    
-    /* Clean up filename - remove query strings */
-    gchar *query = strchr(safe_basename, '?');
-    if (query) *query = '\0';
-    
-    local_path = g_build_filename(manager->download_dir, safe_basename, NULL);
-    g_free(basename);
-    g_free(safe_basename);
+    local_path = download_local_path(manager, episode);
+    part_path = g_strconcat(local_path, ".part", NULL);
     
     if (task->progress_callback) {
         task->progress_callback(task->user_data, episode->id, 0.0, "Initializing download...");
     }
     
-    /* Download file using curl */
-    CURL *curl = curl_easy_init();
-    if (!curl) {
-        error_msg = g_strdup("Failed to initialize curl");
-        goto cleanup;
-    }
+    DownloadContext ctx = { .task = task, .part_path = part_path };
+    ctx.write_buffer = download_buffer_new();
     
-    FILE *fp = fopen(local_path, "wb");
-    if (!fp) {
-        error_msg = g_strdup_printf("Failed to open file for writing: %s", local_path);
-        curl_easy_cleanup(curl);
-        goto cleanup;
+    /* Split the bandwidth cap evenly between the downloads running right now */
+    if (manager->download_rate_limit > 0) {
+        g_mutex_lock(&manager->downloads_mutex);
+        ctx.max_speed = manager->download_rate_limit / MAX(1, manager->running_downloads);
+        g_mutex_unlock(&manager->downloads_mutex);
     }
     
-    curl_easy_setopt(curl, CURLOPT_URL, episode->enclosure_url);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_file_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 600L);  /* 10 minute timeout */
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, "Shriek Media Player/1.0");
-    
-    /* Set up progress tracking */
-    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, download_progress_callback);
-    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, task);
-    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    /* Large enclosures with no partial data can be split into parallel ranges */
+    gint n_segments = database_get_preference_int(manager->database, "podcast_download_segments", 1);
+    n_segments = CLAMP(n_segments, 1, DOWNLOAD_MAX_SEGMENTS);
     
-    CURLcode res = curl_easy_perform(curl);
+    if (n_segments > 1 && episode->enclosure_length >= DOWNLOAD_SEGMENT_MIN_SIZE &&
+        !g_file_test(part_path, G_FILE_TEST_EXISTS)) {
+        gboolean accepts_ranges = FALSE;
+        curl_off_t length = download_probe_length(episode->enclosure_url, &accepts_ranges);
+        
+        if (accepts_ranges && length >= DOWNLOAD_SEGMENT_MIN_SIZE) {
+            FILE *fp = fopen(part_path, "wb");
+            gboolean sized = fp && download_file_preallocate(fp, length);
+            if (fp) fclose(fp);
+            
+            res = sized ? download_segmented(&ctx, episode->enclosure_url, length, n_segments)
+                        : CURLE_WRITE_ERROR;
+            if (res == CURLE_OK) {
+                total = length;
+            } else {
+                /* Segments finish out of order, so the file cannot be resumed */
+                g_unlink(part_path);
+                if (!task->cancelled) {
+                    g_debug("Segmented download failed (%s), retrying as a single stream",
+                            curl_easy_strerror(res));
+                }
+            }
+        }
+    }
     
-    fclose(fp);
-    curl_easy_cleanup(curl);
+    if (total < 0 && !task->cancelled) {
+        res = download_resumable(&ctx, episode->enclosure_url, &total);
+    }
     
-    if (res != CURLE_OK) {
+    if (res != CURLE_OK || task->cancelled) {
         if (task->cancelled) {
             error_msg = g_strdup("Download cancelled");
+            /* On shutdown the part file is kept so the download resumes next start */
+            if (!manager->shutting_down) {
+                g_unlink(part_path);
+            }
         } else {
+            /* Keep the part file so the next attempt can resume */
             error_msg = g_strdup_printf("Download failed: %s", curl_easy_strerror(res));
+            /* Client errors other than timeouts and rate limiting won't fix themselves */
+            if (ctx.response_code >= 400 && ctx.response_code < 500 &&
+                ctx.response_code != 408 && ctx.response_code != 429) {
+                retryable = FALSE;
+            }
         }
-        unlink(local_path);
+        goto cleanup;
+    }
+    
+    /* Verify the size before exposing the file. Prefer the length the server
+     * reported, falling back to the feed's enclosure length. */
+    GStatBuf st;
+    gint64 expected = total >= 0 ? (gint64)total : episode->enclosure_length;
+    if (g_stat(part_path, &st) != 0 || (expected > 0 && (gint64)st.st_size != expected)) {
+        error_msg = g_strdup_printf("Downloaded file is incomplete (%" G_GINT64_FORMAT " of %" G_GINT64_FORMAT " bytes)",
+                                    (gint64)st.st_size, expected);
+        g_unlink(part_path);
+        goto cleanup;
+    }
+    if (total >= 0 && episode->enclosure_length > 0 && episode->enclosure_length != (gint64)total) {
+        g_debug("Feed enclosure length %" G_GINT64_FORMAT " differs from served size %" G_GINT64_FORMAT,
+                episode->enclosure_length, (gint64)total);
+    }
+    
+    if (g_rename(part_path, local_path) != 0) {
+        error_msg = g_strdup_printf("Failed to move download into place: %s", local_path);
         goto cleanup;
     }
     
     /* Update database */
     database_update_episode_downloaded(manager->database, episode->id, local_path);
     
+    /* Prefetch the sidecar files so chapters and transcript work offline */
+    g_free(podcast_sidecar_fetch(episode->chapters_url, TRUE));
+    g_free(podcast_sidecar_fetch(episode->transcript_url, TRUE));
+    
+    /* ...and so the spoken text can be searched */
+    if (episode->transcript_url) {
+        podcast_index_transcript(manager->database, episode->id,
+                                 episode->transcript_url, episode->transcript_type);
+    }
+    
     success = TRUE;
     
 cleanup:
-    /* Remove from active downloads */
+    g_free(local_path);
+    g_free(part_path);
+    download_buffer_free(ctx.write_buffer);
+    
+    gboolean retry = FALSE;
+    gint delay = 0;
+    
     g_mutex_lock(&manager->downloads_mutex);
-    g_hash_table_remove(manager->active_downloads, GINT_TO_POINTER(episode->id));
+    manager->running_downloads--;
+    gint host_running = GPOINTER_TO_INT(g_hash_table_lookup(manager->downloads_per_host, task->host));
+    if (host_running > 1) {
+        g_hash_table_insert(manager->downloads_per_host, g_strdup(task->host), GINT_TO_POINTER(host_running - 1));
+    } else {
+        g_hash_table_remove(manager->downloads_per_host, task->host);
+    }
+    task->running = FALSE;
+    
+    if (!success && !task->cancelled && retryable && !manager->shutting_down &&
+        task->attempts < manager->max_download_retries) {
+        /* Exponential backoff: 30s, 60s, 120s, ... capped at an hour */
+        delay = MIN(DOWNLOAD_RETRY_BASE_SECONDS << MIN(task->attempts, 16), DOWNLOAD_RETRY_MAX_SECONDS);
+        task->attempts++;
+        task->next_attempt = g_get_monotonic_time() + (gint64)delay * G_USEC_PER_SEC;
+        manager->download_queue = g_list_insert_sorted(manager->download_queue, task, download_task_compare);
+        retry = TRUE;
+    } else {
+        /* Remove from active downloads */
+        g_hash_table_remove(manager->active_downloads, GINT_TO_POINTER(episode->id));
+    }
+    download_scheduler_pump_locked(manager);
     g_mutex_unlock(&manager->downloads_mutex);
     
+    if (retry) {
+        database_update_download_retry(manager->database, episode->id, task->attempts,
+                                       g_get_real_time() / G_USEC_PER_SEC + delay, error_msg);
+        if (task->progress_callback) {
+            gchar *status = g_strdup_printf("%s - retrying in %d s (attempt %d of %d)",
+                                            error_msg, delay, task->attempts + 1,
+                                            manager->max_download_retries + 1);
+            task->progress_callback(task->user_data, episode->id, 0.0, status);
+            g_free(status);
+        }
+        g_free(error_msg);
+        return;  /* The scheduler owns the task again */
+    }
+    
+    /* An interrupted download stays queued in the database for the next start */
+    if (success || !manager->shutting_down) {
+        database_remove_download(manager->database, episode->id);
+    }
+    
     /* Call completion callback */
-    if (task->complete_callback) {
+    if (task->complete_callback && !manager->shutting_down) {
         task->complete_callback(task->user_data, episode->id, success, error_msg);
     }
     
-    g_free(local_path);
     g_free(error_msg);
+    download_task_free(task);
+}
+
+void podcast_episode_queue_download(PodcastManager *manager, PodcastEpisode *episode,
+                                    DownloadPriority priority,
+                                    DownloadProgressCallback progress_cb,
+                                    DownloadCompleteCallback complete_cb,
+                                    gpointer user_data) {
+    if (!manager || !episode || !episode->enclosure_url) return;
     
-    /* Free the minimal episode copy created in podcast_episode_download */
-    g_free(episode->enclosure_url);
-    g_free(episode->title);
-    g_free(episode);
+    /* Persist first so a fast-finishing worker can't delete the row before it exists */
+    database_enqueue_download(manager->database, episode->id, priority);
     
-    g_free(task);
+    g_mutex_lock(&manager->downloads_mutex);
+    DownloadTask *task = g_hash_table_lookup(manager->active_downloads, GINT_TO_POINTER(episode->id));
+    if (task) {
+        /* Already queued (possibly restored at startup) - attach the caller's
+         * callbacks and, if it is still waiting, bump it up the queue */
+        g_debug("Episode is already queued for download");
+        if (progress_cb || complete_cb) {
+            task->progress_callback = progress_cb;
+            task->complete_callback = complete_cb;
+            task->user_data = user_data;
+        }
+        if (!task->running && (priority > task->priority || priority == DOWNLOAD_PRIORITY_USER)) {
+            manager->download_queue = g_list_remove(manager->download_queue, task);
+            task->priority = MAX(task->priority, priority);
+            task->next_attempt = 0;
+            manager->download_queue = g_list_insert_sorted(manager->download_queue, task, download_task_compare);
+        }
+    } else {
+        task = download_task_new(manager, episode, priority);
+        task->progress_callback = progress_cb;
+        task->complete_callback = complete_cb;
+        task->user_data = user_data;
+        
+        g_hash_table_insert(manager->active_downloads, GINT_TO_POINTER(episode->id), task);
+        manager->download_queue = g_list_insert_sorted(manager->download_queue, task, download_task_compare);
+    }
+    
+    download_scheduler_pump_locked(manager);
+    gboolean waiting = !task->running;
+    g_mutex_unlock(&manager->downloads_mutex);
+    
+    if (waiting && progress_cb) {
+        progress_cb(user_data, episode->id, 0.0, "Queued");
+    }
 }
 
 void podcast_episode_download(PodcastManager *manager, PodcastEpisode *episode,
                              DownloadProgressCallback progress_cb,
                              DownloadCompleteCallback complete_cb,
                              gpointer user_data) {
-    if (!manager || !episode || !episode->enclosure_url) return;
+    podcast_episode_queue_download(manager, episode, DOWNLOAD_PRIORITY_USER,
+                                   progress_cb, complete_cb, user_data);
+}
+
+void podcast_episode_cancel_download(PodcastManager *manager, gint episode_id) {
+    if (!manager) return;
     
-    /* Check if already downloading */
     g_mutex_lock(&manager->downloads_mutex);
-    if (g_hash_table_contains(manager->active_downloads, GINT_TO_POINTER(episode->id))) {
-        g_mutex_unlock(&manager->downloads_mutex);
-        g_debug("Episode is already being downloaded");
-        return;
+    DownloadTask *task = g_hash_table_lookup(manager->active_downloads, GINT_TO_POINTER(episode_id));
+    if (task && task->running) {
+        /* The worker notices this in its progress callback and cleans up */
+        task->cancelled = TRUE;
+        task = NULL;
+    } else if (task) {
+        /* Still waiting - drop it from the queue directly */
+        manager->download_queue = g_list_remove(manager->download_queue, task);
+        g_hash_table_remove(manager->active_downloads, GINT_TO_POINTER(episode_id));
     }
+    g_mutex_unlock(&manager->downloads_mutex);
     
-    /* Create a minimal copy of the episode for the download thread.
-     * This avoids ownership issues - caller keeps ownership of original episode. */
-    PodcastEpisode *episode_copy = g_new0(PodcastEpisode, 1);
-    episode_copy->id = episode->id;
-    episode_copy->podcast_id = episode->podcast_id;
-    episode_copy->enclosure_url = g_strdup(episode->enclosure_url);
-    episode_copy->title = g_strdup(episode->title);
+    if (task) {
+        database_remove_download(manager->database, episode_id);
+        if (task->complete_callback) {
+            task->complete_callback(task->user_data, episode_id, FALSE, "Download cancelled");
+        }
+        download_task_free(task);
+    }
+}
+
+/* Queue episodes of auto-download podcasts that appeared since the last run */
+gint podcast_manager_auto_download(PodcastManager *manager) {
+    if (!manager || !manager->database) return 0;
     
-    /* Create download task */
-    DownloadTask *task = g_new0(DownloadTask, 1);
-    task->episode = episode_copy;  /* Thread owns this copy and will free it */
-    task->manager = manager;
-    task->progress_callback = progress_cb;
-    task->complete_callback = complete_cb;
-    task->user_data = user_data;
-    task->cancelled = FALSE;
+    GList *episodes = database_get_auto_download_episodes(manager->database);
+    GList *queued_ids = NULL;
     
-    /* Add to active downloads */
-    g_hash_table_insert(manager->active_downloads, GINT_TO_POINTER(episode->id), task);
-    g_mutex_unlock(&manager->downloads_mutex);
+    for (GList *l = episodes; l != NULL; l = l->next) {
+        PodcastEpisode *episode = (PodcastEpisode *)l->data;
+        podcast_episode_queue_download(manager, episode, DOWNLOAD_PRIORITY_AUTO, NULL, NULL, NULL);
+        queued_ids = g_list_prepend(queued_ids, GINT_TO_POINTER(episode->id));
+    }
     
-    /* Create thread pool if it doesn't exist */
-    if (!manager->download_pool) {
-        GError *error = NULL;
-        manager->download_pool = g_thread_pool_new(download_thread_func, NULL, 3, FALSE, &error);
-        if (error) {
-            g_warning("Failed to create download thread pool: %s", error->message);
-            g_error_free(error);
-            
-            g_mutex_lock(&manager->downloads_mutex);
-            g_hash_table_remove(manager->active_downloads, GINT_TO_POINTER(episode->id));
-            g_mutex_unlock(&manager->downloads_mutex);
-            
-            g_free(task);
-            return;
-        }
+    /* Never auto-queue the same episode twice, even after retention deletes it */
+    database_mark_episodes_auto_queued(manager->database, queued_ids);
+    
+    gint count = g_list_length(queued_ids);
+    if (count > 0) {
+        g_debug("Queued %d episode(s) for auto-download", count);
     }
     
-    /* Queue the download */
-    GError *error = NULL;
-    g_thread_pool_push(manager->download_pool, task, &error);
-    if (error) {
-        g_warning("Failed to queue download: %s", error->message);
-        g_error_free(error);
-        
-        g_mutex_lock(&manager->downloads_mutex);
-        g_hash_table_remove(manager->active_downloads, GINT_TO_POINTER(episode->id));
-        g_mutex_unlock(&manager->downloads_mutex);
+    g_list_free(queued_ids);
+    g_list_free_full(episodes, (GDestroyNotify)podcast_episode_free);
+    return count;
+}
+
+/* Delete downloads that fall outside their podcast's retention rules. All
+ * files are removed first, then the database is updated in one transaction. */
+gint podcast_manager_apply_retention(PodcastManager *manager) {
+    if (!manager || !manager->database) return 0;
+    
+    GList *expired = database_get_expired_episode_downloads(manager->database);
+    GList *cleared_ids = NULL;
+    
+    for (GList *l = expired; l != NULL; l = l->next) {
+        PodcastEpisode *episode = (PodcastEpisode *)l->data;
         
-        g_free(task);
+        if (episode->local_file_path && g_unlink(episode->local_file_path) != 0 && errno != ENOENT) {
+            g_warning("Failed to delete expired episode file: %s", episode->local_file_path);
+            continue;
+        }
+        cleared_ids = g_list_prepend(cleared_ids, GINT_TO_POINTER(episode->id));
     }
+    
+    database_clear_episode_downloads(manager->database, cleared_ids);
+    
+    gint count = g_list_length(cleared_ids);
+    if (count > 0) {
+        g_debug("Retention removed %d downloaded episode(s)", count);
+    }
+    
+    g_list_free(cleared_ids);
+    g_list_free_full(expired, (GDestroyNotify)podcast_episode_free);
+    return count;
 }
 
-void podcast_episode_cancel_download(PodcastManager *manager, gint episode_id) {
-    if (!manager) return;
+gboolean podcast_manager_set_download_settings(PodcastManager *manager, gint podcast_id,
+                                               gboolean auto_download, gint keep_episodes,
+                                               gint delete_played_after_days) {
+    if (!manager) return FALSE;
     
-    g_mutex_lock(&manager->downloads_mutex);
-    DownloadTask *task = g_hash_table_lookup(manager->active_downloads, GINT_TO_POINTER(episode_id));
-    if (task) {
-        task->cancelled = TRUE;
+    if (!database_set_podcast_download_settings(manager->database, podcast_id, auto_download,
+                                                keep_episodes, delete_played_after_days)) {
+        return FALSE;
     }
-    g_mutex_unlock(&manager->downloads_mutex);
+    
+    /* Keep the in-memory copy in sync */
+    for (GList *l = manager->podcasts; l != NULL; l = l->next) {
+        Podcast *podcast = (Podcast *)l->data;
+        if (podcast->id == podcast_id) {
+            podcast->auto_download = auto_download;
+            podcast->keep_episodes = MAX(0, keep_episodes);
+            podcast->delete_played_after_days = MAX(0, delete_played_after_days);
+            break;
+        }
+    }
+    
+    return TRUE;
 }
 
 void podcast_episode_delete(PodcastManager *manager, PodcastEpisode *episode) {
@@ -1797,6 +3312,114 @@ static GList* parse_chapters_json(const gchar *json_data) {
     return g_list_reverse(chapters);
 }
 
+static gint chapter_compare_start(gconstpointer a, gconstpointer b) {
+    gdouble ta = ((const PodcastChapter *)a)->start_time;
+    gdouble tb = ((const PodcastChapter *)b)->start_time;
+    return (ta > tb) - (ta < tb);
+}
+
+static GList* collect_toc_chapters(GList *entries, GList *chapters) {
+    for (GList *l = entries; l != NULL; l = l->next) {
+        GstTocEntry *entry = (GstTocEntry *)l->data;
+        
+        if (gst_toc_entry_get_entry_type(entry) == GST_TOC_ENTRY_TYPE_CHAPTER) {
+            gint64 start = 0, stop = 0;
+            gst_toc_entry_get_start_stop_times(entry, &start, &stop);
+            
+            PodcastChapter *chapter = g_new0(PodcastChapter, 1);
+            chapter->start_time = (gdouble)MAX(start, 0) / GST_SECOND;
+            
+            GstTagList *tags = gst_toc_entry_get_tags(entry);
+            if (tags) {
+                gst_tag_list_get_string(tags, GST_TAG_TITLE, &chapter->title);
+            }
+            chapters = g_list_prepend(chapters, chapter);
+        }
+        
+        /* Editions (ID3 CTOC) and nested chapters carry their own sub-entries */
+        chapters = collect_toc_chapters(gst_toc_entry_get_sub_entries(entry), chapters);
+    }
+    return chapters;
+}
+
+/* Read the chapter table a demuxer exposes as a GstToc: ID3v2 CHAP/CTOC
+ * frames via id3demux, MP4 chapter data via qtdemux */
+static GList* extract_embedded_chapters(const gchar *file_path) {
+    GError *error = NULL;
+    
+    if (!gst_is_initialized()) {
+        gst_init(NULL, NULL);
+    }
+    
+    GstDiscoverer *discoverer = gst_discoverer_new(10 * GST_SECOND, &error);
+    if (!discoverer) {
+        g_warning("Failed to create discoverer: %s", error ? error->message : "unknown error");
+        g_clear_error(&error);
+        return NULL;
+    }
+    
+    gchar *uri = g_filename_to_uri(file_path, NULL, NULL);
+    GstDiscovererInfo *info = uri ? gst_discoverer_discover_uri(discoverer, uri, &error) : NULL;
+    if (error) {
+        g_debug("Failed to read chapters from %s: %s", file_path, error->message);
+        g_error_free(error);
+    }
+    
+    GList *chapters = NULL;
+    const GstToc *toc = info ? gst_discoverer_info_get_toc(info) : NULL;
+    if (toc) {
+        chapters = collect_toc_chapters(gst_toc_get_entries(toc), NULL);
+        chapters = g_list_sort(chapters, chapter_compare_start);
+    }
+    
+    if (info) gst_discoverer_info_unref(info);
+    g_free(uri);
+    g_object_unref(discoverer);
+    return chapters;
+}
+
+typedef struct {
+    PodcastManager *manager;
+    gint episode_id;
+    gint64 mtime;
+    GList *chapters;
+} ChaptersSave;
+
+/* Main thread: store chapters scanned by a worker */
+static gboolean save_embedded_chapters(gpointer user_data) {
+    ChaptersSave *save = (ChaptersSave *)user_data;
+    
+    database_save_episode_chapters(save->manager->database, save->episode_id, save->chapters, save->mtime);
+    
+    g_list_free_full(save->chapters, (GDestroyNotify)podcast_chapter_free);
+    g_free(save);
+    return G_SOURCE_REMOVE;
+}
+
+/* Embedded chapters are parsed once per file version and kept in the
+ * database; a changed mtime (e.g. a re-download) triggers a rescan */
+static GList* get_embedded_chapters(PodcastManager *manager, PodcastEpisode *episode) {
+    GStatBuf st;
+    if (g_stat(episode->local_file_path, &st) != 0) return NULL;
+    
+    gint64 mtime = (gint64)st.st_mtime;
+    if (database_get_episode_chapters_scanned(manager->database, episode->id) == mtime) {
+        return database_get_episode_chapters(manager->database, episode->id);
+    }
+    
+    GList *chapters = extract_embedded_chapters(episode->local_file_path);
+    
+    /* Usually called from the chapters task, so the write is left to the main thread */
+    ChaptersSave *save = g_new0(ChaptersSave, 1);
+    save->manager = manager;
+    save->episode_id = episode->id;
+    save->mtime = mtime;
+    save->chapters = g_list_copy_deep(chapters, (GCopyFunc)podcast_chapter_copy, NULL);
+    g_main_context_invoke(NULL, save_embedded_chapters, save);
+    
+    return chapters;
+}
+
 GList* podcast_episode_get_chapters(PodcastManager *manager, gint episode_id) {
     if (!manager || !manager->database) return NULL;
     
@@ -1810,7 +3433,7 @@ GList* podcast_episode_get_chapters(PodcastManager *manager, gint episode_id) {
     
     /* Try to fetch external chapters file */
     if (episode->chapters_url) {
-        gchar *chapters_data = fetch_url(episode->chapters_url);
+        gchar *chapters_data = podcast_sidecar_fetch(episode->chapters_url, FALSE);
         if (chapters_data) {
             if (g_str_has_suffix(episode->chapters_url, ".json") || 
                 (episode->chapters_type && strstr(episode->chapters_type, "json"))) {
@@ -1826,27 +3449,50 @@ GList* podcast_episode_get_chapters(PodcastManager *manager, gint episode_id) {
     
     /* If no external chapters, try to get from media file tags */
     if (!chapters && episode->local_file_path && g_file_test(episode->local_file_path, G_FILE_TEST_EXISTS)) {
-        /* TODO: Extract embedded chapters from media file using GStreamer */
+        chapters = get_embedded_chapters(manager, episode);
     }
     
     podcast_episode_free(episode);
     return chapters;
 }
 
-PodcastChapter* podcast_chapter_at_time(GList *chapters, gdouble time) {
-    PodcastChapter *current = NULL;
+typedef struct {
+    PodcastManager *manager;
+    gint episode_id;
+} ChaptersRequest;
+
+static void chapter_list_free(gpointer data) {
+    g_list_free_full((GList *)data, (GDestroyNotify)podcast_chapter_free);
+}
+
+static void get_chapters_thread(GTask *task, gpointer source_object, gpointer task_data,
+                                GCancellable *cancellable) {
+    (void)source_object;
+    (void)cancellable;
+    ChaptersRequest *request = (ChaptersRequest *)task_data;
     
-    for (GList *l = chapters; l != NULL; l = l->next) {
-        PodcastChapter *chapter = (PodcastChapter *)l->data;
-        if (chapter->start_time <= time) {
-            current = chapter;
-        } else {
-            break;
-        }
-    }
+    GList *chapters = podcast_episode_get_chapters(request->manager, request->episode_id);
+    g_task_return_pointer(task, chapters, chapter_list_free);
+}
+
+void podcast_episode_get_chapters_async(PodcastManager *manager, gint episode_id,
+                                        GCancellable *cancellable,
+                                        GAsyncReadyCallback callback, gpointer user_data) {
+    ChaptersRequest *request = g_new0(ChaptersRequest, 1);
+    request->manager = manager;
+    request->episode_id = episode_id;
     
-    return current;
+    GTask *task = g_task_new(NULL, cancellable, callback, user_data);
+    g_task_set_task_data(task, request, g_free);
+    g_task_set_return_on_cancel(task, TRUE);
+    g_task_run_in_thread(task, get_chapters_thread);
+    g_object_unref(task);
+}
+
+GList* podcast_episode_get_chapters_finish(GAsyncResult *result, GError **error) {
+    return g_task_propagate_pointer(G_TASK(result), error);
 }
+
 /* Podcast image utility functions */
 PodcastImage* podcast_get_best_image(GList *images, const gchar *purpose) {
     if (!images) return NULL;
@@ -12,6 +12,8 @@ static void on_funding_url_clicked(GtkWidget *button, gpointer user_data);
 static void on_cancel_button_clicked(GtkButton *button, gpointer user_data);
 static void on_episode_selection_changed(GtkSelectionModel *selection, guint position, guint n_items, gpointer user_data);
 static void update_live_indicator(PodcastView *view, Podcast *podcast);
+static void update_download_settings(PodcastView *view, Podcast *podcast);
+static gboolean hide_progress_box_cb(gpointer user_data);
 
 /* GTK4 dialog helper */
 typedef struct {
@@ -228,7 +230,19 @@ static void bind_episode_date_label(GtkListItemFactory *factory, GtkListItem *li
     GtkWidget *label = gtk_list_item_get_child(list_item);
     ShriekEpisodeObject *episode = gtk_list_item_get_item(list_item);
     if (episode) {
-        gtk_label_set_text(GTK_LABEL(label), shriek_episode_object_get_date(episode));
+        /* Formatted here so only visible rows pay for it */
+        gchar date_str[64] = "";
+        gint64 published_date = shriek_episode_object_get_published_date(episode);
+        if (published_date > 0) {
+            GDateTime *dt = g_date_time_new_from_unix_local(published_date);
+            if (dt) {
+                gchar *formatted = g_date_time_format(dt, "%Y-%m-%d");
+                g_strlcpy(date_str, formatted, sizeof(date_str));
+                g_free(formatted);
+                g_date_time_unref(dt);
+            }
+        }
+        gtk_label_set_text(GTK_LABEL(label), date_str);
     }
 }
 
@@ -246,7 +260,20 @@ static void bind_episode_duration_label(GtkListItemFactory *factory, GtkListItem
     GtkWidget *label = gtk_list_item_get_child(list_item);
     ShriekEpisodeObject *episode = gtk_list_item_get_item(list_item);
     if (episode) {
-        gtk_label_set_text(GTK_LABEL(label), shriek_episode_object_get_duration(episode));
+        gchar duration_str[32] = "";
+        gint duration = shriek_episode_object_get_duration(episode);
+        if (duration > 0) {
+            gint hours = duration / 3600;
+            gint minutes = (duration % 3600) / 60;
+            gint seconds = duration % 60;
+            
+            if (hours > 0) {
+                g_snprintf(duration_str, sizeof(duration_str), "%d:%02d:%02d", hours, minutes, seconds);
+            } else {
+                g_snprintf(duration_str, sizeof(duration_str), "%d:%02d", minutes, seconds);
+            }
+        }
+        gtk_label_set_text(GTK_LABEL(label), duration_str);
     }
 }
 
@@ -306,6 +333,9 @@ static void on_podcast_selection_changed(GtkSelectionModel *selection, guint pos
         /* Update live indicator */
         update_live_indicator(view, manager_podcast);
         
+        /* Show this podcast's auto-download and retention settings */
+        update_download_settings(view, podcast);
+        
         if (podcast && podcast->funding) {
             /* Set current funding to podcast-level funding */
             if (view->current_funding) {
@@ -362,7 +392,7 @@ static void on_episode_selection_changed(GtkSelectionModel *selection, guint pos
     
     if (selected_pos != GTK_INVALID_LIST_POSITION) {
         ShriekEpisodeObject *episode_obj = g_list_model_get_item(
-            G_LIST_MODEL(view->episode_store), selected_pos);
+            G_LIST_MODEL(view->episode_selection), selected_pos);
         
         if (!episode_obj) return;
         
@@ -489,12 +519,72 @@ static void on_add_button_clicked(GtkButton *button, gpointer user_data) {
     podcast_view_add_subscription(view);
 }
 
-static void on_refresh_button_clicked(GtkButton *button, gpointer user_data) {
+/* Pending feed operation; the cancellable tells whether the view is still alive */
+typedef struct {
+    PodcastView *view;
+    GCancellable *cancellable;
+} FeedRequest;
+
+static FeedRequest* feed_request_new(PodcastView *view) {
+    FeedRequest *request = g_new0(FeedRequest, 1);
+    request->view = view;
+    request->cancellable = g_object_ref(view->feeds_cancellable);
+    return request;
+}
+
+static void feed_request_free(FeedRequest *request) {
+    g_object_unref(request->cancellable);
+    g_free(request);
+}
+
+/* Called on the main thread after each feed of a refresh */
+static void on_feed_update_progress(gpointer user_data, gint podcast_id, const gchar *title,
+                                    gint done, gint total, gboolean success) {
     PodcastView *view = (PodcastView *)user_data;
-    (void)button;
+    (void)podcast_id;
+    
+    /* The progress bar belongs to a running download */
+    if (view->current_download_id > 0) return;
     
-    /* Update all podcast feeds from the internet */
-    podcast_manager_update_all_feeds(view->podcast_manager);
+    gchar *text = g_strdup_printf(success ? "Updated %s" : "Failed to update %s",
+                                  title ? title : "podcast");
+    gtk_label_set_text(GTK_LABEL(view->progress_label), text);
+    g_free(text);
+    
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(view->progress_bar), total > 0 ? (gdouble)done / total : 1.0);
+    gchar *progress_text = g_strdup_printf("%d/%d", done, total);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(view->progress_bar), progress_text);
+    g_free(progress_text);
+}
+
+static void on_feed_update_done(GObject *source, GAsyncResult *result, gpointer user_data) {
+    FeedRequest *request = (FeedRequest *)user_data;
+    GError *error = NULL;
+    (void)source;
+    
+    podcast_manager_update_feeds_finish(result, &error);
+    
+    /* The view was freed while the update ran */
+    if (g_cancellable_is_cancelled(request->cancellable)) {
+        g_clear_error(&error);
+        feed_request_free(request);
+        return;
+    }
+    
+    PodcastView *view = request->view;
+    feed_request_free(request);
+    
+    gtk_widget_set_sensitive(view->refresh_button, TRUE);
+    
+    if (view->current_download_id <= 0) {
+        if (error) {
+            gtk_label_set_text(GTK_LABEL(view->progress_label), error->message);
+        } else {
+            gtk_label_set_text(GTK_LABEL(view->progress_label), "Feeds updated");
+        }
+        g_timeout_add_seconds(3, hide_progress_box_cb, view->progress_box);
+    }
+    g_clear_error(&error);
     
     /* Refresh the UI */
     podcast_view_refresh_podcasts(view);
@@ -512,6 +602,90 @@ static void on_refresh_button_clicked(GtkButton *button, gpointer user_data) {
     }
 }
 
+static void on_refresh_button_clicked(GtkButton *button, gpointer user_data) {
+    PodcastView *view = (PodcastView *)user_data;
+    (void)button;
+    
+    if (podcast_manager_is_updating(view->podcast_manager)) return;
+    
+    gtk_widget_set_sensitive(view->refresh_button, FALSE);
+    if (view->current_download_id <= 0) {
+        gtk_widget_set_visible(view->progress_box, TRUE);
+        gtk_label_set_text(GTK_LABEL(view->progress_label), "Updating feeds...");
+        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(view->progress_bar), 0.0);
+        gtk_progress_bar_set_text(GTK_PROGRESS_BAR(view->progress_bar), NULL);
+    }
+    
+    /* Update all podcast feeds from the internet on the feed worker */
+    podcast_manager_update_feeds_async(view->podcast_manager, NULL, view->feeds_cancellable,
+                                       on_feed_update_progress, view,
+                                       on_feed_update_done, feed_request_new(view));
+}
+
+/* Save the selected podcast's auto-download and retention settings */
+static void on_download_settings_changed(GtkWidget *widget, gpointer user_data) {
+    PodcastView *view = (PodcastView *)user_data;
+    (void)widget;
+    
+    if (view->loading_settings || view->selected_podcast_id <= 0) return;
+    
+    gboolean auto_download = gtk_check_button_get_active(GTK_CHECK_BUTTON(view->auto_download_check));
+    gint keep = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(view->keep_episodes_spin));
+    gint days = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(view->delete_played_spin));
+    
+    if (!podcast_manager_set_download_settings(view->podcast_manager, view->selected_podcast_id,
+                                               auto_download, keep, days)) {
+        g_warning("Failed to save download settings for podcast %d", view->selected_podcast_id);
+    }
+}
+
+static void update_download_settings(PodcastView *view, Podcast *podcast) {
+    view->loading_settings = TRUE;
+    gtk_check_button_set_active(GTK_CHECK_BUTTON(view->auto_download_check), podcast && podcast->auto_download);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(view->keep_episodes_spin), podcast ? podcast->keep_episodes : 0);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(view->delete_played_spin), podcast ? podcast->delete_played_after_days : 0);
+    gtk_widget_set_sensitive(view->settings_button, podcast != NULL);
+    view->loading_settings = FALSE;
+}
+
+static GtkWidget* create_download_settings_popover(PodcastView *view) {
+    GtkWidget *popover = gtk_popover_new();
+    GtkWidget *box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 8);
+    gtk_widget_set_margin_start(box, 10);
+    gtk_widget_set_margin_end(box, 10);
+    gtk_widget_set_margin_top(box, 10);
+    gtk_widget_set_margin_bottom(box, 10);
+    
+    view->auto_download_check = gtk_check_button_new_with_label("Automatically download new episodes");
+    g_signal_connect(view->auto_download_check, "toggled", G_CALLBACK(on_download_settings_changed), view);
+    gtk_box_append(GTK_BOX(box), view->auto_download_check);
+    
+    GtkWidget *keep_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 6);
+    gtk_box_append(GTK_BOX(keep_row), gtk_label_new("Keep the latest"));
+    view->keep_episodes_spin = gtk_spin_button_new_with_range(0, 999, 1);
+    g_signal_connect(view->keep_episodes_spin, "value-changed", G_CALLBACK(on_download_settings_changed), view);
+    gtk_box_append(GTK_BOX(keep_row), view->keep_episodes_spin);
+    gtk_box_append(GTK_BOX(keep_row), gtk_label_new("downloads"));
+    gtk_box_append(GTK_BOX(box), keep_row);
+    
+    GtkWidget *played_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 6);
+    gtk_box_append(GTK_BOX(played_row), gtk_label_new("Delete played episodes after"));
+    view->delete_played_spin = gtk_spin_button_new_with_range(0, 365, 1);
+    g_signal_connect(view->delete_played_spin, "value-changed", G_CALLBACK(on_download_settings_changed), view);
+    gtk_box_append(GTK_BOX(played_row), view->delete_played_spin);
+    gtk_box_append(GTK_BOX(played_row), gtk_label_new("day(s)"));
+    gtk_box_append(GTK_BOX(box), played_row);
+    
+    GtkWidget *help_label = gtk_label_new("Set to 0 to keep everything. Old downloads are removed after each feed refresh.");
+    gtk_label_set_wrap(GTK_LABEL(help_label), TRUE);
+    gtk_widget_set_halign(help_label, GTK_ALIGN_START);
+    gtk_widget_add_css_class(help_label, "dim-label");
+    gtk_box_append(GTK_BOX(box), help_label);
+    
+    gtk_popover_set_child(GTK_POPOVER(popover), box);
+    return popover;
+}
+
 static void on_download_button_clicked(GtkButton *button, gpointer user_data) {
     PodcastView *view = (PodcastView *)user_data;
     (void)button;
@@ -519,7 +693,7 @@ static void on_download_button_clicked(GtkButton *button, gpointer user_data) {
     guint selected_pos = gtk_single_selection_get_selected(view->episode_selection);
     if (selected_pos != GTK_INVALID_LIST_POSITION) {
         ShriekEpisodeObject *episode_obj = g_list_model_get_item(
-            G_LIST_MODEL(view->episode_store), selected_pos);
+            G_LIST_MODEL(view->episode_selection), selected_pos);
         if (episode_obj) {
             gint episode_id = shriek_episode_object_get_id(episode_obj);
             g_object_unref(episode_obj);
@@ -544,12 +718,18 @@ static void on_episode_activated(GtkColumnView *column_view, guint position, gpo
     PodcastView *view = (PodcastView *)user_data;
     
     ShriekEpisodeObject *episode_obj = g_list_model_get_item(
-        G_LIST_MODEL(view->episode_store), position);
+        G_LIST_MODEL(view->episode_selection), position);
     
     if (episode_obj) {
         gint episode_id = shriek_episode_object_get_id(episode_obj);
+        gdouble start_time = shriek_episode_object_get_start_time(episode_obj);
         g_object_unref(episode_obj);
         podcast_view_play_episode(view, episode_id);
+        
+        /* Transcript matches start where the words are spoken */
+        if (start_time > 0 && view->seek_callback) {
+            view->seek_callback(view->seek_callback_data, start_time);
+        }
     }
 }
 
@@ -1000,6 +1180,7 @@ PodcastView* podcast_view_new(PodcastManager *manager, Database *database) {
     view->database = database;
     view->selected_podcast_id = -1;
     view->current_download_id = -1;
+    view->feeds_cancellable = g_cancellable_new();
     
     /* Initialize download progress tracking */
     view->download_progress = g_hash_table_new(g_direct_hash, g_direct_equal);
@@ -1011,6 +1192,7 @@ PodcastView* podcast_view_new(PodcastManager *manager, Database *database) {
     view->funding_popover = NULL;
     view->value_popover = NULL;
     view->current_chapters = NULL;
+    view->playing_uri = NULL;
     view->current_transcript_url = NULL;
     view->current_transcript_type = NULL;
     view->current_funding = NULL;
@@ -1047,6 +1229,13 @@ PodcastView* podcast_view_new(PodcastManager *manager, Database *database) {
     gtk_box_append(GTK_BOX(toolbar), view->refresh_button);
     g_signal_connect(view->refresh_button, "clicked", G_CALLBACK(on_refresh_button_clicked), view);
     
+    view->settings_button = gtk_menu_button_new();
+    gtk_menu_button_set_icon_name(GTK_MENU_BUTTON(view->settings_button), "emblem-system-symbolic");
+    gtk_widget_set_tooltip_text(view->settings_button, "Download settings for this podcast");
+    gtk_menu_button_set_popover(GTK_MENU_BUTTON(view->settings_button), create_download_settings_popover(view));
+    gtk_widget_set_sensitive(view->settings_button, FALSE);  /* Disabled until a podcast is selected */
+    gtk_box_append(GTK_BOX(toolbar), view->settings_button);
+    
     /* Separator */
     GtkWidget *separator1 = gtk_separator_new(GTK_ORIENTATION_VERTICAL);
     gtk_widget_set_margin_start(separator1, 4);
@@ -1187,9 +1376,10 @@ PodcastView* podcast_view_new(PodcastManager *manager, Database *database) {
     gtk_paned_set_shrink_start_child(GTK_PANED(view->paned), TRUE);
     gtk_paned_set_resize_start_child(GTK_PANED(view->paned), FALSE);
     
-    /* Episode list - GTK4 GListStore/GtkColumnView */
+    /* Episode list - paged model for the selected podcast, GListStore for search results */
+    view->episode_model = shriek_episode_list_model_new(view->database);
     view->episode_store = g_list_store_new(SHRIEK_TYPE_EPISODE_OBJECT);
-    view->episode_selection = gtk_single_selection_new(G_LIST_MODEL(g_object_ref(view->episode_store)));
+    view->episode_selection = gtk_single_selection_new(G_LIST_MODEL(g_object_ref(view->episode_model)));
     gtk_single_selection_set_autoselect(view->episode_selection, FALSE);
     
     /* Create episode column view */
@@ -1258,10 +1448,22 @@ void podcast_view_free(PodcastView *view) {
     /* Cancel any active download */
     view->current_download_id = -1;
     
+    if (view->chapters_cancellable) {
+        g_cancellable_cancel(view->chapters_cancellable);
+        g_object_unref(view->chapters_cancellable);
+    }
+    if (view->search_cancellable) {
+        g_cancellable_cancel(view->search_cancellable);
+        g_object_unref(view->search_cancellable);
+    }
+    g_cancellable_cancel(view->feeds_cancellable);
+    g_object_unref(view->feeds_cancellable);
+    
     /* Clean up episode-specific data */
     if (view->current_chapters) {
         g_list_free_full(view->current_chapters, (GDestroyNotify)podcast_chapter_free);
     }
+    g_free(view->playing_uri);
     g_free(view->current_transcript_url);
     g_free(view->current_transcript_type);
     if (view->current_funding) {
@@ -1298,6 +1500,39 @@ GtkWidget* podcast_view_get_widget(PodcastView *view) {
     return view ? view->container : NULL;
 }
 
+static void on_subscribe_done(GObject *source, GAsyncResult *result, gpointer user_data) {
+    FeedRequest *request = (FeedRequest *)user_data;
+    GError *error = NULL;
+    (void)source;
+    
+    gint podcast_id = podcast_manager_subscribe_finish(result, &error);
+    
+    /* The view was freed while the subscription ran */
+    if (g_cancellable_is_cancelled(request->cancellable)) {
+        g_clear_error(&error);
+        feed_request_free(request);
+        return;
+    }
+    
+    PodcastView *view = request->view;
+    feed_request_free(request);
+    
+    if (podcast_id >= 0) {
+        /* Refresh podcast list */
+        podcast_view_refresh_podcasts(view);
+        
+        GtkAlertDialog *msg = gtk_alert_dialog_new("Successfully subscribed to podcast!");
+        gtk_alert_dialog_show(msg, NULL);
+        g_object_unref(msg);
+    } else {
+        g_warning("Subscription failed: %s", error ? error->message : "unknown error");
+        GtkAlertDialog *msg = gtk_alert_dialog_new("Failed to subscribe to podcast. Please check the feed URL.");
+        gtk_alert_dialog_show(msg, NULL);
+        g_object_unref(msg);
+    }
+    g_clear_error(&error);
+}
+
 void podcast_view_add_subscription(PodcastView *view) {
     if (!view) return;
     
@@ -1349,27 +1584,9 @@ void podcast_view_add_subscription(PodcastView *view) {
         const gchar *feed_url = gtk_editable_get_text(GTK_EDITABLE(entry));
         
         if (feed_url && strlen(feed_url) > 0) {
-            /* Show progress dialog using GtkAlertDialog in GTK4 style */
-            GtkAlertDialog *progress_alert = gtk_alert_dialog_new("Subscribing to podcast...");
-            /* Note: In GTK4, we can't easily show a progress dialog without response buttons.
-               For now, we'll just do the subscription synchronously */
-            
-            /* Subscribe to podcast */
-            gboolean success = podcast_manager_subscribe(view->podcast_manager, feed_url);
-            
-            if (success) {
-                /* Refresh podcast list */
-                podcast_view_refresh_podcasts(view);
-                
-                GtkAlertDialog *msg = gtk_alert_dialog_new("Successfully subscribed to podcast!");
-                gtk_alert_dialog_show(msg, NULL);
-                g_object_unref(msg);
-            } else {
-                GtkAlertDialog *msg = gtk_alert_dialog_new("Failed to subscribe to podcast. Please check the feed URL.");
-                gtk_alert_dialog_show(msg, NULL);
-                g_object_unref(msg);
-            }
-            g_object_unref(progress_alert);
+            /* Subscribe on the feed worker; the result is reported when it is done */
+            podcast_manager_subscribe_async(view->podcast_manager, feed_url, view->feeds_cancellable,
+                                            on_subscribe_done, feed_request_new(view));
         }
     }
     
@@ -1399,136 +1616,127 @@ void podcast_view_refresh_podcasts(PodcastView *view) {
 void podcast_view_refresh_episodes(PodcastView *view, gint podcast_id) {
     if (!view) return;
     
-    g_list_store_remove_all(view->episode_store);
+    /* Search results live in episode_store; the podcast's own list is paged */
+    if (gtk_single_selection_get_model(view->episode_selection) != G_LIST_MODEL(view->episode_model)) {
+        gtk_single_selection_set_model(view->episode_selection, G_LIST_MODEL(view->episode_model));
+    }
+    shriek_episode_list_model_set_podcast(view->episode_model, podcast_id);
+}
+
+static void on_episode_chapters_loaded(GObject *source, GAsyncResult *result, gpointer user_data) {
+    PodcastView *view = (PodcastView *)user_data;
+    GError *error = NULL;
+    (void)source;
     
-    GList *episodes = podcast_manager_get_episodes(view->podcast_manager, podcast_id);
+    GList *chapters = podcast_episode_get_chapters_finish(result, &error);
+    if (error) {
+        /* Cancelled when another episode starts or the view is freed */
+        g_error_free(error);
+        return;
+    }
     
-    for (GList *l = episodes; l != NULL; l = l->next) {
-        PodcastEpisode *episode = (PodcastEpisode *)l->data;
-        
-        /* Format date */
-        gchar date_str[64] = "";
-        if (episode->published_date > 0) {
-            GDateTime *dt = g_date_time_new_from_unix_local(episode->published_date);
-            if (dt) {
-                gchar *formatted = g_date_time_format(dt, "%Y-%m-%d");
-                g_strlcpy(date_str, formatted, sizeof(date_str));
-                g_free(formatted);
-                g_date_time_unref(dt);
-            }
-        }
-        
-        /* Format duration */
-        gchar duration_str[32] = "";
-        if (episode->duration > 0) {
-            gint hours = episode->duration / 3600;
-            gint minutes = (episode->duration % 3600) / 60;
-            gint seconds = episode->duration % 60;
-            
-            if (hours > 0) {
-                g_snprintf(duration_str, sizeof(duration_str), "%d:%02d:%02d", hours, minutes, seconds);
-            } else {
-                g_snprintf(duration_str, sizeof(duration_str), "%d:%02d", minutes, seconds);
-            }
-        }
-        
-        ShriekEpisodeObject *obj = shriek_episode_object_new(
-            episode->id,
-            episode->title ? episode->title : "Unknown",
-            date_str,
-            duration_str,
-            episode->downloaded
-        );
-        g_list_store_append(view->episode_store, obj);
-        g_object_unref(obj);
+    if (view->current_chapters) {
+        g_list_free_full(view->current_chapters, (GDestroyNotify)podcast_chapter_free);
+    }
+    view->current_chapters = chapters;
+    gtk_widget_set_sensitive(view->chapters_button, chapters != NULL);
+    if (chapters && view->chapter_view) {
+        chapter_view_set_chapters(view->chapter_view, chapters);
     }
 }
 
 void podcast_view_play_episode(PodcastView *view, gint episode_id) {
     if (!view) return;
     
-    /* Get episode details from database */
-    GList *episodes = database_get_podcast_episodes(view->database, view->selected_podcast_id);
+    /* Only this episode is needed, whichever podcast it belongs to */
+    PodcastEpisode *episode = database_get_episode_by_id(view->database, episode_id);
+    if (!episode) return;
     
-    for (GList *l = episodes; l != NULL; l = l->next) {
-        PodcastEpisode *episode = (PodcastEpisode *)l->data;
-        if (episode->id == episode_id) {
-            /* Play from local file if downloaded, otherwise stream */
-            const gchar *uri = episode->downloaded && episode->local_file_path ? 
-                              episode->local_file_path : episode->enclosure_url;
-            
-            /* Load chapters if available */
-            GList *chapters = NULL;
-            if (episode->chapters_url || episode->enclosure_url) {
-                chapters = podcast_episode_get_chapters(view->podcast_manager, episode_id);
-            }
-            
-            /* Load funding from database */
-            GList *funding = database_get_episode_funding(view->database, episode_id);
-            
-            /* Call playback callback if set */
-            if (view->play_callback) {
-                view->play_callback(view->play_callback_data, uri, episode->title, chapters, 
-                                  episode->transcript_url, episode->transcript_type, funding);
-            }
-            
-            /* Update episode features in the podcast view toolbar */
-            podcast_view_update_episode_features(view, chapters, episode->transcript_url, 
-                                               episode->transcript_type, funding);
-            
-            /* Free chapters and funding (callback should have copied if needed) */
-            if (chapters) {
-                g_list_free_full(chapters, (GDestroyNotify)podcast_chapter_free);
-            }
-            if (funding) {
-                g_list_free_full(funding, (GDestroyNotify)podcast_funding_free);
-            }
-            
-            break;
-        }
+    /* Play from local file if downloaded, otherwise stream */
+    const gchar *uri = episode->downloaded && episode->local_file_path ? 
+                      episode->local_file_path : episode->enclosure_url;
+    
+    /* Drop any chapter load still running for the previous episode */
+    if (view->chapters_cancellable) {
+        g_cancellable_cancel(view->chapters_cancellable);
+        g_object_unref(view->chapters_cancellable);
+        view->chapters_cancellable = NULL;
+    }
+    
+    /* Load funding from database */
+    GList *funding = database_get_episode_funding(view->database, episode_id);
+    
+    g_free(view->playing_uri);
+    view->playing_uri = g_strdup(uri);
+    
+    /* Call playback callback if set */
+    if (view->play_callback) {
+        view->play_callback(view->play_callback_data, uri, episode->title, NULL, 
+                          episode->transcript_url, episode->transcript_type, funding);
+    }
+    
+    /* Update episode features in the podcast view toolbar */
+    podcast_view_update_episode_features(view, NULL, episode->transcript_url, 
+                                       episode->transcript_type, funding);
+    
+    /* Chapters are loaded in the background (usually from the sidecar
+     * cache) and filled in once they arrive */
+    if (episode->chapters_url || episode->local_file_path) {
+        view->chapters_cancellable = g_cancellable_new();
+        podcast_episode_get_chapters_async(view->podcast_manager, episode_id,
+                                           view->chapters_cancellable,
+                                           on_episode_chapters_loaded, view);
     }
     
-    g_list_free_full(episodes, (GDestroyNotify)podcast_episode_free);
+    /* Free funding (callback should have copied if needed) */
+    if (funding) {
+        g_list_free_full(funding, (GDestroyNotify)podcast_funding_free);
+    }
+    
+    podcast_episode_free(episode);
+}
+
+/* Follow playback in the chapter list and transcript. Called on every
+ * position tick, so both lookups reuse the previous index. */
+void podcast_view_update_position(PodcastView *view, const gchar *uri, gdouble time) {
+    if (!view || !view->playing_uri || g_strcmp0(uri, view->playing_uri) != 0) return;
+    
+    if (view->chapter_view) {
+        chapter_view_highlight_current(view->chapter_view, time);
+    }
+    
+    if (view->transcript_popover) {
+        TranscriptView *transcript_view = (TranscriptView *)g_object_get_data(G_OBJECT(view->transcript_popover), "transcript_view");
+        transcript_view_highlight_time(transcript_view, time);
+    }
 }
 
 void podcast_view_download_episode(PodcastView *view, gint episode_id) {
     if (!view) return;
     
-    /* Get episode details */
-    GList *episodes = database_get_podcast_episodes(view->database, view->selected_podcast_id);
+    /* Only this episode is needed, whichever podcast it belongs to */
+    PodcastEpisode *episode = database_get_episode_by_id(view->database, episode_id);
+    if (!episode) return;
     
-    for (GList *l = episodes; l != NULL; l = l->next) {
-        PodcastEpisode *episode = (PodcastEpisode *)l->data;
-        if (episode->id == episode_id) {
-            if (!episode->downloaded) {
-                /* Store current download ID */
-                view->current_download_id = episode_id;
-                
-                /* Show progress UI */
-                gtk_widget_set_visible(view->progress_box, TRUE);
-                gtk_label_set_text(GTK_LABEL(view->progress_label), episode->title);
-                gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(view->progress_bar), 0.0);
-                gtk_widget_set_sensitive(view->download_button, FALSE);
-                gtk_widget_set_sensitive(view->cancel_button, TRUE);
-                
-                /* Make a copy of the episode for the async download */
-                PodcastEpisode *episode_copy = g_new0(PodcastEpisode, 1);
-                episode_copy->id = episode->id;
-                episode_copy->podcast_id = episode->podcast_id;
-                episode_copy->enclosure_url = g_strdup(episode->enclosure_url);
-                episode_copy->title = g_strdup(episode->title);
-                
-                /* Start download with callbacks */
-                podcast_episode_download(view->podcast_manager, episode_copy, 
-                                       on_download_progress, on_download_complete, view);
-            } else {
-                /* Episode already downloaded */
-            }
-            break;
-        }
+    if (!episode->downloaded) {
+        /* Store current download ID */
+        view->current_download_id = episode_id;
+        
+        /* Show progress UI */
+        gtk_widget_set_visible(view->progress_box, TRUE);
+        gtk_label_set_text(GTK_LABEL(view->progress_label), episode->title);
+        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(view->progress_bar), 0.0);
+        gtk_widget_set_sensitive(view->download_button, FALSE);
+        gtk_widget_set_sensitive(view->cancel_button, TRUE);
+        
+        /* Start download with callbacks; the manager copies what it needs */
+        podcast_episode_download(view->podcast_manager, episode, 
+                               on_download_progress, on_download_complete, view);
+    } else {
+        /* Episode already downloaded */
     }
     
-    g_list_free_full(episodes, (GDestroyNotify)podcast_episode_free);
+    podcast_episode_free(episode);
 }
 
 /* Download progress callback - runs on main thread via g_idle_add */
@@ -1673,113 +1881,114 @@ void podcast_view_update_episode_features(PodcastView *view, GList *chapters, co
     }
 }
 
-void podcast_view_filter(PodcastView *view, const gchar *search_text) {
-    if (!view) return;
+#define FILTER_MAX_EPISODES 500
+#define FILTER_MAX_TRANSCRIPT_HITS 100
+
+/* The worker only sees the database, so it never touches a view that was
+ * freed while the query ran */
+typedef struct {
+    Database *database;
+    gchar *search_text;
+} FilterSearch;
+
+static void filter_search_free(gpointer data) {
+    FilterSearch *search = (FilterSearch *)data;
+    g_free(search->search_text);
+    g_free(search);
+}
+
+typedef struct {
+    PodcastSearchResults *results;
+    GList *transcript_hits;  /* TranscriptHit */
+} FilterResults;
+
+static void filter_results_free(FilterResults *filter) {
+    database_search_results_free(filter->results);
+    g_list_free_full(filter->transcript_hits, (GDestroyNotify)transcript_hit_free);
+    g_free(filter);
+}
+
+static void filter_search_thread(GTask *task, gpointer source_object, gpointer task_data,
+                                 GCancellable *cancellable) {
+    FilterSearch *search = (FilterSearch *)task_data;
+    (void)source_object;
+    (void)cancellable;
+    
+    FilterResults *filter = g_new0(FilterResults, 1);
+    filter->results = database_search_podcasts(search->database, search->search_text,
+                                               FILTER_MAX_EPISODES);
+    filter->transcript_hits = database_search_transcripts(search->database, search->search_text,
+                                                          FILTER_MAX_TRANSCRIPT_HITS);
+    g_task_return_pointer(task, filter, (GDestroyNotify)filter_results_free);
+}
+
+static void on_filter_search_done(GObject *source, GAsyncResult *result, gpointer user_data) {
+    PodcastView *view = (PodcastView *)user_data;
+    GError *error = NULL;
+    (void)source;
     
-    /* If no search text, show all podcasts and episodes */
-    if (!search_text || strlen(search_text) == 0) {
-        podcast_view_refresh_podcasts(view);
-        if (view->selected_podcast_id > 0) {
-            podcast_view_refresh_episodes(view, view->selected_podcast_id);
-        }
+    FilterResults *filter = g_task_propagate_pointer(G_TASK(result), &error);
+    if (error) {
+        /* Superseded by a newer search, or the view is gone */
+        g_error_free(error);
         return;
     }
     
-    GList *all_podcasts = database_get_podcasts(view->database);
     g_list_store_remove_all(view->podcast_store);
+    g_list_store_remove_all(view->episode_store);
+    if (gtk_single_selection_get_model(view->episode_selection) != G_LIST_MODEL(view->episode_store)) {
+        gtk_single_selection_set_model(view->episode_selection, G_LIST_MODEL(view->episode_store));
+    }
     
-    gchar *search_lower = g_utf8_strdown(search_text, -1);
-    
-    /* Track which podcasts have matching episodes */
-    GHashTable *podcasts_with_matches = g_hash_table_new(g_direct_hash, g_direct_equal);
+    PodcastSearchResults *results = filter->results;
+    if (!results && !filter->transcript_hits) {
+        filter_results_free(filter);
+        return;
+    }
     
-    /* First, add podcasts that match by title or author */
-    for (GList *l = all_podcasts; l != NULL; l = l->next) {
-        Podcast *podcast = (Podcast *)l->data;
-        gchar *title_lower = g_utf8_strdown(podcast->title ? podcast->title : "", -1);
-        gchar *author_lower = g_utf8_strdown(podcast->author ? podcast->author : "", -1);
-        
-        gboolean match = (strstr(title_lower, search_lower) != NULL) || 
-                        (strstr(author_lower, search_lower) != NULL);
-        
-        g_free(title_lower);
-        g_free(author_lower);
-        
-        if (match) {
-            g_hash_table_add(podcasts_with_matches, GINT_TO_POINTER(podcast->id));
-        }
+    /* Matching episodes, best match first */
+    for (GList *l = results ? results->episodes : NULL; l != NULL; l = l->next) {
+        PodcastEpisode *episode = (PodcastEpisode *)l->data;
+        ShriekEpisodeObject *obj = shriek_episode_object_new(
+            episode->id,
+            episode->title ? episode->title : "Unknown",
+            episode->published_date,
+            episode->duration,
+            episode->downloaded
+        );
+        g_list_store_append(view->episode_store, obj);
+        g_object_unref(obj);
     }
     
-    /* Search through episodes from ALL podcasts and track which podcasts have matches */
-    g_list_store_remove_all(view->episode_store);
+    /* Then places where the words are spoken; playing one seeks there */
+    for (GList *l = filter->transcript_hits; l != NULL; l = l->next) {
+        TranscriptHit *hit = (TranscriptHit *)l->data;
+        gint seconds = (gint)hit->start_time;
+        gchar *title = g_strdup_printf("[%d:%02d:%02d] “%s” — %s",
+                                       seconds / 3600, (seconds % 3600) / 60, seconds % 60,
+                                       hit->snippet ? hit->snippet : "",
+                                       hit->episode_title ? hit->episode_title : "Unknown");
+        ShriekEpisodeObject *obj = shriek_episode_object_new(hit->episode_id, title, 0, 0, hit->downloaded);
+        shriek_episode_object_set_start_time(obj, hit->start_time);
+        g_list_store_append(view->episode_store, obj);
+        g_object_unref(obj);
+        g_free(title);
+    }
     
-    for (GList *p = all_podcasts; p != NULL; p = p->next) {
-        Podcast *podcast = (Podcast *)p->data;
-        GList *all_episodes = database_get_podcast_episodes(view->database, podcast->id);
-        gboolean podcast_has_episode_match = FALSE;
-        
-        for (GList *l = all_episodes; l != NULL; l = l->next) {
-            PodcastEpisode *episode = (PodcastEpisode *)l->data;
-            gchar *title_lower = g_utf8_strdown(episode->title ? episode->title : "", -1);
-            gchar *desc_lower = g_utf8_strdown(episode->description ? episode->description : "", -1);
-            
-            gboolean match = (strstr(title_lower, search_lower) != NULL) || 
-                            (strstr(desc_lower, search_lower) != NULL);
-            
-            g_free(title_lower);
-            g_free(desc_lower);
-            
-            if (match) {
-                podcast_has_episode_match = TRUE;
-                
-                gchar date_str[64] = "Unknown";
-                if (episode->published_date > 0) {
-                    GDateTime *dt = g_date_time_new_from_unix_local(episode->published_date);
-                    if (dt) {
-                        gchar *fmt = g_date_time_format(dt, "%Y-%m-%d");
-                        g_snprintf(date_str, sizeof(date_str), "%s", fmt);
-                        g_free(fmt);
-                        g_date_time_unref(dt);
-                    }
-                }
-                
-                gchar duration_str[32] = "";
-                if (episode->duration > 0) {
-                    gint hours = episode->duration / 3600;
-                    gint minutes = (episode->duration % 3600) / 60;
-                    gint seconds = episode->duration % 60;
-                    if (hours > 0) {
-                        g_snprintf(duration_str, sizeof(duration_str), "%02d:%02d:%02d", hours, minutes, seconds);
-                    } else {
-                        g_snprintf(duration_str, sizeof(duration_str), "%02d:%02d", minutes, seconds);
-                    }
-                }
-                
-                ShriekEpisodeObject *obj = shriek_episode_object_new(
-                    episode->id,
-                    episode->title ? episode->title : "Unknown",
-                    date_str,
-                    duration_str,
-                    episode->local_file_path != NULL
-                );
-                g_list_store_append(view->episode_store, obj);
-                g_object_unref(obj);
-            }
-        }
-        
-        /* Add podcast to list if it has matching episodes */
-        if (podcast_has_episode_match) {
-            g_hash_table_add(podcasts_with_matches, GINT_TO_POINTER(podcast->id));
-        }
-        
-        g_list_free_full(all_episodes, (GDestroyNotify)podcast_episode_free);
+    /* Podcasts with any match, in the usual title order, from the manager's
+     * in-memory list rather than another database round trip */
+    GHashTable *matched = g_hash_table_new(g_direct_hash, g_direct_equal);
+    for (GList *l = results ? results->podcast_ids : NULL; l != NULL; l = l->next) {
+        g_hash_table_add(matched, l->data);
+    }
+    for (GList *l = filter->transcript_hits; l != NULL; l = l->next) {
+        g_hash_table_add(matched, GINT_TO_POINTER(((TranscriptHit *)l->data)->podcast_id));
     }
     
-    /* Now populate the podcast list with all podcasts that have matches */
-    for (GList *l = all_podcasts; l != NULL; l = l->next) {
+    for (GList *l = podcast_manager_get_podcasts(view->podcast_manager); l != NULL; l = l->next) {
         Podcast *podcast = (Podcast *)l->data;
         
-        if (g_hash_table_contains(podcasts_with_matches, GINT_TO_POINTER(podcast->id))) {
+        if (g_hash_table_contains(matched, GINT_TO_POINTER(podcast->id))) {
             ShriekPodcastObject *obj = shriek_podcast_object_new(
                 podcast->id,
                 podcast->title ? podcast->title : "Unknown",
@@ -1790,9 +1999,39 @@ void podcast_view_filter(PodcastView *view, const gchar *search_text) {
         }
     }
     
-    g_free(search_lower);
-    g_hash_table_destroy(podcasts_with_matches);
-    g_list_free_full(all_podcasts, (GDestroyNotify)podcast_free);
+    g_hash_table_destroy(matched);
+    filter_results_free(filter);
+}
+
+void podcast_view_filter(PodcastView *view, const gchar *search_text) {
+    if (!view) return;
+    
+    /* Only the latest keystroke's search may update the lists */
+    if (view->search_cancellable) {
+        g_cancellable_cancel(view->search_cancellable);
+        g_object_unref(view->search_cancellable);
+        view->search_cancellable = NULL;
+    }
+    
+    /* If no search text, show all podcasts and episodes */
+    if (!search_text || strlen(search_text) == 0) {
+        podcast_view_refresh_podcasts(view);
+        if (view->selected_podcast_id > 0) {
+            podcast_view_refresh_episodes(view, view->selected_podcast_id);
+        }
+        return;
+    }
+    
+    /* The ranked full-text query runs on a worker thread */
+    view->search_cancellable = g_cancellable_new();
+    GTask *task = g_task_new(NULL, view->search_cancellable, on_filter_search_done, view);
+    FilterSearch *search = g_new0(FilterSearch, 1);
+    search->database = view->database;
+    search->search_text = g_strdup(search_text);
+    g_task_set_task_data(task, search, filter_search_free);
+    g_task_set_return_on_cancel(task, TRUE);
+    g_task_run_in_thread(task, filter_search_thread);
+    g_object_unref(task);
 }
 
 Podcast* podcast_view_get_selected_podcast(PodcastView *view) {
@@ -231,6 +231,7 @@ void radio_station_free(RadioStation *station) {
 
 gint radio_station_save(RadioStation *station, Database *db) {
     if (!db || !db->db || !station) return -1;
+    DATABASE_LOCK_SCOPE(db);
 
     const char *sql = "INSERT INTO radio_stations (name, url, genre, description, bitrate, homepage, date_added) "
                       "VALUES (?, ?, ?, ?, ?, ?, ?);";
@@ -256,6 +257,7 @@ gint radio_station_save(RadioStation *station, Database *db) {
 
 GList* radio_station_get_all(Database *db) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
 
     const char *sql = "SELECT id, name, url, genre, description, bitrate, homepage, date_added, play_count "
                       "FROM radio_stations ORDER BY name";
@@ -284,6 +286,7 @@ GList* radio_station_get_all(Database *db) {
 
 RadioStation* radio_station_load(gint station_id, Database *db) {
     if (!db || !db->db) return NULL;
+    DATABASE_LOCK_SCOPE(db);
 
     const char *sql = "SELECT id, name, url, genre, description, bitrate, homepage, date_added, play_count "
                       "FROM radio_stations WHERE id = ?";
@@ -312,6 +315,7 @@ RadioStation* radio_station_load(gint station_id, Database *db) {
 
 GList* radio_station_search(Database *db, const gchar *search_term) {
     if (!db || !db->db || !search_term) return NULL;
+    DATABASE_LOCK_SCOPE(db);
 
     const char *sql = "SELECT id, name, url, genre, description, bitrate, homepage, date_added, play_count "
                       "FROM radio_stations WHERE name LIKE ? OR genre LIKE ? ORDER BY name";
@@ -345,6 +349,7 @@ GList* radio_station_search(Database *db, const gchar *search_term) {
 
 gboolean radio_station_delete(gint station_id, Database *db) {
     if (!db || !db->db) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
 
     const char *sql = "DELETE FROM radio_stations WHERE id=?;";
     sqlite3_stmt *stmt;
@@ -359,6 +364,7 @@ gboolean radio_station_delete(gint station_id, Database *db) {
 
 gboolean radio_station_update(RadioStation *station, Database *db) {
     if (!db || !db->db || !station) return FALSE;
+    DATABASE_LOCK_SCOPE(db);
 
     const char *sql = "UPDATE radio_stations SET name=?, url=?, genre=?, description=?, bitrate=?, homepage=? WHERE id=?;";
     sqlite3_stmt *stmt;
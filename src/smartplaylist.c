@@ -130,6 +130,7 @@ GList* smartplaylist_get_tracks(SmartPlaylist *playlist, Database *db) {
     
     GList *tracks = NULL;
     sqlite3_stmt *stmt;
+    DATABASE_LOCK_SCOPE(db);
     
     if (sqlite3_prepare_v2(db->db, sql, -1, &stmt, NULL) == SQLITE_OK) {
         /* Bind condition values as parameters */
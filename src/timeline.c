@@ -0,0 +1,30 @@
+#include "timeline.h"
+
+gint timeline_index_at_time(const gdouble *start_times, guint count, gdouble time, gint hint) {
+    if (!start_times || count == 0) return -1;
+    
+    gint n = (gint)count;
+    
+    /* Still in the hinted entry, or just moved on to the next one */
+    if (hint >= 0 && hint < n && start_times[hint] <= time) {
+        if (hint + 1 >= n || start_times[hint + 1] > time) {
+            return hint;
+        }
+        if (hint + 2 >= n || start_times[hint + 2] > time) {
+            return hint + 1;
+        }
+    }
+    
+    /* Seek: last entry starting at or before time */
+    gint low = 0, high = n - 1, found = -1;
+    while (low <= high) {
+        gint mid = low + (high - low) / 2;
+        if (start_times[mid] <= time) {
+            found = mid;
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,519 @@
+#include "transcript.h"
+#include "timeline.h"
+#include "podcast.h"
+#include <json-glib/json-glib.h>
+#include <string.h>
+
+/* Parsed transcripts kept in memory, most recently used first */
+#define TRANSCRIPT_CACHE_SIZE 4
+
+typedef struct {
+    GString *text;
+    GPtrArray *segments;
+    glong chars;            /* Characters in text so far */
+    gchar *speaker;         /* Last speaker labelled in text */
+} TranscriptBuilder;
+
+void transcript_segment_free(TranscriptSegment *segment) {
+    if (!segment) return;
+    g_free(segment->speaker);
+    g_free(segment->text);
+    g_free(segment);
+}
+
+static void transcript_builder_init(TranscriptBuilder *builder) {
+    builder->text = g_string_new("");
+    builder->segments = g_ptr_array_new_with_free_func((GDestroyNotify)transcript_segment_free);
+    builder->chars = 0;
+    builder->speaker = NULL;
+}
+
+/* Append one segment to the display text. A speaker change starts a new
+ * paragraph with a label; otherwise segments run on as sentences. */
+static void transcript_builder_add(TranscriptBuilder *builder, gdouble start_time, gdouble end_time,
+                                   const gchar *speaker, const gchar *body) {
+    if (!body || !*body) return;
+    
+    gboolean new_speaker = speaker && *speaker && g_strcmp0(speaker, builder->speaker) != 0;
+    
+    if (builder->text->len > 0) {
+        const gchar *separator = new_speaker ? "\n\n" : " ";
+        g_string_append(builder->text, separator);
+        builder->chars += (glong)strlen(separator);
+    }
+    
+    if (new_speaker) {
+        g_free(builder->speaker);
+        builder->speaker = g_strdup(speaker);
+        
+        gchar *label = g_strdup_printf("%s: ", speaker);
+        g_string_append(builder->text, label);
+        builder->chars += g_utf8_strlen(label, -1);
+        g_free(label);
+    }
+    
+    TranscriptSegment *segment = g_new0(TranscriptSegment, 1);
+    segment->start_time = start_time;
+    segment->end_time = end_time;
+    segment->speaker = (speaker && *speaker) ? g_strdup(speaker) : NULL;
+    segment->text = g_strdup(body);
+    segment->start_offset = (gint)builder->chars;
+    
+    g_string_append(builder->text, body);
+    builder->chars += g_utf8_strlen(body, -1);
+    segment->end_offset = (gint)builder->chars;
+    
+    g_ptr_array_add(builder->segments, segment);
+}
+
+static gint compare_segment_start(gconstpointer a, gconstpointer b) {
+    const TranscriptSegment *x = *(TranscriptSegment * const *)a;
+    const TranscriptSegment *y = *(TranscriptSegment * const *)b;
+    return (x->start_time > y->start_time) - (x->start_time < y->start_time);
+}
+
+static Transcript* transcript_builder_finish(TranscriptBuilder *builder) {
+    Transcript *transcript = g_new0(Transcript, 1);
+    g_atomic_ref_count_init(&transcript->ref_count);
+    
+    for (guint i = 0; i < builder->segments->len; i++) {
+        TranscriptSegment *segment = (TranscriptSegment *)g_ptr_array_index(builder->segments, i);
+        if (segment->start_time > 0 || segment->end_time > 0) {
+            transcript->timed = TRUE;
+            break;
+        }
+    }
+    
+    /* Cues are almost always in order already; offsets stay valid either way */
+    g_ptr_array_sort(builder->segments, compare_segment_start);
+    
+    transcript->start_times = g_array_sized_new(FALSE, FALSE, sizeof(gdouble), builder->segments->len);
+    for (guint i = 0; i < builder->segments->len; i++) {
+        TranscriptSegment *segment = (TranscriptSegment *)g_ptr_array_index(builder->segments, i);
+        g_array_append_val(transcript->start_times, segment->start_time);
+    }
+    
+    transcript->text = g_string_free(builder->text, FALSE);
+    transcript->segments = builder->segments;
+    g_free(builder->speaker);
+    return transcript;
+}
+
+static void transcript_builder_clear(TranscriptBuilder *builder) {
+    g_string_free(builder->text, TRUE);
+    g_ptr_array_unref(builder->segments);
+    g_free(builder->speaker);
+}
+
+/* [hh:]mm:ss[.fff] (WebVTT) or hh:mm:ss,fff (SRT) */
+static gboolean parse_cue_timestamp(const gchar *s, const gchar **end, gdouble *seconds) {
+    const gchar *p = s;
+    gint64 parts[3];
+    gint n = 0;
+    
+    while (*p == ' ' || *p == '\t') p++;
+    
+    while (n < 3) {
+        if (!g_ascii_isdigit(*p)) return FALSE;
+        gint64 value = 0;
+        while (g_ascii_isdigit(*p)) {
+            value = value * 10 + (*p++ - '0');
+        }
+        parts[n++] = value;
+        if (*p != ':') break;
+        p++;
+    }
+    if (n < 2) return FALSE;
+    
+    gdouble fraction = 0.0;
+    if (*p == '.' || *p == ',') {
+        gdouble scale = 0.1;
+        for (p++; g_ascii_isdigit(*p); p++) {
+            fraction += (*p - '0') * scale;
+            scale /= 10.0;
+        }
+    }
+    
+    if (n == 3) {
+        *seconds = parts[0] * 3600.0 + parts[1] * 60.0 + parts[2] + fraction;
+    } else {
+        *seconds = parts[0] * 60.0 + parts[1] + fraction;
+    }
+    if (end) *end = p;
+    return TRUE;
+}
+
+/* "start --> end" followed by optional WebVTT cue settings */
+static gboolean parse_cue_timing(const gchar *line, gdouble *start, gdouble *end) {
+    const gchar *p = NULL;
+    
+    if (!parse_cue_timestamp(line, &p, start)) return FALSE;
+    while (*p == ' ' || *p == '\t') p++;
+    if (!g_str_has_prefix(p, "-->")) return FALSE;
+    return parse_cue_timestamp(p + 3, NULL, end);
+}
+
+/* Strip cue markup (<b>, <c.loud>, inline timestamps) and decode the
+ * entities WebVTT allows. The first voice tag's name goes to speaker. */
+static gchar* clean_cue_text(const gchar *line, gchar **speaker) {
+    static const struct {
+        const gchar *entity;
+        const gchar *text;
+    } entities[] = {
+        { "&amp;", "&" }, { "&lt;", "<" }, { "&gt;", ">" }, { "&quot;", "\"" },
+        { "&apos;", "'" }, { "&nbsp;", "\xc2\xa0" }, { "&lrm;", "" }, { "&rlm;", "" },
+    };
+    GString *out = g_string_new("");
+    const gchar *p = line;
+    
+    while (*p) {
+        if (*p == '<') {
+            const gchar *close = strchr(p, '>');
+            if (!close) {
+                g_string_append(out, p);
+                break;
+            }
+            
+            /* <v Name> or <v.class Name> */
+            if (speaker && !*speaker && p[1] == 'v' && (p[2] == ' ' || p[2] == '.')) {
+                const gchar *name = strchr(p, ' ');
+                if (name && name < close) {
+                    *speaker = g_strstrip(g_strndup(name + 1, close - name - 1));
+                }
+            }
+            p = close + 1;
+        } else if (*p == '&') {
+            gboolean decoded = FALSE;
+            for (gsize i = 0; i < G_N_ELEMENTS(entities); i++) {
+                gsize len = strlen(entities[i].entity);
+                if (strncmp(p, entities[i].entity, len) == 0) {
+                    g_string_append(out, entities[i].text);
+                    p += len;
+                    decoded = TRUE;
+                    break;
+                }
+            }
+            if (!decoded) {
+                g_string_append_c(out, *p++);
+            }
+        } else {
+            g_string_append_c(out, *p++);
+        }
+    }
+    
+    return g_strstrip(g_string_free(out, FALSE));
+}
+
+static void finish_cue(TranscriptBuilder *builder, gdouble start, gdouble end,
+                       gchar **speaker, GString *body) {
+    transcript_builder_add(builder, start, end, *speaker, body->str);
+    g_string_truncate(body, 0);
+    g_free(*speaker);
+    *speaker = NULL;
+}
+
+/* SRT and WebVTT share the cue layout: an optional identifier (the SRT
+ * counter), a timing line, then text lines up to a blank line. Anything
+ * outside a cue (the WEBVTT header, NOTE/STYLE/REGION blocks) is skipped. */
+static void parse_cues(TranscriptBuilder *builder, const gchar *data) {
+    gchar **lines = g_strsplit(data, "\n", -1);
+    GString *body = g_string_new("");
+    gchar *speaker = NULL;
+    gdouble start = 0.0, end = 0.0;
+    gboolean in_cue = FALSE;
+    
+    for (gint i = 0; lines[i] != NULL; i++) {
+        gchar *line = g_strstrip(lines[i]);
+        
+        if (strstr(line, "-->")) {
+            if (in_cue) {
+                finish_cue(builder, start, end, &speaker, body);
+            }
+            in_cue = parse_cue_timing(line, &start, &end);
+            continue;
+        }
+        
+        if (*line == '\0') {
+            if (in_cue) {
+                finish_cue(builder, start, end, &speaker, body);
+            }
+            in_cue = FALSE;
+            continue;
+        }
+        
+        if (!in_cue) continue;
+        
+        gchar *text = clean_cue_text(line, &speaker);
+        if (*text) {
+            if (body->len > 0) {
+                g_string_append_c(body, ' ');
+            }
+            g_string_append(body, text);
+        }
+        g_free(text);
+    }
+    
+    if (in_cue) {
+        finish_cue(builder, start, end, &speaker, body);
+    }
+    
+    g_free(speaker);
+    g_string_free(body, TRUE);
+    g_strfreev(lines);
+}
+
+/* Podcasting 2.0 JSON: {"segments": [{"speaker", "startTime", "endTime", "body"}]} */
+static gboolean parse_json_segments(TranscriptBuilder *builder, const gchar *data) {
+    GError *error = NULL;
+    
+    JsonParser *parser = json_parser_new();
+    if (!json_parser_load_from_data(parser, data, -1, &error)) {
+        g_warning("Failed to parse transcript JSON: %s", error ? error->message : "unknown error");
+        if (error) g_error_free(error);
+        g_object_unref(parser);
+        return FALSE;
+    }
+    
+    JsonNode *root = json_parser_get_root(parser);
+    if (!root || !JSON_NODE_HOLDS_OBJECT(root) ||
+        !json_object_has_member(json_node_get_object(root), "segments")) {
+        g_warning("No 'segments' array found in transcript JSON");
+        g_object_unref(parser);
+        return FALSE;
+    }
+    
+    JsonArray *segments = json_object_get_array_member(json_node_get_object(root), "segments");
+    guint n_segments = segments ? json_array_get_length(segments) : 0;
+    
+    for (guint i = 0; i < n_segments; i++) {
+        JsonObject *object = json_array_get_object_element(segments, i);
+        if (!object) continue;
+        
+        gdouble start = 0.0, end = 0.0;
+        const gchar *speaker = NULL;
+        const gchar *body = NULL;
+        
+        if (json_object_has_member(object, "startTime")) {
+            start = json_object_get_double_member(object, "startTime");
+        }
+        if (json_object_has_member(object, "endTime")) {
+            end = json_object_get_double_member(object, "endTime");
+        }
+        if (json_object_has_member(object, "speaker")) {
+            speaker = json_object_get_string_member(object, "speaker");
+        }
+        
+        /* "body" per the spec; some generators write "text" */
+        if (json_object_has_member(object, "body")) {
+            body = json_object_get_string_member(object, "body");
+        } else if (json_object_has_member(object, "text")) {
+            body = json_object_get_string_member(object, "text");
+        }
+        
+        if (body) {
+            gchar *text = g_strstrip(g_strdup(body));
+            transcript_builder_add(builder, start, end, speaker, text);
+            g_free(text);
+        }
+    }
+    
+    g_object_unref(parser);
+    return TRUE;
+}
+
+TranscriptFormat transcript_detect_format(const gchar *data, const gchar *url, const gchar *type) {
+    if (type) {
+        if (strstr(type, "json")) return TRANSCRIPT_FORMAT_JSON;
+        if (strstr(type, "vtt")) return TRANSCRIPT_FORMAT_VTT;
+        if (strstr(type, "srt") || strstr(type, "subrip")) return TRANSCRIPT_FORMAT_SRT;
+    }
+    
+    if (url) {
+        gchar *path = g_strndup(url, strcspn(url, "?#"));
+        TranscriptFormat format = TRANSCRIPT_FORMAT_PLAIN;
+        if (g_str_has_suffix(path, ".json")) {
+            format = TRANSCRIPT_FORMAT_JSON;
+        } else if (g_str_has_suffix(path, ".vtt")) {
+            format = TRANSCRIPT_FORMAT_VTT;
+        } else if (g_str_has_suffix(path, ".srt")) {
+            format = TRANSCRIPT_FORMAT_SRT;
+        }
+        g_free(path);
+        if (format != TRANSCRIPT_FORMAT_PLAIN) return format;
+    }
+    
+    /* Sniff the content, skipping a byte order mark */
+    if (data) {
+        const gchar *p = g_str_has_prefix(data, "\xef\xbb\xbf") ? data + 3 : data;
+        while (g_ascii_isspace(*p)) p++;
+        
+        if (g_str_has_prefix(p, "WEBVTT")) return TRANSCRIPT_FORMAT_VTT;
+        if (*p == '{') return TRANSCRIPT_FORMAT_JSON;
+        if (strstr(p, "-->")) return TRANSCRIPT_FORMAT_SRT;
+    }
+    
+    return TRANSCRIPT_FORMAT_PLAIN;
+}
+
+Transcript* transcript_parse(const gchar *data, TranscriptFormat format) {
+    TranscriptBuilder builder;
+    
+    /* The text ends up in a GtkTextBuffer, which only takes valid UTF-8 */
+    gchar *valid = g_utf8_make_valid(data ? data : "", -1);
+    
+    transcript_builder_init(&builder);
+    
+    switch (format) {
+        case TRANSCRIPT_FORMAT_SRT:
+        case TRANSCRIPT_FORMAT_VTT:
+            parse_cues(&builder, valid);
+            break;
+        case TRANSCRIPT_FORMAT_JSON:
+            parse_json_segments(&builder, valid);
+            break;
+        case TRANSCRIPT_FORMAT_PLAIN:
+        default:
+            break;
+    }
+    
+    /* Plain text, or a timed format that yielded nothing: show it as is */
+    if (builder.segments->len == 0) {
+        transcript_builder_clear(&builder);
+        transcript_builder_init(&builder);
+        
+        gchar *text = g_strstrip(g_strdup(valid));
+        transcript_builder_add(&builder, 0.0, 0.0, NULL, text);
+        g_free(text);
+    }
+    
+    g_free(valid);
+    return transcript_builder_finish(&builder);
+}
+
+Transcript* transcript_ref(Transcript *transcript) {
+    g_atomic_ref_count_inc(&transcript->ref_count);
+    return transcript;
+}
+
+void transcript_unref(Transcript *transcript) {
+    if (!transcript || !g_atomic_ref_count_dec(&transcript->ref_count)) return;
+    
+    g_ptr_array_unref(transcript->segments);
+    g_array_unref(transcript->start_times);
+    g_free(transcript->text);
+    g_free(transcript);
+}
+
+gint transcript_segment_index_at_time(Transcript *transcript, gdouble time, gint hint) {
+    if (!transcript) return -1;
+    return timeline_index_at_time((const gdouble *)transcript->start_times->data,
+                                  transcript->start_times->len, time, hint);
+}
+
+/* Parse cache: URL -> Transcript, LRU order in transcript_cache_order */
+static GMutex transcript_cache_lock;
+static GHashTable *transcript_cache = NULL;
+static GQueue transcript_cache_order = G_QUEUE_INIT;
+
+static Transcript* transcript_cache_lookup(const gchar *url) {
+    Transcript *transcript = NULL;
+    
+    g_mutex_lock(&transcript_cache_lock);
+    if (transcript_cache) {
+        transcript = g_hash_table_lookup(transcript_cache, url);
+        if (transcript) {
+            GList *link = g_queue_find_custom(&transcript_cache_order, url, (GCompareFunc)g_strcmp0);
+            g_queue_unlink(&transcript_cache_order, link);
+            g_queue_push_head_link(&transcript_cache_order, link);
+            transcript_ref(transcript);
+        }
+    }
+    g_mutex_unlock(&transcript_cache_lock);
+    return transcript;
+}
+
+static void transcript_cache_insert(const gchar *url, Transcript *transcript) {
+    g_mutex_lock(&transcript_cache_lock);
+    if (!transcript_cache) {
+        transcript_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                                 (GDestroyNotify)transcript_unref);
+    }
+    
+    if (!g_hash_table_contains(transcript_cache, url)) {
+        gchar *key = g_strdup(url);
+        g_hash_table_insert(transcript_cache, key, transcript_ref(transcript));
+        g_queue_push_head(&transcript_cache_order, key);
+        
+        while (g_queue_get_length(&transcript_cache_order) > TRANSCRIPT_CACHE_SIZE) {
+            gchar *oldest = g_queue_pop_tail(&transcript_cache_order);
+            g_hash_table_remove(transcript_cache, oldest);  /* Frees oldest */
+        }
+    }
+    g_mutex_unlock(&transcript_cache_lock);
+}
+
+typedef struct {
+    gchar *url;
+    gchar *type;
+} TranscriptRequest;
+
+static void transcript_request_free(TranscriptRequest *request) {
+    g_free(request->url);
+    g_free(request->type);
+    g_free(request);
+}
+
+static void transcript_load_thread(GTask *task, gpointer source_object, gpointer task_data,
+                                   GCancellable *cancellable) {
+    (void)source_object;
+    TranscriptRequest *request = (TranscriptRequest *)task_data;
+    
+    gchar *data = podcast_sidecar_fetch(request->url, FALSE);
+    if (!data) {
+        g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_FAILED,
+                                "Failed to fetch %s", request->url);
+        return;
+    }
+    
+    if (g_cancellable_is_cancelled(cancellable)) {
+        g_free(data);
+        g_task_return_error_if_cancelled(task);
+        return;
+    }
+    
+    TranscriptFormat format = transcript_detect_format(data, request->url, request->type);
+    Transcript *transcript = transcript_parse(data, format);
+    g_free(data);
+    
+    g_debug("Parsed transcript %s: %u segments%s", request->url,
+            transcript->segments->len, transcript->timed ? "" : " (untimed)");
+    
+    transcript_cache_insert(request->url, transcript);
+    g_task_return_pointer(task, transcript, (GDestroyNotify)transcript_unref);
+}
+
+void transcript_load_async(const gchar *url, const gchar *type, GCancellable *cancellable,
+                           GAsyncReadyCallback callback, gpointer user_data) {
+    GTask *task = g_task_new(NULL, cancellable, callback, user_data);
+    
+    /* Reopening a recent transcript skips both the fetch and the parse */
+    Transcript *cached = url ? transcript_cache_lookup(url) : NULL;
+    if (cached) {
+        g_task_return_pointer(task, cached, (GDestroyNotify)transcript_unref);
+        g_object_unref(task);
+        return;
+    }
+    
+    TranscriptRequest *request = g_new0(TranscriptRequest, 1);
+    request->url = g_strdup(url);
+    request->type = g_strdup(type);
+    
+    g_task_set_task_data(task, request, (GDestroyNotify)transcript_request_free);
+    g_task_set_return_on_cancel(task, TRUE);
+    g_task_run_in_thread(task, transcript_load_thread);
+    g_object_unref(task);
+}
+
+Transcript* transcript_load_finish(GAsyncResult *result, GError **error) {
+    return g_task_propagate_pointer(G_TASK(result), error);
+}
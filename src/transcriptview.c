@@ -2,11 +2,6 @@
 #include "podcast.h"
 #include <string.h>
 
-static gchar* fetch_transcript_url(const gchar *url) {
-    /* Use the fetch_url function from podcast.c */
-    return fetch_url(url);
-}
-
 static void on_search_clicked(GtkWidget *button, gpointer user_data) {
     TranscriptView *view = (TranscriptView *)user_data;
     (void)button;
@@ -99,6 +94,15 @@ TranscriptView* transcript_view_new(void) {
     
     view->buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(view->textview));
     
+    /* The segment being spoken; moved between segment offsets during playback */
+    view->current_tag = gtk_text_buffer_create_tag(view->buffer, "current-segment",
+                                                   "background", "#fce94f",
+                                                   "foreground", "#000000", NULL);
+    GtkTextIter start;
+    gtk_text_buffer_get_start_iter(view->buffer, &start);
+    view->current_mark = gtk_text_buffer_create_mark(view->buffer, "current-segment", &start, TRUE);
+    view->current_segment = -1;
+    
     /* Scrolled window for text view */
     GtkWidget *scrolled = gtk_scrolled_window_new();
     gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scrolled),
@@ -107,8 +111,7 @@ TranscriptView* transcript_view_new(void) {
     gtk_widget_set_vexpand(scrolled, TRUE);
     gtk_box_append(GTK_BOX(view->container), scrolled);
     
-    view->segments = NULL;
-    view->full_text = NULL;
+    view->transcript = NULL;
     view->search_mark = NULL;
     
     /* GTK4: widgets are visible by default */
@@ -119,11 +122,16 @@ TranscriptView* transcript_view_new(void) {
 void transcript_view_free(TranscriptView *view) {
     if (!view) return;
     
-    if (view->segments) {
-        g_list_free_full(view->segments, (GDestroyNotify)transcript_segment_free);
+    /* A pending load finishes after the view is gone; cancelling tells it so */
+    if (view->load_cancellable) {
+        g_cancellable_cancel(view->load_cancellable);
+        g_object_unref(view->load_cancellable);
+    }
+    
+    if (view->transcript) {
+        transcript_unref(view->transcript);
     }
     
-    g_free(view->full_text);
     g_free(view);
 }
 
@@ -131,114 +139,24 @@ GtkWidget* transcript_view_get_widget(TranscriptView *view) {
     return view ? view->container : NULL;
 }
 
-static GList* parse_simple_json_transcript(const gchar *json_data) {
-    GList *segments = NULL;
-    
-    /* Simple JSON parsing without external library */
-    /* Look for "text" fields in the JSON */
-    gchar **lines = g_strsplit(json_data, "\n", -1);
-    
-    for (gint i = 0; lines[i] != NULL; i++) {
-        gchar *line = g_strstrip(lines[i]);
-        
-        /* Look for text fields in JSON */
-        gchar *text_start = strstr(line, "\"text\"");
-        if (text_start) {
-            gchar *colon = strchr(text_start, ':');
-            if (colon) {
-                gchar *quote_start = strchr(colon, '"');
-                if (quote_start) {
-                    quote_start++; /* Skip opening quote */
-                    gchar *quote_end = strchr(quote_start, '"');
-                    if (quote_end) {
-                        gchar *text = g_strndup(quote_start, quote_end - quote_start);
-                        
-                        /* Create a simple segment without timing for now */
-                        TranscriptSegment *segment = g_new0(TranscriptSegment, 1);
-                        segment->start_time = 0.0;
-                        segment->end_time = 0.0;
-                        segment->text = text;
-                        
-                        segments = g_list_prepend(segments, segment);
-                    }
-                }
-            }
-        }
-    }
-    
-    g_strfreev(lines);
-    return g_list_reverse(segments);
-}
-
-static gchar* parse_webvtt_transcript(const gchar *vtt_data) {
-    /* Simple WebVTT parsing - extract text and format speaker changes */
-    GString *text = g_string_new("");
-    gchar **lines = g_strsplit(vtt_data, "\n", -1);
-    gchar *current_speaker = NULL;
-    
-    gboolean in_cue = FALSE;
-    for (gint i = 0; lines[i] != NULL; i++) {
-        gchar *line = g_strstrip(lines[i]);
-        
-        if (strlen(line) == 0) {
-            in_cue = FALSE;
-            continue;
-        }
-        
-        /* Skip WEBVTT header and NOTE lines */
-        if (g_str_has_prefix(line, "WEBVTT") || g_str_has_prefix(line, "NOTE")) {
-            continue;
-        }
-        
-        /* Check if line contains timestamp (format: 00:00:00.000 --> 00:00:00.000) */
-        if (strstr(line, "-->")) {
-            in_cue = TRUE;
-            continue;
-        }
-        
-        /* If we're in a cue and this isn't a timestamp, it's text */
-        if (in_cue) {
-            /* Check for speaker voice tag: <v Name> */
-            if (g_str_has_prefix(line, "<v ")) {
-                gchar *end = strchr(line + 3, '>');
-                if (end) {
-                    gchar *speaker = g_strndup(line + 3, end - (line + 3));
-                    
-                    /* If speaker changed, start a new line */
-                    if (!current_speaker || g_strcmp0(current_speaker, speaker) != 0) {
-                        g_free(current_speaker);
-                        current_speaker = speaker;
-                        
-                        /* Add newline before new speaker (if not first) */
-                        if (text->len > 0) {
-                            g_string_append(text, "\n\n");
-                        }
-                        g_string_append_printf(text, "<%s> ", current_speaker);
-                    } else {
-                        g_free(speaker);
-                        g_string_append(text, " ");
-                    }
-                    
-                    /* Append the text after the voice tag */
-                    gchar *content = end + 1;
-                    if (*content) {
-                        g_string_append(text, content);
-                    }
-                    continue;
-                }
-            }
-            
-            /* Regular text line (no voice tag) */
-            if (text->len > 0 && !g_str_has_suffix(text->str, "\n") && !g_str_has_suffix(text->str, " ")) {
-                g_string_append(text, " ");
-            }
-            g_string_append(text, line);
+static void on_transcript_loaded(GObject *source, GAsyncResult *result, gpointer user_data) {
+    TranscriptView *view = (TranscriptView *)user_data;
+    GError *error = NULL;
+    (void)source;
+    
+    Transcript *transcript = transcript_load_finish(result, &error);
+    if (error) {
+        /* Cancelled loads may belong to a view that no longer exists */
+        if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            gtk_text_buffer_set_text(view->buffer, "Failed to load transcript.", -1);
         }
+        g_error_free(error);
+        return;
     }
     
-    g_free(current_speaker);
-    g_strfreev(lines);
-    return g_string_free(text, FALSE);
+    transcript_view_clear(view);
+    view->transcript = transcript;
+    gtk_text_buffer_set_text(view->buffer, transcript->text, -1);
 }
 
 gboolean transcript_view_load_from_url(TranscriptView *view, const gchar *transcript_url, const gchar *transcript_type) {
@@ -246,45 +164,19 @@ gboolean transcript_view_load_from_url(TranscriptView *view, const gchar *transc
     
     g_print("Loading transcript from: %s (type: %s)\n", transcript_url, transcript_type ? transcript_type : "unknown");
     
-    gchar *transcript_data = fetch_transcript_url(transcript_url);
-    if (!transcript_data) {
-        gtk_text_buffer_set_text(view->buffer, "Failed to load transcript.", -1);
-        return FALSE;
+    /* Only the most recent request may update the view */
+    if (view->load_cancellable) {
+        g_cancellable_cancel(view->load_cancellable);
+        g_object_unref(view->load_cancellable);
     }
+    view->load_cancellable = g_cancellable_new();
     
     transcript_view_clear(view);
+    gtk_text_buffer_set_text(view->buffer, "Loading transcript...", -1);
     
-    /* Determine format and parse accordingly */
-    if (transcript_type && (strstr(transcript_type, "json") || g_str_has_suffix(transcript_url, ".json"))) {
-        /* JSON format with timestamps */
-        view->segments = parse_simple_json_transcript(transcript_data);
-        
-        if (view->segments) {
-            /* Build full text from segments */
-            GString *full_text = g_string_new("");
-            for (GList *l = view->segments; l != NULL; l = l->next) {
-                TranscriptSegment *segment = (TranscriptSegment *)l->data;
-                if (full_text->len > 0) {
-                    g_string_append(full_text, " ");
-                }
-                g_string_append(full_text, segment->text);
-            }
-            view->full_text = g_string_free(full_text, FALSE);
-            gtk_text_buffer_set_text(view->buffer, view->full_text, -1);
-        } else {
-            gtk_text_buffer_set_text(view->buffer, "Failed to parse JSON transcript.", -1);
-        }
-    } else if (transcript_type && (strstr(transcript_type, "vtt") || g_str_has_suffix(transcript_url, ".vtt"))) {
-        /* WebVTT format */
-        view->full_text = parse_webvtt_transcript(transcript_data);
-        gtk_text_buffer_set_text(view->buffer, view->full_text, -1);
-    } else {
-        /* Plain text or unknown format */
-        view->full_text = g_strdup(transcript_data);
-        gtk_text_buffer_set_text(view->buffer, view->full_text, -1);
-    }
-    
-    g_free(transcript_data);
+    /* Fetched from the sidecar cache and parsed off the main thread */
+    transcript_load_async(transcript_url, transcript_type, view->load_cancellable,
+                          on_transcript_loaded, view);
     return TRUE;
 }
 
@@ -292,35 +184,46 @@ void transcript_view_set_text(TranscriptView *view, const gchar *text) {
     if (!view) return;
     
     transcript_view_clear(view);
-    view->full_text = g_strdup(text);
     gtk_text_buffer_set_text(view->buffer, text ? text : "", -1);
 }
 
 void transcript_view_highlight_time(TranscriptView *view, gdouble current_time) {
-    if (!view || !view->segments) return;
+    if (!view || !view->transcript || !view->transcript->timed) return;
     
-    /* Find the segment that contains the current time */
-    for (GList *l = view->segments; l != NULL; l = l->next) {
-        TranscriptSegment *segment = (TranscriptSegment *)l->data;
-        
-        if (current_time >= segment->start_time && current_time <= segment->end_time) {
-            /* TODO: Highlight this segment in the text view */
-            g_print("Current segment: %.1f-%.1f: %s\n", segment->start_time, segment->end_time, segment->text);
-            break;
-        }
+    GPtrArray *segments = view->transcript->segments;
+    gint index = transcript_segment_index_at_time(view->transcript, current_time, view->current_segment);
+    if (index == view->current_segment) return;
+    
+    GtkTextIter start, end;
+    
+    /* Move the tag: only the old and new segment ranges are touched */
+    if (view->current_segment >= 0) {
+        TranscriptSegment *old = (TranscriptSegment *)g_ptr_array_index(segments, view->current_segment);
+        gtk_text_buffer_get_iter_at_offset(view->buffer, &start, old->start_offset);
+        gtk_text_buffer_get_iter_at_offset(view->buffer, &end, old->end_offset);
+        gtk_text_buffer_remove_tag(view->buffer, view->current_tag, &start, &end);
     }
+    
+    view->current_segment = index;
+    if (index < 0) return;
+    
+    TranscriptSegment *segment = (TranscriptSegment *)g_ptr_array_index(segments, index);
+    gtk_text_buffer_get_iter_at_offset(view->buffer, &start, segment->start_offset);
+    gtk_text_buffer_get_iter_at_offset(view->buffer, &end, segment->end_offset);
+    gtk_text_buffer_apply_tag(view->buffer, view->current_tag, &start, &end);
+    
+    gtk_text_buffer_move_mark(view->buffer, view->current_mark, &start);
+    gtk_text_view_scroll_mark_onscreen(GTK_TEXT_VIEW(view->textview), view->current_mark);
 }
 
 void transcript_view_clear(TranscriptView *view) {
     if (!view) return;
     
-    if (view->segments) {
-        g_list_free_full(view->segments, (GDestroyNotify)transcript_segment_free);
-        view->segments = NULL;
+    if (view->transcript) {
+        transcript_unref(view->transcript);
+        view->transcript = NULL;
     }
-    
-    g_free(view->full_text);
-    view->full_text = NULL;
+    view->current_segment = -1;
     
     gtk_text_buffer_set_text(view->buffer, "", -1);
     
@@ -334,10 +237,4 @@ void transcript_view_set_seek_callback(TranscriptView *view, TranscriptSeekCallb
     if (!view) return;
     view->seek_callback = callback;
     view->seek_callback_data = user_data;
-}
-
-void transcript_segment_free(TranscriptSegment *segment) {
-    if (!segment) return;
-    g_free(segment->text);
-    g_free(segment);
 }
\ No newline at end of file
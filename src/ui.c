@@ -1091,12 +1091,33 @@ MediaPlayerUI* ui_new(MediaPlayer *player, Database *database, GtkApplication *a
     
     /* Initialize managers */
     ui->coverart_manager = coverart_manager_new();
+    if (database) {
+        gint cache_mb = database_get_preference_int(database, "coverart_cache_mb", COVER_ART_CACHE_BUDGET / (1024 * 1024));
+        coverart_manager_set_cache_budget(ui->coverart_manager, (gsize)MAX(cache_mb, 0) * 1024 * 1024);
+        if (database_get_preference_bool(database, "coverart_packed_cache", FALSE)) {
+            coverart_manager_enable_pack(ui->coverart_manager);
+        }
+    }
     ui->podcast_manager = podcast_manager_new(database);
     
     /* Start automatic podcast feed updates based on preference (in minutes) */
     if (ui->podcast_manager && database && database->db) {
         gint update_interval = database_get_preference_int(database, "podcast_update_interval_minutes", 1440);  /* Default: 24 hours */
         podcast_manager_start_auto_update(ui->podcast_manager, update_interval);
+        
+        /* Optional push-style updates: a podping/WebSub relay stream, or a
+         * local file that changed feed URLs are appended to for testing */
+        gchar *stream_url = database_get_preference(database, "podcast_notifier_stream_url", NULL);
+        if (stream_url && *stream_url) {
+            podcast_manager_add_notifier(ui->podcast_manager, feed_notifier_stream_new(stream_url));
+        }
+        g_free(stream_url);
+        
+        gchar *notify_file = database_get_preference(database, "podcast_notifier_file", NULL);
+        if (notify_file && *notify_file) {
+            podcast_manager_add_notifier(ui->podcast_manager, feed_notifier_file_new(notify_file));
+        }
+        g_free(notify_file);
     }
     
     /* Restore saved volume preference */
@@ -1826,6 +1847,12 @@ void ui_update_position(MediaPlayerUI *ui, gint64 position, gint64 duration) {
         gtk_label_set_text(GTK_LABEL(ui->time_label), time_text);
         g_free(time_text);
     }
+    
+    /* Live streams have no duration but still carry chapters and transcripts */
+    if (ui->podcast_view && ui->player) {
+        podcast_view_update_position(ui->podcast_view, ui->player->current_uri,
+                                     (gdouble)position / GST_SECOND);
+    }
 }
 
 void ui_free(MediaPlayerUI *ui) {
@@ -2255,7 +2282,7 @@ static void ui_update_cover_art(MediaPlayerUI *ui, const gchar *artist, const gc
     
     /* Try podcast image first if provided */
     if (podcast_image_url && strlen(podcast_image_url) > 0) {
-        coverart_widget_set_from_url(ui->header_cover_art, podcast_image_url);
+        coverart_widget_set_from_url(ui->header_cover_art, ui->coverart_manager, podcast_image_url);
         return;
     }
     
@@ -2266,7 +2293,7 @@ static void ui_update_cover_art(MediaPlayerUI *ui, const gchar *artist, const gc
     }
     
     /* Fall back to default image */
-    coverart_widget_set_default(ui->header_cover_art);
+    coverart_widget_set_default(ui->header_cover_art, ui->coverart_manager);
 }
 
 void ui_update_now_playing(MediaPlayerUI *ui) {